@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace sugo::common
+{
+/**
+ * @brief Class represents a fixed-capacity queue for any number of producer and consumer
+ * contexts. Each slot carries a sequence number, which tells the contexts if the slot is free
+ * for the next push or filled for the next pop, so no context ever waits for a lock. If the queue
+ * is full, new values are rejected until a consumer removed old ones.
+ *
+ * @tparam ValueT   Value type.
+ * @tparam Capacity Max number of values, which has to be a power of two.
+ */
+template <class ValueT, std::size_t Capacity>
+class LockFreeQueue
+{
+    static_assert((Capacity > 1) && ((Capacity & (Capacity - 1)) == 0),
+                  "Capacity must be a power of two");
+
+public:
+    /// @brief Constructs a new empty queue.
+    LockFreeQueue()
+    {
+        for (std::size_t index = 0; index < Capacity; ++index)
+        {
+            m_slots[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Returns the max number of values.
+     *
+     * @return The capacity.
+     */
+    static constexpr std::size_t capacity()
+    {
+        return Capacity;
+    }
+
+    /**
+     * @brief Adds a new value. Could be called from any context.
+     *
+     * @param value Value to add.
+     * @return true  If the value has been added.
+     * @return false If the queue is full and the value has been rejected.
+     */
+    bool push(ValueT value)
+    {
+        std::size_t position = m_head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot&             slot     = m_slots[position & (Capacity - 1)];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == position)
+            {
+                // The slot is free, so try to claim it before another producer does.
+                if (m_head.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed))
+                {
+                    slot.value = std::move(value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (sequence < position)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the oldest value. Could be called from any context.
+     *
+     * @param[out] value Removed value.
+     * @return true  If a value has been removed.
+     * @return false If the queue is empty.
+     */
+    bool pop(ValueT& value)
+    {
+        std::size_t position = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot&             slot     = m_slots[position & (Capacity - 1)];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == (position + 1))
+            {
+                // The slot is filled, so try to claim it before another consumer does.
+                if (m_tail.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed))
+                {
+                    value = std::move(slot.value);
+                    slot.sequence.store(position + Capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (sequence < (position + 1))
+            {
+                return false;
+            }
+            else
+            {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    /// @brief Queue slot.
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence{0};  ///< Sequence number of the slot state.
+        ValueT                   value{};      ///< Slot value.
+    };
+
+    std::array<Slot, Capacity>           m_slots;    ///< Value slots.
+    alignas(64) std::atomic<std::size_t> m_head{0};  ///< Next push position.
+    alignas(64) std::atomic<std::size_t> m_tail{0};  ///< Next pop position.
+};
+}  // namespace sugo::common
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <optional>
+
+#include "Common/PidController.hpp"
+
+namespace sugo::common
+{
+/**
+ * @brief Class determines PID controller gains by the relay method of Åström and Hägglund.
+ * The output is switched between its limits around the setpoint, until the resulting oscillation
+ * has been measured for a number of cycles. The ultimate gain and period of this oscillation are
+ * converted into controller gains by the classic Ziegler-Nichols rules. The overshoot of these
+ * rules is mainly caused by integral windup, which is prevented by the PidController.
+ * It does not use any locks, so it has to be used from within one context only.
+ */
+class PidAutoTuner
+{
+public:
+    /// @brief Controller gains type.
+    using Parameters = PidController::Parameters;
+
+    /// Default number of oscillation cycles to be measured.
+    static constexpr unsigned DefaultCycles = 3;
+
+    /**
+     * @brief Constructs a new auto tuner object.
+     *
+     * @param setpoint   Target value to oscillate around.
+     * @param hysteresis Relay hysteresis around the setpoint to suppress measurement noise.
+     * @param outputMin  Relay output if the measurement is above the setpoint.
+     * @param outputMax  Relay output if the measurement is below the setpoint.
+     * @param cycles     Number of oscillation cycles to be measured.
+     */
+    PidAutoTuner(double setpoint, double hysteresis, double outputMin = 0.0,
+                 double outputMax = 1.0, unsigned cycles = DefaultCycles);
+
+    /**
+     * @brief Calculates the next relay output.
+     *
+     * @param measurement Current measured value.
+     * @param time        Current time in seconds.
+     * @return The relay output value.
+     */
+    double update(double measurement, double time);
+
+    /**
+     * @brief Indicates if enough cycles have been measured.
+     *
+     * @return true  If tuning is finished.
+     * @return false If tuning is not finished.
+     */
+    bool isFinished() const
+    {
+        return m_parameters.has_value();
+    }
+
+    /**
+     * @brief Returns the determined controller gains.
+     *
+     * @return The controller gains or std::nullopt if tuning is not finished.
+     */
+    const std::optional<Parameters>& getParameters() const
+    {
+        return m_parameters;
+    }
+
+private:
+    /**
+     * @brief Called at the end of each oscillation cycle.
+     *
+     * @param time Time of the cycle end in seconds.
+     */
+    void finishCycle(double time);
+
+    const double              m_setpoint;               ///< Target value.
+    const double              m_hysteresis;             ///< Relay hysteresis.
+    const double              m_outputMin;              ///< Relay output above the setpoint.
+    const double              m_outputMax;              ///< Relay output below the setpoint.
+    const unsigned            m_cycles;                 ///< Number of cycles to be measured.
+    bool                      m_isOutputHigh  = true;   ///< Current relay state.
+    bool                      m_hasCycleStart = false;  ///< Indicates if a cycle has started.
+    double                    m_cycleStart    = 0.0;    ///< Start time of the current cycle.
+    double                    m_peakMax       = 0.0;    ///< Max measurement of the current cycle.
+    double                    m_peakMin       = 0.0;    ///< Min measurement of the current cycle.
+    unsigned                  m_cycleCount    = 0;      ///< Number of measured cycles.
+    double                    m_sumAmplitude  = 0.0;    ///< Sum of all measured amplitudes.
+    double                    m_sumPeriod     = 0.0;    ///< Sum of all measured periods.
+    std::optional<Parameters> m_parameters;             ///< Determined controller gains.
+};
+}  // namespace sugo::common
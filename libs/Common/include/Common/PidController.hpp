@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace sugo::common
+{
+/**
+ * @brief Class represents a PID controller with a limited output range. The integral part is only
+ * accumulated as long as the output is not driven further into saturation (anti-windup) and the
+ * derivative part is taken from the measurement, so setpoint changes do not cause output kicks.
+ * It does not use any locks, so it has to be used from within one context only.
+ */
+class PidController
+{
+public:
+    /// @brief Controller gains.
+    struct Parameters
+    {
+        double proportional = 0.0;  ///< Proportional gain in output per error unit.
+        double integral     = 0.0;  ///< Integral gain in output per error unit and second.
+        double derivative   = 0.0;  ///< Derivative gain in output seconds per error unit.
+    };
+
+    /**
+     * @brief Constructs a new PID controller object.
+     *
+     * @param parameters Controller gains.
+     * @param outputMin  Lowest output value.
+     * @param outputMax  Highest output value.
+     */
+    explicit PidController(const Parameters& parameters, double outputMin = 0.0,
+                           double outputMax = 1.0);
+
+    /**
+     * @brief Calculates the next output value.
+     *
+     * @param setpoint    Target value.
+     * @param measurement Current measured value.
+     * @param timeStep    Time since the last update in seconds.
+     * @return The output value within the output range.
+     */
+    double update(double setpoint, double measurement, double timeStep);
+
+    /**
+     * @brief Sets new controller gains. The accumulated integral part is kept.
+     *
+     * @param parameters Controller gains.
+     */
+    void setParameters(const Parameters& parameters);
+
+    /**
+     * @brief Returns the controller gains.
+     *
+     * @return The controller gains.
+     */
+    const Parameters& getParameters() const
+    {
+        return m_parameters;
+    }
+
+    /**
+     * @brief Returns the last output value.
+     *
+     * @return The last output value.
+     */
+    double getOutput() const
+    {
+        return m_output;
+    }
+
+    /// @brief Resets the controller state, but keeps the gains.
+    void reset();
+
+private:
+    Parameters   m_parameters;               ///< Controller gains.
+    const double m_outputMin;                ///< Lowest output value.
+    const double m_outputMax;                ///< Highest output value.
+    double       m_integralPart    = 0.0;    ///< Accumulated integral part of the output.
+    double       m_lastMeasurement = 0.0;    ///< Measurement of the last update.
+    bool         m_hasMeasurement  = false;  ///< Indicates if there was an update before.
+    double       m_output          = 0.0;    ///< Last output value.
+};
+}  // namespace sugo::common
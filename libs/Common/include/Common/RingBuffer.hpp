@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+namespace sugo::common
+{
+/**
+ * @brief Class represents a fixed-capacity ring buffer for exactly one producer and one consumer
+ * context, which could also be the same one. Both sides work without any locks, so the producer
+ * is never blocked by the consumer. If the buffer is full, new values are rejected until the
+ * consumer removed old ones. It does not allocate any memory.
+ *
+ * @tparam ValueT   Value type.
+ * @tparam Capacity Max number of values, which has to be a power of two.
+ */
+template <class ValueT, std::size_t Capacity>
+class RingBuffer
+{
+    static_assert((Capacity > 0) && ((Capacity & (Capacity - 1)) == 0),
+                  "Capacity must be a power of two");
+
+public:
+    /**
+     * @brief Returns the max number of values.
+     *
+     * @return The capacity.
+     */
+    static constexpr std::size_t capacity()
+    {
+        return Capacity;
+    }
+
+    /**
+     * @brief Adds a new value. Must only be called from the producer context.
+     *
+     * @param value Value to add.
+     * @return true  If the value has been added.
+     * @return false If the buffer is full and the value has been rejected.
+     */
+    bool push(const ValueT& value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if ((head - m_tail.load(std::memory_order_acquire)) == Capacity)
+        {
+            return false;
+        }
+
+        m_buffer[head & (Capacity - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest value. Must only be called from the consumer context.
+     *
+     * @param[out] value Removed value.
+     * @return true  If a value has been removed.
+     * @return false If the buffer is empty.
+     */
+    bool pop(ValueT& value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        value = m_buffer[tail & (Capacity - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest value without returning it. Must only be called from the consumer
+     * context.
+     *
+     * @return true  If a value has been removed.
+     * @return false If the buffer is empty.
+     */
+    bool pop()
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Returns the value at the position, where 0 is the oldest value. Must only be called
+     * from the consumer context.
+     *
+     * @param index Position of the value.
+     * @return The value.
+     */
+    const ValueT& operator[](std::size_t index) const
+    {
+        assert(index < size());
+        return m_buffer[(m_tail.load(std::memory_order_relaxed) + index) & (Capacity - 1)];
+    }
+
+    /**
+     * @brief Returns the oldest value. Must only be called from the consumer context.
+     *
+     * @return The oldest value.
+     */
+    const ValueT& front() const
+    {
+        return (*this)[0];
+    }
+
+    /**
+     * @brief Returns the newest value. Must only be called from the consumer context.
+     *
+     * @return The newest value.
+     */
+    const ValueT& back() const
+    {
+        return (*this)[size() - 1];
+    }
+
+    /**
+     * @brief Returns the current number of values, which might already be outdated if the other
+     * context works concurrently.
+     *
+     * @return The number of values.
+     */
+    std::size_t size() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Indicates if the buffer contains no value.
+     *
+     * @return true  If the buffer is empty.
+     * @return false If the buffer is not empty.
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Indicates if the buffer is full, so the next push is rejected.
+     *
+     * @return true  If the buffer is full.
+     * @return false If the buffer is not full.
+     */
+    bool full() const
+    {
+        return size() == Capacity;
+    }
+
+    /// @brief Removes all values. Must only be called from the consumer context.
+    void clear()
+    {
+        m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    std::array<ValueT, Capacity>         m_buffer{};  ///< Value buffer.
+    alignas(64) std::atomic<std::size_t> m_head{0};   ///< Count of written values.
+    alignas(64) std::atomic<std::size_t> m_tail{0};   ///< Count of read values.
+};
+}  // namespace sugo::common
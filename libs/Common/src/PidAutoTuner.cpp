@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "Common/PidAutoTuner.hpp"
+
+namespace
+{
+// Classic Ziegler-Nichols tuning rules
+constexpr double ProportionalFactor   = 0.6;        // of the ultimate gain
+constexpr double IntegralTimeFactor   = 1.0 / 2.0;  // of the ultimate period
+constexpr double DerivativeTimeFactor = 1.0 / 8.0;  // of the ultimate period
+constexpr double Pi                   = 3.14159265358979323846;
+}  // namespace
+
+using namespace sugo::common;
+
+PidAutoTuner::PidAutoTuner(double setpoint, double hysteresis, double outputMin, double outputMax,
+                           unsigned cycles)
+    : m_setpoint(setpoint),
+      m_hysteresis(hysteresis),
+      m_outputMin(outputMin),
+      m_outputMax(outputMax),
+      m_cycles(cycles)
+{
+    assert(m_hysteresis >= 0.0);
+    assert(m_outputMin < m_outputMax);
+    assert(m_cycles > 0);
+}
+
+double PidAutoTuner::update(double measurement, double time)
+{
+    if (m_isOutputHigh && (measurement > (m_setpoint + m_hysteresis)))
+    {
+        m_isOutputHigh = false;
+    }
+    else if (!m_isOutputHigh && (measurement < (m_setpoint - m_hysteresis)))
+    {
+        // Each cycle starts by switching on, which skips the initial heat-up.
+        m_isOutputHigh = true;
+        if (m_hasCycleStart && !isFinished())
+        {
+            finishCycle(time);
+        }
+        m_hasCycleStart = true;
+        m_cycleStart    = time;
+        m_peakMax       = measurement;
+        m_peakMin       = measurement;
+    }
+
+    m_peakMax = std::max(m_peakMax, measurement);
+    m_peakMin = std::min(m_peakMin, measurement);
+    return m_isOutputHigh ? m_outputMax : m_outputMin;
+}
+
+void PidAutoTuner::finishCycle(double time)
+{
+    m_sumAmplitude += (m_peakMax - m_peakMin) / 2.0;
+    m_sumPeriod += time - m_cycleStart;
+    ++m_cycleCount;
+
+    if (m_cycleCount < m_cycles)
+    {
+        return;
+    }
+
+    const double amplitude = m_sumAmplitude / static_cast<double>(m_cycleCount);
+    const double period    = m_sumPeriod / static_cast<double>(m_cycleCount);
+    if ((amplitude <= m_hysteresis) || (period <= 0.0))
+    {
+        // No usable oscillation, start over
+        m_cycleCount   = 0;
+        m_sumAmplitude = 0.0;
+        m_sumPeriod    = 0.0;
+        return;
+    }
+
+    // Describing function of a relay with hysteresis
+    const double relayAmplitude = (m_outputMax - m_outputMin) / 2.0;
+    const double ultimateGain =
+        4.0 * relayAmplitude /
+        (Pi * std::sqrt(amplitude * amplitude - m_hysteresis * m_hysteresis));
+
+    const double proportional = ProportionalFactor * ultimateGain;
+    m_parameters = Parameters{proportional, proportional / (IntegralTimeFactor * period),
+                              proportional * DerivativeTimeFactor * period};
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+
+#include "Common/PidController.hpp"
+
+using namespace sugo::common;
+
+PidController::PidController(const Parameters& parameters, double outputMin, double outputMax)
+    : m_parameters(parameters), m_outputMin(outputMin), m_outputMax(outputMax)
+{
+    assert(m_outputMin < m_outputMax);
+}
+
+double PidController::update(double setpoint, double measurement, double timeStep)
+{
+    const double error          = setpoint - measurement;
+    double       derivativePart = 0.0;
+
+    if (m_hasMeasurement && (timeStep > 0.0))
+    {
+        derivativePart =
+            -m_parameters.derivative * (measurement - m_lastMeasurement) / timeStep;
+    }
+    m_lastMeasurement = measurement;
+    m_hasMeasurement  = true;
+
+    const double proportionalPart = m_parameters.proportional * error;
+    const double integralPart     = m_integralPart + m_parameters.integral * error * timeStep;
+    const double output           = proportionalPart + integralPart + derivativePart;
+
+    // Anti-windup: Only integrate if the output is not saturated or the error leads out of it.
+    if (((output < m_outputMax) || (error < 0.0)) && ((output > m_outputMin) || (error > 0.0)))
+    {
+        m_integralPart = std::clamp(integralPart, m_outputMin, m_outputMax);
+    }
+
+    m_output =
+        std::clamp(proportionalPart + m_integralPart + derivativePart, m_outputMin, m_outputMax);
+    return m_output;
+}
+
+void PidController::setParameters(const Parameters& parameters)
+{
+    m_parameters = parameters;
+}
+
+void PidController::reset()
+{
+    m_integralPart    = 0.0;
+    m_lastMeasurement = 0.0;
+    m_hasMeasurement  = false;
+    m_output          = 0.0;
+}
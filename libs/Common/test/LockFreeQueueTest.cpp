@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/LockFreeQueue.hpp"
+
+using namespace sugo::common;
+
+class LockFreeQueueTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(LockFreeQueueTest, PushUntilFull)
+{
+    LockFreeQueue<std::string, 4> queue;
+    EXPECT_EQ(queue.capacity(), 4u);
+
+    for (int value = 1; value <= 4; ++value)
+    {
+        EXPECT_TRUE(queue.push(std::to_string(value)));
+    }
+    EXPECT_FALSE(queue.push("5"));
+
+    std::string value;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "1");
+    EXPECT_TRUE(queue.push("5"));
+    for (int expected = 2; expected <= 5; ++expected)
+    {
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, std::to_string(expected));
+    }
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST_F(LockFreeQueueTest, ConcurrentProducers)
+{
+    constexpr int          ProducerCount      = 4;
+    constexpr int          ValuesPerProducer  = 50000;
+    LockFreeQueue<int, 64> queue;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < ProducerCount; ++producer)
+    {
+        producers.emplace_back([&queue, producer] {
+            for (int value = 0; value < ValuesPerProducer;)
+            {
+                if (queue.push((producer * ValuesPerProducer) + value))
+                {
+                    ++value;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // All values have to arrive exactly once and in order per producer. The queue is drained
+    // completely in any case, so the producers could be joined before checking.
+    std::vector<int> expected(ProducerCount, 0);
+    int              unexpectedCount = 0;
+    for (int count = 0; count < (ProducerCount * ValuesPerProducer);)
+    {
+        int value = -1;
+        if (queue.pop(value))
+        {
+            const int producer = value / ValuesPerProducer;
+            if ((producer >= 0) && (producer < ProducerCount) &&
+                ((value % ValuesPerProducer) == expected[producer]))
+            {
+                ++expected[producer];
+            }
+            else
+            {
+                ++unexpectedCount;
+            }
+            ++count;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_EQ(unexpectedCount, 0);
+    for (int producer = 0; producer < ProducerCount; ++producer)
+    {
+        EXPECT_EQ(expected[producer], ValuesPerProducer);
+    }
+    int value = -1;
+    EXPECT_FALSE(queue.pop(value));
+}
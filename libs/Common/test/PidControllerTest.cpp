@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <deque>
+
+#include "Common/PidAutoTuner.hpp"
+#include "Common/PidController.hpp"
+
+using namespace sugo::common;
+
+namespace
+{
+/// Simplified heater model: first order lag with dead time and a switched heater relay.
+class ThermalModel
+{
+public:
+    static constexpr double TimeStep = 0.1;  // s
+
+    ThermalModel() : m_delayedPower(static_cast<std::size_t>(DeadTime / TimeStep), 0.0)
+    {
+    }
+
+    double step(bool isHeaterOn)
+    {
+        m_delayedPower.push_back(isHeaterOn ? 1.0 : 0.0);
+        const double power = m_delayedPower.front();
+        m_delayedPower.pop_front();
+        m_temperature += (Ambient + Gain * power - m_temperature) * TimeStep / TimeConstant;
+        return m_temperature;
+    }
+
+    double getTemperature() const
+    {
+        return m_temperature;
+    }
+
+private:
+    static constexpr double Ambient      = 25.0;   // °C
+    static constexpr double Gain         = 300.0;  // K at full power
+    static constexpr double TimeConstant = 150.0;  // s
+    static constexpr double DeadTime     = 8.0;    // s
+
+    std::deque<double> m_delayedPower;
+    double             m_temperature = Ambient;
+};
+
+constexpr double TemperatureMin    = 195.0;
+constexpr double TemperatureMax    = 205.0;
+constexpr double TemperatureTarget = (TemperatureMin + TemperatureMax) / 2.0;
+constexpr double SimulationTime    = 3600.0;  // s
+
+/// Returns the gains found by the relay auto tuner on the model.
+PidController::Parameters autoTune()
+{
+    ThermalModel model;
+    PidAutoTuner tuner(TemperatureTarget, 0.5);
+    for (double time = 0.0; !tuner.isFinished() && (time < SimulationTime);
+         time += ThermalModel::TimeStep)
+    {
+        (void)model.step(tuner.update(model.getTemperature(), time) > 0.5);
+    }
+    EXPECT_TRUE(tuner.isFinished());
+    return tuner.getParameters().value_or(PidController::Parameters{});
+}
+}  // namespace
+
+class PidControllerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(PidControllerTest, OutputIsLimited)
+{
+    PidController controller({1.0, 0.0, 0.0}, 0.0, 1.0);
+    EXPECT_DOUBLE_EQ(controller.update(10.0, 9.5, 1.0), 0.5);
+    EXPECT_DOUBLE_EQ(controller.update(10.0, 0.0, 1.0), 1.0);
+    EXPECT_DOUBLE_EQ(controller.update(10.0, 20.0, 1.0), 0.0);
+    EXPECT_DOUBLE_EQ(controller.getOutput(), 0.0);
+}
+
+TEST_F(PidControllerTest, IntegralAntiWindup)
+{
+    PidController controller({0.1, 0.01, 0.0}, 0.0, 1.0);
+
+    // Long saturation must not wind up the integral part beyond the output range.
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        EXPECT_DOUBLE_EQ(controller.update(100.0, 0.0, 1.0), 1.0);
+    }
+
+    // The output has to leave saturation as soon as the setpoint is exceeded.
+    EXPECT_LT(controller.update(100.0, 101.0, 1.0), 1.0);
+
+    controller.reset();
+    EXPECT_DOUBLE_EQ(controller.update(0.0, 0.0, 1.0), 0.0);
+}
+
+TEST_F(PidControllerTest, AutoTune)
+{
+    const PidController::Parameters parameters = autoTune();
+    EXPECT_GT(parameters.proportional, 0.0);
+    EXPECT_GT(parameters.integral, 0.0);
+    EXPECT_GT(parameters.derivative, 0.0);
+}
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "Common/RingBuffer.hpp"
+
+using namespace sugo::common;
+
+class RingBufferTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(RingBufferTest, PushUntilFull)
+{
+    RingBuffer<int, 4> buffer;
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.capacity(), 4u);
+
+    for (int value = 1; value <= 4; ++value)
+    {
+        EXPECT_TRUE(buffer.push(value));
+    }
+    EXPECT_EQ(buffer.size(), 4u);
+    EXPECT_TRUE(buffer.full());
+    EXPECT_FALSE(buffer.push(5));
+    EXPECT_EQ(buffer[0], 1);
+    EXPECT_EQ(buffer[3], 4);
+    EXPECT_EQ(buffer.front(), 1);
+    EXPECT_EQ(buffer.back(), 4);
+
+    int value = 0;
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(buffer.push(5));
+    for (int expected = 2; expected <= 5; ++expected)
+    {
+        EXPECT_TRUE(buffer.pop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(buffer.pop(value));
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST_F(RingBufferTest, SlidingWindow)
+{
+    RingBuffer<int, 4> buffer;
+    for (int value = 1; value <= 6; ++value)
+    {
+        if (buffer.full())
+        {
+            EXPECT_TRUE(buffer.pop());
+        }
+        EXPECT_TRUE(buffer.push(value));
+    }
+    EXPECT_EQ(buffer.size(), 4u);
+    EXPECT_EQ(buffer[0], 3);
+    EXPECT_EQ(buffer[1], 4);
+    EXPECT_EQ(buffer[2], 5);
+    EXPECT_EQ(buffer[3], 6);
+    EXPECT_EQ(buffer.front(), 3);
+    EXPECT_EQ(buffer.back(), 6);
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_FALSE(buffer.pop());
+    EXPECT_TRUE(buffer.push(7));
+    EXPECT_EQ(buffer.front(), 7);
+    EXPECT_EQ(buffer.back(), 7);
+}
+
+TEST_F(RingBufferTest, ConcurrentProducerAndConsumer)
+{
+    constexpr int       ValueCount = 100000;
+    RingBuffer<int, 64> buffer;
+
+    std::thread producer([&buffer] {
+        for (int value = 0; value < ValueCount;)
+        {
+            if (buffer.push(value))
+            {
+                ++value;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // All values have to arrive exactly once and in order.
+    int expected = 0;
+    int received = 0;
+    while (received < ValueCount)
+    {
+        int value = -1;
+        if (buffer.pop(value))
+        {
+            EXPECT_EQ(value, expected);
+            expected = value + 1;
+            ++received;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(buffer.empty());
+}
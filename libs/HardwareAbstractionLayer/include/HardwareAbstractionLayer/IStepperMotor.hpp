@@ -25,6 +25,7 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <ostream>
 
 #include "HardwareAbstractionLayer/IHalObject.hpp"
@@ -39,9 +40,22 @@ public:
     using StepCount = unsigned;
     /// Speed value type
     using Speed = UnitValue<unsigned>;
+    /// Fixed-point scale of speed values with unit Unit::MilliRpm.
+    static constexpr unsigned MilliRpmPerRpm = 1000u;
     /// Position type
     using Position = int32_t;
 
+    /// Result of an asynchronous motion.
+    enum MotionResult
+    {
+        MotionSucceeded,  ///< Motion finished and the motor has been shut down.
+        MotionFailed,     ///< Motion or shutdown failed, or an error occurred.
+        MotionAborted     ///< Observation aborted by a further motion or stop.
+    };
+
+    /// Handler called at the end of an asynchronous motion, which passes its result.
+    using MotionCompletionHandler = std::function<void(MotionResult)>;
+
     /// Direction of rotation.
     enum Direction
     {
@@ -49,6 +63,15 @@ public:
         Backward  ///< backward
     };
 
+    /// Motor state sample, whose values are read at once from the motor controller.
+    struct Telemetry
+    {
+        Position position    = 0;      ///< Current position in microsteps.
+        int32_t  velocity    = 0;      ///< Current signed velocity in milli-RPM.
+        uint32_t errorFlags  = 0;      ///< Controller specific error flags, 0 if none is set.
+        bool     isEnergized = false;  ///< Indicates if the motor is energized.
+    };
+
     /**
      * @brief Destroy the IStepperMotor object.
      *
@@ -77,6 +100,20 @@ public:
      */
     virtual bool rotateToPosition(Position position) = 0;
 
+    /**
+     * @brief Rotates the stepper motor to passed position without blocking the caller.
+     * The handler is called from a different context as soon as the position has been reached
+     * or an error occurred. A further motion or stop call aborts the observation of the motion
+     * and the handler is called with MotionAborted.
+     *
+     * @param position Position which should be reached.
+     * @param handler  Handler to be called at the end of the motion.
+     * @return true If the motion could be started.
+     * @return false If the motion could not be started.
+     * @note The handler must not call the motor itself!
+     */
+    virtual bool rotateToPositionAsync(Position position, MotionCompletionHandler handler) = 0;
+
     /**
      * @brief Starts rotating the stepper motor continuously.
      * The caller will not be blocked by that call. The rotation has to be
@@ -110,6 +147,20 @@ public:
      */
     virtual bool stop(bool stopImmediately) = 0;
 
+    /**
+     * @brief Stops a running rotation without blocking the caller. The handler is called from
+     * a different context as soon as the motor has stopped or an error occurred. A further motion
+     * or stop call aborts the observation and the handler is called with MotionAborted.
+     *
+     * @param stopImmediately Indicates if the motor should be stopped immediately (true) or
+     *                        by decreasing speed (false).
+     * @param handler         Handler to be called at the end of the motion.
+     * @return true If the stop could be initiated.
+     * @return false If the stop could not be initiated.
+     * @note The handler must not call the motor itself!
+     */
+    virtual bool stopAsync(bool stopImmediately, MotionCompletionHandler handler) = 0;
+
     /**
      * @brief Returns the current position of the motor.
      *
@@ -132,24 +183,34 @@ public:
      */
     virtual StepCount getStepsPerRound() const = 0;
 
+    /**
+     * @brief Reads a consistent sample of the current motor state from the controller.
+     * Following position or speed queries may share that read.
+     *
+     * @param[out] telemetry Current motor state.
+     * @return true  If the state could be read.
+     * @return false If the state could not be read.
+     */
+    virtual bool getTelemetry(Telemetry& telemetry) const = 0;
+
     /**
      * @brief Returns the current motor speed.
      *
-     * @return Speed The current motor speed.
+     * @return Speed The current motor speed of unit Unit::MilliRpm.
      */
     virtual Speed getSpeed() const = 0;
 
     /**
      * @brief Returns the max motor speed
      *
-     * @return unsigned Maximum motor speed in RPM.
+     * @return Speed Maximum motor speed of unit Unit::MilliRpm.
      */
     virtual Speed getMaxSpeed() const = 0;
 
     /**
      * @brief Set the max motor speed.
      *
-     * @param maxSpeed Sets the max speed in RPMs.
+     * @param maxSpeed Sets the max speed of unit Unit::Rpm or Unit::MilliRpm.
      */
     virtual void setMaxSpeed(Speed maxSpeed) = 0;
 
@@ -157,22 +218,60 @@ public:
      * @brief Sets the target speed of the motor.
      *
      * @note The rotation direction cannot be changed until motor has been stopped again!
-     * @param speed Velocity to be set.
+     * @param speed Velocity to be set of unit Unit::Rpm or Unit::MilliRpm.
      * @return true If the speed could be set successfully.
      * @return false If the speed could not be set successfully.
      */
     virtual bool setSpeed(Speed speed) = 0;
 
+    /**
+     * @brief Sets the target speed of the motor synchronously with the other motors of the same
+     * control. The speed change is held back until all these motors got a synchronized speed
+     * change, then all motors change their speed at the same time and finish their ramps
+     * together. A speed change by setSpeed() meanwhile updates the held back one.
+     *
+     * @note The rotation direction cannot be changed until motor has been stopped again!
+     * @param speed Velocity to be set of unit Unit::Rpm or Unit::MilliRpm.
+     * @return true If the speed could be set or held back successfully.
+     * @return false If the speed could not be set successfully.
+     */
+    virtual bool setSpeedSynchronized(Speed speed) = 0;
+
+    /**
+     * @brief Discards the held back synchronized speed change of the motor together with the
+     * ones of the other motors, since they cannot be completed anymore. The motor keeps its
+     * former speed.
+     *
+     * @return true If a held back speed change has been discarded.
+     * @return false If the motor had no held back speed change.
+     */
+    virtual bool cancelSpeedSynchronized() = 0;
+
     /**
      * @brief Returns the time between one step to the next step position.
      *
-     * @param rpm Speed of the rotation.
+     * @param speed Speed of the rotation of unit Unit::Rpm or Unit::MilliRpm.
      * @return std::chrono::microseconds The time between one step to the next step position.
      */
-    inline std::chrono::microseconds getTimePerStep(unsigned rpm) const
+    inline std::chrono::microseconds getTimePerStep(Speed speed) const
     {
         using namespace std::literals::chrono_literals;
-        return (60000000us / static_cast<int64_t>(rpm * getStepsPerRound()));
+        return (60000000us * static_cast<int64_t>(MilliRpmPerRpm)) /
+               (static_cast<int64_t>(toMilliRpm(speed).getValue()) *
+                static_cast<int64_t>(getStepsPerRound()));
+    }
+
+    /**
+     * @brief Converts a speed value into a fixed-point value of unit Unit::MilliRpm.
+     *
+     * @param speed Speed value of unit Unit::Rpm or Unit::MilliRpm.
+     * @return Speed Fixed-point speed value.
+     */
+    static constexpr Speed toMilliRpm(const Speed& speed)
+    {
+        return (speed.getUnit() == Unit::Rpm) ? Speed{speed.getValue() * MilliRpmPerRpm,
+                                                      Unit::MilliRpm}
+                                              : speed;
     }
 
 protected:
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "HardwareAbstractionLayer/IHalObject.hpp"
 #include "HardwareAbstractionLayer/UnitValue.hpp"
 
@@ -38,13 +40,46 @@ public:
     /// Translated value type
     using Temperature = UnitValue<RawTemperature>;
 
+    /// Fixed-point scale of values with unit Unit::DeciCelcius.
+    static constexpr RawTemperature DeciCelciusPerCelcius = 10;
+
+    /// Handler type which receives new temperature samples.
+    using SampleHandler = std::function<void(const Temperature&)>;
+
     /**
      * @brief Returns a unit translated value according to the used filter.
+     * Sensors with sub-degree resolution provide a fixed-point value of unit Unit::DeciCelcius,
+     * all others a value of unit Unit::Celcius.
      *
      * @return Temperature Unit translated value.
      */
     virtual Temperature getTemperature() const = 0;
 
+    /**
+     * @brief Registers a handler which is called whenever the sensor signals a new sample.
+     * The handler is called within the sensor observation context. Sensors without a data-ready
+     * signal do not support handlers and have to be polled with getTemperature() instead.
+     *
+     * @param handler Handler to be called or nullptr to unregister the current handler.
+     * @return true   If the handler could be registered.
+     * @return false  If the sensor does not provide samples and has to be polled.
+     */
+    virtual bool registerSampleHandler(SampleHandler handler) = 0;
+
+    /**
+     * @brief Converts a temperature value into a fixed-point value of unit Unit::DeciCelcius.
+     *
+     * @param temperature Temperature value of unit Unit::Celcius or Unit::DeciCelcius.
+     * @return Temperature Fixed-point temperature value.
+     */
+    static Temperature toDeciCelcius(const Temperature& temperature)
+    {
+        return (temperature.getUnit() == Unit::Celcius)
+                   ? Temperature{temperature.getValue() * DeciCelciusPerCelcius,
+                                 Unit::DeciCelcius}
+                   : temperature;
+    }
+
 protected:
     using IHalObject::IHalObject;
 };
@@ -53,6 +53,10 @@ inline const Identifier GpioPinSignalFilamentTensionHigh{"signal-filament-tensio
 inline const Identifier GpioPinSignalFilamentTensionOverload{"signal-filament-tension-overload"};
 inline const Identifier GpioPinSignalButtonStop{"signal-button-stop"};
 inline const Identifier GpioPinMotorControlError{"motor-control-error"};
+inline const Identifier GpioPinTemperatureSensorControlDrdyFeeder{
+    "temperature-sensor-control-drdy-feeder"};
+inline const Identifier GpioPinTemperatureSensorControlDrdyMerger{
+    "temperature-sensor-control-drdy-merger"};
 inline const Identifier HardwareAbstractionLayer{"hardware-abstraction-layer"};
 inline const Identifier GpioControl{"gpio-control"};
 inline const Identifier StepperMotorControl{"stepper-motor-control"};
@@ -64,6 +68,7 @@ inline const Identifier StepperMotorFeeder{"feeder"};
 inline const Identifier StepperMotorCoiler{"coiler"};
 inline const Identifier GpioPin{"gpio-pin"};
 inline const Identifier ChipSelect{"chip-select"};
+inline const Identifier DataReady{"data-ready"};
 inline const Identifier ActiveHigh{"active-high"};
 inline const Identifier MaxSpeedRpm{"max-speed-rpm"};
 inline const Identifier I2cAddress{"i2c-address"};
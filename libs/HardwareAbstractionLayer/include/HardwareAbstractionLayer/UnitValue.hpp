@@ -33,7 +33,9 @@ enum class Unit
     Celcius,
     Volt,
     Ohm,
-    Rpm
+    Rpm,
+    DeciCelcius,  ///< Fixed-point Celcius with a resolution of 1/10 degree.
+    MilliRpm      ///< Fixed-point RPM with a resolution of 1/1000 RPM.
 };
 
 /**
@@ -51,7 +53,7 @@ public:
      * @param value Initial value
      * @param unit  Unit of that value
      */
-    UnitValue(ValueT value, Unit unit) : m_value(value), m_unit(unit)
+    constexpr UnitValue(ValueT value, Unit unit) : m_value(value), m_unit(unit)
     {
     }
 
@@ -63,22 +65,22 @@ public:
 
     UnitValue<ValueT>& operator=(UnitValue<ValueT>&& other) noexcept = default;
 
-    ValueT getValue() const
+    constexpr ValueT getValue() const
     {
         return m_value;
     }
 
-    Unit getUnit() const
+    constexpr Unit getUnit() const
     {
         return m_unit;
     }
 
-    operator ValueT() const
+    constexpr operator ValueT() const
     {
         return m_value;
     }
 
-    operator Unit() const
+    constexpr operator Unit() const
     {
         return m_unit;
     }
@@ -90,7 +92,7 @@ public:
      * @return true  If they are equal.
      * @return false If they are not equal.
      */
-    bool operator==(const UnitValue<ValueT>& other) const
+    constexpr bool operator==(const UnitValue<ValueT>& other) const
     {
         return (other.m_unit == m_unit) && (other.m_value == m_value);
     }
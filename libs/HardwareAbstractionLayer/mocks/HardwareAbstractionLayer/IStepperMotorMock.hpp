@@ -41,15 +41,21 @@ public:
     MOCK_METHOD(bool, init, (const common::IConfiguration&));
     MOCK_METHOD(bool, reset, ());
     MOCK_METHOD(bool, rotateToPosition, (Position position));
+    MOCK_METHOD(bool, rotateToPositionAsync,
+                (Position position, MotionCompletionHandler handler));
     MOCK_METHOD(bool, rotate, (Direction direction));
     MOCK_METHOD(bool, rotate, ());
     MOCK_METHOD(bool, stop, (bool stopImmediately));
+    MOCK_METHOD(bool, stopAsync, (bool stopImmediately, MotionCompletionHandler handler));
     MOCK_METHOD(Position, getPosition, (), (const));
     MOCK_METHOD(StepCount, getMicroStepCount, (), (const));
     MOCK_METHOD(StepCount, getStepsPerRound, (), (const));
+    MOCK_METHOD(bool, getTelemetry, (Telemetry&), (const));
     MOCK_METHOD(Speed, getSpeed, (), (const));
     MOCK_METHOD(Speed, getMaxSpeed, (), (const));
     MOCK_METHOD(void, setMaxSpeed, (Speed maxSpeed));
     MOCK_METHOD(bool, setSpeed, (Speed));
+    MOCK_METHOD(bool, setSpeedSynchronized, (Speed));
+    MOCK_METHOD(bool, cancelSpeedSynchronized, ());
 };
 }  // namespace sugo::hal
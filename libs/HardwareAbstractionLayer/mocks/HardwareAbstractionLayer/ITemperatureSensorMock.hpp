@@ -40,5 +40,6 @@ public:
 
     MOCK_METHOD(bool, init, (const common::IConfiguration&));
     MOCK_METHOD(Temperature, getTemperature, (), (const));
+    MOCK_METHOD(bool, registerSampleHandler, (SampleHandler));
 };
 }  // namespace sugo::hal
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "Common/Thread.hpp"
+#include "HardwareAbstractionLayer/I2cControl.hpp"
+
+namespace sugo::hal
+{
+/**
+ * @brief Class arbitrates the access of several threads to one I2C bus.
+ * While running, all transfers are queued per device and passed to the bus by the arbiter thread
+ * only. Batches to the same device are transferred in the order they have been queued, while the
+ * next batch of the device with the highest priority is transferred first. Each batch is
+ * transferred as one combined transaction, so a status request delays a stop command of another
+ * device by one transaction at most. A batch to several devices is queued for each of them and
+ * transferred as soon as it is the next batch of all these devices.
+ */
+class I2cBusArbiter : public I2cControl
+{
+public:
+    /// @brief Clock type of the statistics.
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Bus statistics of one device.
+    struct Statistics
+    {
+        uint64_t                  transactions = 0;  ///< Transferred batches.
+        uint64_t                  commands     = 0;  ///< Transferred commands.
+        uint64_t                  replaced     = 0;  ///< Batches replaced before the transfer.
+        uint64_t                  failures     = 0;  ///< Failed batches.
+        std::chrono::microseconds waitTime{0};       ///< Accumulated time until the transfer.
+        std::chrono::microseconds maxWaitTime{0};    ///< Maximum time until the transfer.
+        std::chrono::microseconds busTime{0};        ///< Accumulated transfer time.
+    };
+
+    /// @brief Bus statistics per device address.
+    using StatisticsMap = std::map<Address, Statistics>;
+
+    I2cBusArbiter() : m_thread("I2cBusArbiter")
+    {
+    }
+    ~I2cBusArbiter() override;
+
+    /**
+     * @brief Starts the arbiter thread.
+     * Before, all transfers are passed directly to the bus within the calling thread.
+     *
+     * @return true if the arbiter thread could be started.
+     * @return false if the arbiter thread could not be started.
+     */
+    bool start();
+
+    /**
+     * @brief Stops the arbiter thread.
+     * Pending batches are failed.
+     */
+    void stop();
+
+    /**
+     * @brief Queues the batch and waits until it has been transferred by the arbiter thread.
+     *
+     * @param batch Batch to be transferred, which receives the responses.
+     * @return true if succeeded or the batch has been replaced by a newer one.
+     * @return false if failed
+     */
+    bool transfer(Batch& batch) const override;
+
+    /**
+     * @brief Returns the bus statistics of all devices.
+     *
+     * @return Statistics per device address.
+     */
+    StatisticsMap getStatistics() const;
+
+private:
+    /// @brief Queued batch, which is owned by the waiting thread.
+    struct Request
+    {
+        Batch&               batch;              ///< Batch to be transferred.
+        Clock::time_point    queueTime;          ///< Time the batch has been queued.
+        std::vector<Address> addresses;          ///< Addressed devices.
+        bool                 isStarted = false;  ///< Indicates if the transfer has been started.
+        bool                 isDone    = false;  ///< Indicates if the request has been finished.
+        bool                 success   = false;  ///< Transfer result.
+    };
+
+    /// @brief Request queue of one device.
+    using RequestQueue = std::deque<Request*>;
+
+    void     run();
+    void     replace(RequestQueue& queue) const;
+    void     dequeue(Request& request) const;
+    bool     isNext(const Request& request) const;
+    Request* selectRequest();
+    void     complete(Request& request, bool success) const;
+
+    mutable std::mutex                      m_mutex;                ///< Protects the queues.
+    mutable std::condition_variable         m_requestCondition;     ///< Signals new requests.
+    mutable std::condition_variable         m_completionCondition;  ///< Signals finished requests.
+    mutable std::map<Address, RequestQueue> m_queues;               ///< Requests per device.
+    mutable StatisticsMap                   m_statistics;           ///< Statistics per device.
+    Address                                 m_lastAddress = 0;      ///< Last served device.
+    bool                                    m_isRunning   = false;  ///< Arbiter run indication.
+    common::Thread                          m_thread;               ///< Arbiter thread.
+};
+}  // namespace sugo::hal
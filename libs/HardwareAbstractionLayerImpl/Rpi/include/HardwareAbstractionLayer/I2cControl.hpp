@@ -26,9 +26,12 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "HardwareAbstractionLayer/HalTypes.hpp"
 
+struct i2c_msg;
+
 namespace sugo::hal
 {
 /// @brief Control class for handling I2C messaging.
@@ -38,14 +41,188 @@ public:
     /// @brief I2C address type.
     using Address = uint8_t;
 
+    /// @brief Builder of a command batch, which is transferred within one combined transaction.
+    class Batch
+    {
+    public:
+        /// @brief Priority of the batch, if the bus is shared by several threads.
+        enum class Priority
+        {
+            Low,     ///< Status requests.
+            Normal,  ///< Settings and motion commands.
+            High     ///< Commands which stop a motion.
+        };
+
+        /**
+         * @brief Constructs a new empty batch.
+         *
+         * @param address Device address of all commands.
+         */
+        explicit Batch(Address address) : m_address(address)
+        {
+        }
+
+        /**
+         * @brief Adds a command without response.
+         *
+         * @param command Command to be sent.
+         * @return Reference to this batch.
+         */
+        Batch& write(const ByteBuffer& command)
+        {
+            return write(m_address, command);
+        }
+
+        /**
+         * @brief Adds a command without response to another device than the batch device.
+         * So the commands of several devices could be sent back to back.
+         *
+         * @param address Device address of the command.
+         * @param command Command to be sent.
+         * @return Reference to this batch.
+         */
+        Batch& write(Address address, const ByteBuffer& command);
+
+        /**
+         * @brief Adds a command with a response.
+         *
+         * @param command      Command to be sent.
+         * @param responseSize Expected size of the response.
+         * @return Reference to this batch.
+         */
+        Batch& read(const ByteBuffer& command, size_t responseSize);
+
+        /**
+         * @brief Returns the response of a read command after the transfer.
+         *
+         * @param index Index of the read command in order of the read commands.
+         * @return Response of the command.
+         */
+        const ByteBuffer& getResponse(size_t index) const;
+
+        /**
+         * @brief Returns the number of I2C messages needed for the transfer.
+         *
+         * @return Number of messages.
+         */
+        size_t getMessageCount() const
+        {
+            return m_commands.size() + m_responseIndices.size();
+        }
+
+        /**
+         * @brief Returns the number of commands.
+         *
+         * @return Number of commands.
+         */
+        size_t getCommandCount() const
+        {
+            return m_commands.size();
+        }
+
+        Address getAddress() const
+        {
+            return m_address;
+        }
+
+        /**
+         * @brief Returns the addresses of all devices, which are addressed by the batch.
+         *
+         * @return Device addresses in order of their first command.
+         */
+        std::vector<Address> getAddresses() const;
+
+        bool empty() const
+        {
+            return m_commands.empty();
+        }
+
+        /**
+         * @brief Sets the transfer priority.
+         *
+         * @param priority Priority of the batch.
+         * @return Reference to this batch.
+         */
+        Batch& setPriority(Priority priority)
+        {
+            m_priority = priority;
+            return *this;
+        }
+
+        Priority getPriority() const
+        {
+            return m_priority;
+        }
+
+        /**
+         * @brief Marks the batch as replaceable.
+         * A replaceable batch, which is still waiting for the transfer, is dropped in favor of a
+         * newer replaceable or high priority batch to the same device.
+         *
+         * @param isReplaceable Indicates if the batch is replaceable.
+         * @return Reference to this batch.
+         */
+        Batch& setReplaceable(bool isReplaceable)
+        {
+            m_isReplaceable = isReplaceable;
+            return *this;
+        }
+
+        bool isReplaceable() const
+        {
+            return m_isReplaceable;
+        }
+
+    private:
+        /// @brief Single command of the batch.
+        struct Command
+        {
+            Address    address;         ///< Device address.
+            ByteBuffer request;         ///< Data to be sent.
+            ByteBuffer response;        ///< Data to be received.
+            bool       isRead = false;  ///< Indicates if the command has a response.
+        };
+
+        const Address        m_address;                           ///< Device address.
+        std::vector<Command> m_commands;                          ///< Commands in transfer order.
+        std::vector<size_t>  m_responseIndices;                   ///< Indices of the read commands.
+        Priority             m_priority      = Priority::Normal;  ///< Transfer priority.
+        bool                 m_isReplaceable = false;             ///< Could be dropped for a newer.
+
+        friend class I2cControl;
+    };
+
     I2cControl() = default;
-    ~I2cControl();
+    virtual ~I2cControl();
 
     bool init(const std::string& device);
     void finalize();
 
-    bool read(Address address, const ByteBuffer& command, ByteBuffer& retValue) const;
-    bool write(Address address, const ByteBuffer& command) const;
+    bool read(Address address, const ByteBuffer& command, ByteBuffer& retValue,
+              Batch::Priority priority = Batch::Priority::Normal) const;
+    bool write(Address address, const ByteBuffer& command,
+               Batch::Priority priority = Batch::Priority::Normal) const;
+
+    /**
+     * @brief Transfers all commands of the batch within one combined transaction.
+     * All messages are passed to the bus driver at once, so no other bus access could interfere.
+     *
+     * @param batch Batch to be transferred, which receives the responses.
+     * @return true if succeeded
+     * @return false if failed
+     */
+    virtual bool transfer(Batch& batch) const;
+
+protected:
+    /**
+     * @brief Passes the messages to the bus driver.
+     *
+     * @param messages Messages to be transferred.
+     * @param count    Number of messages.
+     * @return true if all messages have been transferred.
+     * @return false if failed
+     */
+    virtual bool transfer(i2c_msg* messages, size_t count) const;
 
 private:
     constexpr static int InvalidFileDescriptor = -1;
@@ -28,6 +28,7 @@
 
 #include "HardwareAbstractionLayer/HalTypes.hpp"
 #include "HardwareAbstractionLayer/IGpioPin.hpp"
+#include "HardwareAbstractionLayer/RtdConversion.hpp"
 #include "HardwareAbstractionLayer/SpiControl.hpp"
 
 namespace sugo::hal
@@ -48,9 +49,9 @@ public:
     /**
      * @brief Returns the most recent temperature value.
      *
-     * @return int16_t Recent temperature value in Celcius.
+     * @return Recent temperature value in deci Celcius (1/10 degree Celcius).
      */
-    int16_t getTemperature();
+    rtd::Temperature getTemperature();
 
     /**
      * @brief Resets the chip to default mode.
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <linux/spi/spidev.h>
+#include <mutex>
 #include <string>
 
 namespace sugo::hal
@@ -61,17 +62,33 @@ public:
     };
 
     SpiControl() = default;
-    ~SpiControl();
+    virtual ~SpiControl();
 
     bool init(const std::string& device);
     void finalize(void);
 
-    uint8_t writeByte(uint8_t buf);
+    /**
+     * @brief Transfers one byte and returns the byte received meanwhile.
+     *
+     * @param buf Byte to be sent.
+     * @return Received byte.
+     */
+    virtual uint8_t writeByte(uint8_t buf);
     uint8_t readByte()
     {
         return writeByte(0x00);
     }
 
+    /**
+     * @brief Returns the mutex which has to be locked for a complete bus transaction.
+     *
+     * @return Bus mutex.
+     */
+    std::mutex& getBusMutex()
+    {
+        return m_busMutex;
+    }
+
 private:
     constexpr static int InvalidFileDescriptor = -1;
 
@@ -84,6 +101,7 @@ private:
     struct spi_ioc_transfer m_tr = {};
     int                     m_fd = InvalidFileDescriptor;
     uint16_t                m_mode;
+    std::mutex              m_busMutex;
 };
 
 }  // namespace sugo::hal
@@ -27,6 +27,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <mutex>
+#include <optional>
 
 #include "HardwareAbstractionLayer/HalTypes.hpp"
 #include "HardwareAbstractionLayer/I2cControl.hpp"
@@ -43,6 +46,9 @@ namespace sugo::hal
 class TicController
 {
 public:
+    /// @brief Clock type used for the state freshness.
+    using Clock = std::chrono::steady_clock;
+
     TicController(I2cControl::Address address, I2cControl& i2cControl, IGpioPin& ioErr,
                   IGpioPin& ioRst);
     ~TicController();
@@ -80,6 +86,20 @@ public:
         HomingActive       = 0x10,  ///< Homing active
     };
 
+    /// Error status bits
+    enum ErrorStatus : uint16_t
+    {
+        IntentionallyDeEnergized = 0x0001,  ///< Motor has been de-energized on request
+        MotorDriverError         = 0x0002,  ///< Motor driver error
+        LowVin                   = 0x0004,  ///< Supply voltage too low
+        KillSwitchActive         = 0x0008,  ///< Kill switch active
+        RequiredInputInvalid     = 0x0010,  ///< Required input invalid
+        SerialError              = 0x0020,  ///< Serial error
+        CommandTimeout           = 0x0040,  ///< Command timeout
+        SafeStartViolation       = 0x0080,  ///< Safe start violation
+        ErrLineHigh              = 0x0100,  ///< Error line driven high
+    };
+
     /// Motion planning mode
     enum PlanningMode : uint8_t
     {
@@ -115,8 +135,25 @@ public:
         {
             return ((miscFlags & StateFlags::PositionUncertain) != 0);
         }
+
+        /// Indicates errors of this controller, other than the ones of a stopped motor or of
+        /// another controller driving the shared error line.
+        bool hasError() const
+        {
+            return ((errorStatus & ~(ErrorStatus::IntentionallyDeEnergized |
+                                     ErrorStatus::SafeStartViolation | ErrorStatus::ErrLineHigh)) !=
+                    0);
+        }
     } PACKED;
 
+    /// Settings, which are applied before each motion
+    struct MotionSettings
+    {
+        StepMode stepMode     = StepMode::Step1_8;  ///< Step mode
+        uint32_t maxSpeed     = 0;                  ///< Maximum speed in microsteps per 10,000 s
+        uint16_t currentLimit = 0;                  ///< Current limit in mA
+    };
+
     /**
      * @brief This command sets the target position of the Tic, in microsteps.
      * The Tic will start moving the motor to reach the target position.
@@ -141,6 +178,25 @@ public:
      */
     bool setTargetVelocity(int32_t velocity);
 
+    /**
+     * @brief Appends the target velocity command to a batch, which could contain commands to
+     * other controllers too.
+     *
+     * @param batch    Batch to which the command is appended.
+     * @param velocity Velocity to set in microsteps per 10,000 s.
+     */
+    void addTargetVelocity(I2cControl::Batch& batch, int32_t velocity) const;
+
+    /**
+     * @brief Returns the device address of the controller.
+     *
+     * @return Device address.
+     */
+    I2cControl::Address getAddress() const
+    {
+        return m_address;
+    }
+
     /**
      * @brief This command stops the motor abruptly without respecting the deceleration limit and
      * sets the “Current position” variable, which represents what position the Tic currently thinks
@@ -329,6 +385,28 @@ public:
      */
     bool setCurrentLimit(uint16_t currentLimit);
 
+    /**
+     * @brief Applies the motion settings, clears the occurred errors, exits the safe start,
+     * energizes the motor and sets the target velocity within one bus transaction.
+     *
+     * @param settings Motion settings to apply.
+     * @param velocity Target velocity in microsteps per 10,000 s.
+     * @return true if succeeded
+     * @return false if failed
+     */
+    bool prepareAndRotate(const MotionSettings& settings, int32_t velocity);
+
+    /**
+     * @brief Applies the motion settings, clears the occurred errors, exits the safe start,
+     * energizes the motor and sets the target position within one bus transaction.
+     *
+     * @param settings Motion settings to apply.
+     * @param position Target position in microsteps.
+     * @return true if succeeded
+     * @return false if failed
+     */
+    bool prepareAndMoveTo(const MotionSettings& settings, int32_t position);
+
     /**
      * @brief Checks if an error condition occurred.
      *
@@ -338,7 +416,8 @@ public:
     bool checkError();
 
     /**
-     * @brief Requests the current state from the controller
+     * @brief Requests the current state from the controller.
+     * The whole variable region is read within one bus transaction, so all values are consistent.
      *
      * @param[out] state Current state
      * @return true if succeeded
@@ -346,6 +425,22 @@ public:
      */
     bool getState(State& state) const;
 
+    /**
+     * @brief Returns the last requested state if it is not older than the passed maximum age,
+     * otherwise the state is requested from the controller. Concurrent callers share one request.
+     *
+     * @param[out] state  Current state
+     * @param      maxAge Maximum age of the returned state.
+     * @return true if succeeded
+     * @return false if failed
+     */
+    bool getState(State& state, std::chrono::milliseconds maxAge) const;
+
+    /**
+     * @brief Marks the last requested state as outdated.
+     */
+    void invalidateState() const;
+
     /**
      * @brief Logs the passed state.
      *
@@ -376,13 +471,47 @@ public:
     bool getVariableAndClearErrors(Byte variableOff, ByteBuffer& receiveData) const;
 
 private:
-    bool runSimpleCommand(Byte commandId);
+    /// Shadow copy of the settings written to the controller, which are unset if unknown.
+    struct Settings
+    {
+        std::optional<StepMode> stepMode;
+        std::optional<uint32_t> maxSpeed;
+        std::optional<uint32_t> startingSpeed;
+        std::optional<uint32_t> maxAcceleration;
+        std::optional<uint32_t> maxDeceleration;
+        std::optional<uint16_t> currentLimit;
+    };
 
-    I2cControl::Address m_address;
-    I2cControl&         m_i2c;
-    IGpioPin&           m_ioErr;
-    IGpioPin&           m_ioRst;
-    const std::string   m_me;
+    bool runSimpleCommand(
+        Byte commandId, I2cControl::Batch::Priority priority = I2cControl::Batch::Priority::Normal);
+    bool writeCommand(const ByteBuffer& commandData,
+                      I2cControl::Batch::Priority priority = I2cControl::Batch::Priority::Normal);
+    bool prepareAndGo(const MotionSettings& settings, const ByteBuffer& motionCommand);
+    void invalidateSettings() const;
+    template <class ValueT>
+    bool writeSetting(std::optional<ValueT>& setting, ValueT value, const ByteBuffer& commandData);
+
+    bool readState(State& state) const;
+
+    /**
+     * @brief Checks the known settings against the settings read from the controller.
+     *
+     * @param state Controller state, which contains the current settings.
+     * @return true  If all known settings match the controller.
+     * @return false If any known setting differs from the controller.
+     */
+    bool isMatchingSettings(const State& state) const;
+
+    I2cControl::Address                      m_address;
+    I2cControl&                              m_i2c;
+    IGpioPin&                                m_ioErr;
+    IGpioPin&                                m_ioRst;
+    const std::string                        m_me;
+    mutable std::mutex                       m_stateMutex;     ///< Protects the cached state.
+    mutable State                            m_state;          ///< Last requested state.
+    mutable std::optional<Clock::time_point> m_stateTime;      ///< Time of the last state request.
+    mutable std::mutex                       m_settingsMutex;  ///< Protects the settings shadow.
+    mutable Settings                         m_settings;       ///< Settings shadow.
 };
 
 }  // namespace sugo::hal
\ No newline at end of file
@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+#include "Common/Ios.hpp"
+#include "Common/Logger.hpp"
+#include "HardwareAbstractionLayer/I2cBusArbiter.hpp"
+
+namespace
+{
+constexpr char Me[] = "I2cBusArbiter: ";
+}
+
+using namespace sugo::hal;
+
+I2cBusArbiter::~I2cBusArbiter()
+{
+    stop();
+}
+
+bool I2cBusArbiter::start()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isRunning)
+        {
+            return true;
+        }
+        m_isRunning = true;
+    }
+
+    if (!m_thread.start([this] { run(); }))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isRunning = false;
+        LOG(error) << Me << "Failed to start arbiter thread";
+        return false;
+    }
+
+    return true;
+}
+
+void I2cBusArbiter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_isRunning)
+        {
+            return;
+        }
+        m_isRunning = false;
+        m_requestCondition.notify_one();
+    }
+
+    if (m_thread.isRunning())
+    {
+        m_thread.join();
+    }
+
+    for (const auto& [address, statistics] : getStatistics())
+    {
+        LOG(info) << Me << "Device " << common::ios::hex(static_cast<uint32_t>(address))
+                  << ": transactions=" << statistics.transactions
+                  << ", commands=" << statistics.commands << ", replaced=" << statistics.replaced
+                  << ", failures=" << statistics.failures
+                  << ", waitTime=" << statistics.waitTime.count()
+                  << "us, maxWaitTime=" << statistics.maxWaitTime.count()
+                  << "us, busTime=" << statistics.busTime.count() << "us";
+    }
+}
+
+bool I2cBusArbiter::transfer(Batch& batch) const
+{
+    assert(!batch.empty());
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_isRunning)
+    {
+        lock.unlock();
+        return I2cControl::transfer(batch);
+    }
+
+    // A batch to several devices is queued for each of them.
+    Request request{batch, Clock::now(), batch.getAddresses()};
+    for (const Address address : request.addresses)
+    {
+        RequestQueue& queue = m_queues[address];
+        if (batch.isReplaceable() || (batch.getPriority() == Batch::Priority::High))
+        {
+            replace(queue);
+        }
+        queue.push_back(&request);
+    }
+    m_requestCondition.notify_one();
+    m_completionCondition.wait(lock, [&request] { return request.isDone; });
+    return request.success;
+}
+
+I2cBusArbiter::StatisticsMap I2cBusArbiter::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+void I2cBusArbiter::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_isRunning)
+    {
+        Request* request = selectRequest();
+        if (request == nullptr)
+        {
+            m_requestCondition.wait(lock);
+            continue;
+        }
+
+        // A started request is not replaceable anymore.
+        Batch& batch       = request->batch;
+        request->isStarted = true;
+
+        Statistics& statistics = m_statistics[batch.getAddress()];
+        const auto  startTime  = Clock::now();
+        const auto  waitTime =
+            std::chrono::duration_cast<std::chrono::microseconds>(startTime - request->queueTime);
+        statistics.waitTime += waitTime;
+        statistics.maxWaitTime = std::max(statistics.maxWaitTime, waitTime);
+
+        lock.unlock();
+        const bool success = I2cControl::transfer(batch);
+        lock.lock();
+
+        statistics.busTime +=
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime);
+        statistics.commands += batch.getCommandCount();
+        ++statistics.transactions;
+        statistics.failures += success ? 0 : 1;
+        dequeue(*request);
+        complete(*request, success);
+    }
+
+    for (auto& [address, queue] : m_queues)
+    {
+        for (Request* pending : queue)
+        {
+            complete(*pending, false);
+        }
+        queue.clear();
+    }
+}
+
+void I2cBusArbiter::replace(RequestQueue& queue) const
+{
+    std::vector<Request*> replaced;
+    std::copy_if(queue.begin(), queue.end(), std::back_inserter(replaced),
+                 [](const Request* request) {
+                     return request->batch.isReplaceable() && !request->isStarted;
+                 });
+    for (Request* request : replaced)
+    {
+        ++m_statistics[request->batch.getAddress()].replaced;
+        dequeue(*request);
+        complete(*request, true);
+    }
+}
+
+void I2cBusArbiter::dequeue(Request& request) const
+{
+    for (const Address address : request.addresses)
+    {
+        RequestQueue& queue = m_queues[address];
+        queue.erase(std::find(queue.begin(), queue.end(), &request));
+    }
+}
+
+bool I2cBusArbiter::isNext(const Request& request) const
+{
+    return std::all_of(request.addresses.begin(), request.addresses.end(),
+                       [this, &request](Address address) {
+                           return m_queues.at(address).front() == &request;
+                       });
+}
+
+I2cBusArbiter::Request* I2cBusArbiter::selectRequest()
+{
+    if (m_queues.empty())
+    {
+        return nullptr;
+    }
+
+    // Each device is served in FIFO order, so the priority applies only to the first request of
+    // each device. Devices are served round robin within the same priority, starting after the
+    // last one.
+    Request* selected = nullptr;
+    auto     queue    = m_queues.upper_bound(m_lastAddress);
+    for (size_t count = 0; count < m_queues.size(); ++count, ++queue)
+    {
+        if (queue == m_queues.end())
+        {
+            queue = m_queues.begin();
+        }
+        if (queue->second.empty())
+        {
+            continue;
+        }
+
+        // A batch to several devices has to be the next one of all these devices.
+        Request* candidate = queue->second.front();
+        if (!isNext(*candidate))
+        {
+            continue;
+        }
+
+        if ((selected == nullptr) ||
+            (candidate->batch.getPriority() > selected->batch.getPriority()))
+        {
+            selected = candidate;
+        }
+    }
+
+    if (selected != nullptr)
+    {
+        m_lastAddress = selected->batch.getAddress();
+    }
+    return selected;
+}
+
+void I2cBusArbiter::complete(Request& request, bool success) const
+{
+    request.success = success;
+    request.isDone  = true;
+    m_completionCondition.notify_all();
+}
@@ -29,8 +29,10 @@
 #include <stdio.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
+#include <algorithm>
+#include <cassert>
 #include <cerrno>
-#include <iomanip>
+#include <vector>
 
 #include "Common/Ios.hpp"
 #include "Common/Logger.hpp"
@@ -76,40 +78,99 @@ void I2cControl::finalize(void)
     }
 }
 
-bool I2cControl::read(Address address, const ByteBuffer& command, ByteBuffer& readBuffer) const
+bool I2cControl::read(Address address, const ByteBuffer& command, ByteBuffer& readBuffer,
+                      Batch::Priority priority) const
 {
-    ByteBuffer tmpCommand(command);
-    i2c_msg    messages[] = {
-        {address, 0, static_cast<uint16_t>(tmpCommand.size()), tmpCommand.data()},
-        {address, I2C_M_RD | I2C_M_STOP, static_cast<uint16_t>(readBuffer.size()),
-         readBuffer.data()},
-    };
-    i2c_rdwr_ioctl_data ioctl_data = {messages, 2};
-
-    const int retValue = ::ioctl(m_fd, I2C_RDWR, &ioctl_data);
-    if (retValue != 2)
+    Batch batch(address);
+    batch.read(command, readBuffer.size()).setPriority(priority);
+    if (!transfer(batch))
     {
-        LOG(error) << Me << "Failed to read from device address: "
-                   << sugo::common::ios::hex(static_cast<uint32_t>(address)) << " ("
-                   << std::strerror(errno) << ")";
         return false;
     }
+    readBuffer = batch.getResponse(0);
     return true;
 }
 
-bool I2cControl::write(Address address, const ByteBuffer& command) const
+bool I2cControl::write(Address address, const ByteBuffer& command,
+                       Batch::Priority priority) const
+{
+    Batch batch(address);
+    batch.write(command).setPriority(priority);
+    return transfer(batch);
+}
+
+bool I2cControl::transfer(Batch& batch) const
 {
-    ByteBuffer tmpCommand(command);
-    i2c_msg    message = {address, 0, static_cast<uint16_t>(tmpCommand.size()), tmpCommand.data()};
-    i2c_rdwr_ioctl_data ioctl_data = {&message, 1};
+    assert(!batch.empty());
+
+    if (batch.getMessageCount() > I2C_RDWR_IOCTL_MAX_MSGS)
+    {
+        LOG(error) << Me << "Too many messages in one transaction: " << batch.getMessageCount();
+        return false;
+    }
+
+    // Each command is terminated by a stop condition, like a separately sent command.
+    std::vector<i2c_msg> messages;
+    messages.reserve(batch.getMessageCount());
+    for (auto& command : batch.m_commands)
+    {
+        messages.push_back({command.address,
+                            static_cast<uint16_t>(command.isRead ? 0 : I2C_M_STOP),
+                            static_cast<uint16_t>(command.request.size()),
+                            reinterpret_cast<uint8_t*>(command.request.data())});
+        if (command.isRead)
+        {
+            messages.push_back({command.address, I2C_M_RD | I2C_M_STOP,
+                                static_cast<uint16_t>(command.response.size()),
+                                reinterpret_cast<uint8_t*>(command.response.data())});
+        }
+    }
 
-    const int retValue = ::ioctl(m_fd, I2C_RDWR, &ioctl_data);
-    if (retValue != 1)
+    if (!transfer(messages.data(), messages.size()))
     {
-        LOG(error) << Me << "Failed to write to device address: " << std::hex << std::setw(2)
-                   << std::setfill('0') << static_cast<uint32_t>(address) << " ("
+        LOG(error) << Me << "Failed to transfer to device address: "
+                   << sugo::common::ios::hex(static_cast<uint32_t>(batch.getAddress())) << " ("
                    << std::strerror(errno) << ")";
         return false;
     }
     return true;
 }
+
+bool I2cControl::transfer(i2c_msg* messages, size_t count) const
+{
+    i2c_rdwr_ioctl_data ioctl_data = {messages, static_cast<uint32_t>(count)};
+    const int           retValue   = ::ioctl(m_fd, I2C_RDWR, &ioctl_data);
+    return (retValue == static_cast<int>(count));
+}
+
+I2cControl::Batch& I2cControl::Batch::write(Address address, const ByteBuffer& command)
+{
+    m_commands.push_back({address, command, {}, false});
+    return *this;
+}
+
+I2cControl::Batch& I2cControl::Batch::read(const ByteBuffer& command, size_t responseSize)
+{
+    m_responseIndices.push_back(m_commands.size());
+    m_commands.push_back({m_address, command, ByteBuffer(responseSize), true});
+    return *this;
+}
+
+std::vector<I2cControl::Address> I2cControl::Batch::getAddresses() const
+{
+    std::vector<Address> addresses;
+    for (const auto& command : m_commands)
+    {
+        if (std::find(addresses.begin(), addresses.end(), command.address) == addresses.end())
+        {
+            addresses.push_back(command.address);
+        }
+    }
+    return addresses;
+}
+
+const ByteBuffer& I2cControl::Batch::getResponse(size_t index) const
+{
+    assert(index < m_responseIndices.size());
+    return m_commands[m_responseIndices[index]].response;
+}
@@ -22,43 +22,135 @@
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
-#include <thread>
+#include <numeric>
 
 #include "Common/IConfiguration.hpp"
 #include "Common/Logger.hpp"
 #include "HardwareAbstractionLayer/HalHelper.hpp"
 #include "HardwareAbstractionLayer/StepperMotor.hpp"
+#include "HardwareAbstractionLayer/StepperMotorGroup.hpp"
 #include "HardwareAbstractionLayer/TicController.hpp"
 
 namespace
 {
-constexpr int                                MicroStepsPerStep = 8;  ///< Step1_8
 constexpr sugo::hal::TicController::StepMode StepMode = sugo::hal::TicController::StepMode::Step1_8;
-constexpr int                                FullStepsPerRound = 200;
-constexpr int                       MicroStepsPerRound    = FullStepsPerRound * MicroStepsPerStep;
-constexpr int                       SecondsPerMinute      = 60u;
-constexpr unsigned                  MillisecondsPerMinute = SecondsPerMinute * 1000u;
-constexpr std::chrono::milliseconds MinWaitTime(2u);
-constexpr std::chrono::milliseconds MaxWaitTime(500u);
+/// Microsteps per full step, indexed by the step mode.
+constexpr std::array<int, 4> MicroStepsPerStepMode = {1, 2, 4, 8};
+constexpr int                MicroStepsPerStep     = MicroStepsPerStepMode[StepMode];
+constexpr int                FullStepsPerRound     = 200;
+constexpr int                MicroStepsPerRound    = FullStepsPerRound * MicroStepsPerStep;
+constexpr int64_t            SecondsPerMinute      = 60;
+constexpr int64_t            MillisecondsPerMinute = SecondsPerMinute * 1000;
+constexpr int64_t            VelocitySecondsScale  = 10000;  ///< Tic velocity per 10,000 s.
+constexpr std::chrono::milliseconds ObservationInterval(50u);  ///< Abort check while waiting.
+constexpr std::chrono::milliseconds PollWaitTime(20u);         ///< State polling after motion.
+constexpr std::chrono::milliseconds MaxStateAge(10u);          ///< Shared state reads for queries.
+constexpr unsigned MaxPendingErrorEvents = 16u;  ///< Bounds the discarding of former error events.
 constexpr uint16_t                  CurrentLimit = 1500u;
+/// Velocity (µsteps per 10000 s) by deceleration (µsteps per 100 s²) results in 10 ms units.
+constexpr unsigned MillisecondsPerDecelerationUnit = 10u;
 
-constexpr int rpmToMicrostepsPer10kSeconds(int speedRpm)
+/// Reduced ratio of Tic velocity (microsteps per 10,000 s) to milli-RPM.
+struct VelocityRatio
 {
-    return (speedRpm * MicroStepsPerRound * 10000) / SecondsPerMinute;
+    int64_t numerator   = 1;  ///< Velocity part
+    int64_t denominator = 1;  ///< Milli-RPM part
+};
+
+/// Returns the reduced velocity ratio for the passed microsteps per full step.
+constexpr VelocityRatio createVelocityRatio(int microStepsPerStep)
+{
+    const int64_t numerator   = FullStepsPerRound * microStepsPerStep * VelocitySecondsScale;
+    const int64_t denominator = SecondsPerMinute * sugo::hal::IStepperMotor::MilliRpmPerRpm;
+    const int64_t divisor     = std::gcd(numerator, denominator);
+    return {numerator / divisor, denominator / divisor};
+}
+
+/// Velocity ratios indexed by the step mode, reduced at compile time.
+constexpr std::array<VelocityRatio, MicroStepsPerStepMode.size()> VelocityRatios = {
+    createVelocityRatio(MicroStepsPerStepMode[0]), createVelocityRatio(MicroStepsPerStepMode[1]),
+    createVelocityRatio(MicroStepsPerStepMode[2]), createVelocityRatio(MicroStepsPerStepMode[3])};
+constexpr VelocityRatio VelocityPerMilliRpm = VelocityRatios[StepMode];
+
+/// Converts a speed in milli-RPM into microsteps per 10,000 s, rounded to the nearest value.
+constexpr int64_t milliRpmToMicrostepsPer10kSeconds(int64_t speedMilliRpm)
+{
+    return ((speedMilliRpm * VelocityPerMilliRpm.numerator) +
+            (VelocityPerMilliRpm.denominator / 2)) /
+           VelocityPerMilliRpm.denominator;
+}
+
+/// Converts microsteps per 10,000 s into a speed in milli-RPM, rounded to the nearest value.
+constexpr int64_t microstepsPer10kSecondsToMilliRpm(int64_t microstepsPer10kSeconds)
+{
+    return ((microstepsPer10kSeconds * VelocityPerMilliRpm.denominator) +
+            (VelocityPerMilliRpm.numerator / 2)) /
+           VelocityPerMilliRpm.numerator;
+}
+
+static_assert(VelocityPerMilliRpm.numerator == 800 && VelocityPerMilliRpm.denominator == 3,
+              "Unexpected velocity ratio for the 1/8 step mode");
+static_assert(microstepsPer10kSecondsToMilliRpm(milliRpmToMicrostepsPer10kSeconds(1)) == 1,
+              "Speed conversion has to keep the milli-RPM resolution");
+static_assert(milliRpmToMicrostepsPer10kSeconds(60 * sugo::hal::IStepperMotor::MilliRpmPerRpm) ==
+                  MicroStepsPerRound * VelocitySecondsScale,
+              "One round per second has to be exact");
+
+/// Discards the error line events of former motions or of the other controllers.
+void discardErrorEvents(sugo::hal::IGpioPin& ioErr)
+{
+    unsigned count = 0;
+    while ((count < MaxPendingErrorEvents) &&
+           (ioErr.waitForEvent(std::chrono::nanoseconds(0)).type !=
+            sugo::hal::IGpioPin::EventType::Timeout))
+    {
+        ++count;
+    }
 }
 
-constexpr int microstepsPer10kSecondsToRpm(int microstepsPer10kSeconds)
+/// Confirms an error line event by the error status of the controller, since the error line is
+/// shared by all controllers.
+bool isErrorConfirmed(const sugo::hal::TicController& controller)
 {
-    return (microstepsPer10kSeconds * SecondsPerMinute) / (MicroStepsPerRound * 10000);
+    sugo::hal::TicController::State state;
+    return !controller.getState(state) || state.hasError();
 }
 
 /// Calculate the minimum motion time depending on speed and distance (microsteps)!
-constexpr std::chrono::milliseconds calculateMotionTime(unsigned speedRpm, unsigned microsteps)
+constexpr std::chrono::milliseconds calculateMotionTime(unsigned speedMilliRpm,
+                                                        unsigned microsteps)
+{
+    const int64_t divider = static_cast<int64_t>(MicroStepsPerRound) * speedMilliRpm;
+    return std::chrono::milliseconds(
+        (static_cast<int64_t>(microsteps) * MillisecondsPerMinute *
+         sugo::hal::IStepperMotor::MilliRpmPerRpm) /
+        divider);
+}
+
+/// Returns the motion settings needed for a motion up to the passed maximum speed.
+sugo::hal::TicController::MotionSettings createMotionSettings(
+    sugo::hal::IStepperMotor::Speed maxSpeed)
+{
+    sugo::hal::TicController::MotionSettings settings;
+    settings.stepMode     = StepMode;
+    settings.maxSpeed     = static_cast<uint32_t>(milliRpmToMicrostepsPer10kSeconds(
+        sugo::hal::IStepperMotor::toMilliRpm(maxSpeed).getValue()));
+    settings.currentLimit = CurrentLimit;
+    return settings;
+}
+
+/// Returns the signed Tic velocity of the speed in the passed direction.
+int32_t toVelocity(sugo::hal::IStepperMotor::Speed     speed,
+                   sugo::hal::IStepperMotor::Direction direction)
 {
-    const unsigned divider = MicroStepsPerRound * speedRpm;
-    return std::chrono::milliseconds((microsteps * MillisecondsPerMinute) / divider);
+    const int64_t speedMicrosteps =
+        milliRpmToMicrostepsPer10kSeconds(sugo::hal::IStepperMotor::toMilliRpm(speed).getValue());
+    return static_cast<int32_t>(speedMicrosteps) *
+           ((direction == sugo::hal::IStepperMotor::Direction::Forward) ? 1 : -1);
 }
 }  // namespace
 
@@ -75,8 +167,8 @@ bool StepperMotor::init(const sugo::common::IConfiguration& configuration)
 
     const I2cControl::Address address =
         static_cast<I2cControl::Address>(configuration.getOption(id::I2cAddress).get<unsigned>());
-    m_maxSpeed =
-        StepperMotor::Speed(configuration.getOption(id::MaxSpeedRpm).get<unsigned>(), Unit::Rpm);
+    m_maxSpeed = toMilliRpm(
+        StepperMotor::Speed(configuration.getOption(id::MaxSpeedRpm).get<unsigned>(), Unit::Rpm));
     m_direction = (configuration.getOption(id::Direction).get<std::string>() == "backward")
                       ? IStepperMotor::Direction::Backward
                       : IStepperMotor::Direction::Forward;
@@ -92,13 +184,16 @@ bool StepperMotor::init(const sugo::common::IConfiguration& configuration)
         return false;
     }
 
+    m_motorGroup.add(*m_controller);
     return true;
 }
 
 void StepperMotor::finalize()
 {
+    stopMotionObservation();
     if (m_controller != nullptr)
     {
+        m_motorGroup.remove(*m_controller);
         delete m_controller;
         m_controller = nullptr;
     }
@@ -118,7 +213,7 @@ StepperMotor::Position StepperMotor::getPosition() const
     assert(m_controller != nullptr);
 
     TicController::State state;
-    if (!m_controller->getState(state))
+    if (!m_controller->getState(state, MaxStateAge))
     {
         LOG(error) << getId() << ": Failed to get current position";
         return 0;
@@ -145,38 +240,26 @@ bool StepperMotor::prepareForMotion()
         return false;
     }
 
-    // (Re-)configure the correct motor control settings
-    if (!m_controller->setStepMode(StepMode))
-    {
-        LOG(error) << getId() << ": Failed to set step mode";
-        finalize();
-        return false;
-    }
-
-    const unsigned maxSpeed =
-        static_cast<unsigned>(std::abs(rpmToMicrostepsPer10kSeconds(m_maxSpeed.getValue())));
+    return m_motorGroup.restore(*m_controller);
+}
 
-    if (!m_controller->setMaxSpeed(maxSpeed))
-    {
-        LOG(error) << getId() << ": Failed to set max speed (" << m_maxSpeed.getValue() << "/"
-                   << maxSpeed << ")";
-        return false;
-    }
+bool StepperMotor::startMotionToPosition(Position position, std::chrono::milliseconds& motionTime)
+{
+    assert(m_controller != nullptr);
 
-    if (!m_controller->setCurrentLimit(CurrentLimit))
+    stopMotionObservation();
+    if (!prepareForMotion())
     {
-        LOG(error) << getId() << ": Failed to set current limit to " << CurrentLimit << " mA";
         return false;
     }
 
-    // Clear occurred errors
-    ByteBuffer buf(2);
-    (void)m_controller->getVariableAndClearErrors(0x00, buf);
+    // Shares the state read while preparing.
+    const Position currentPosition = getPosition();
+    motionTime = calculateMotionTime(m_maxSpeed.getValue(), std::abs(currentPosition - position));
 
-    // Now exit the safe state and energize!
-    if (!m_controller->exitSafeStart() || !m_controller->energize())
+    if (!m_controller->prepareAndMoveTo(createMotionSettings(m_maxSpeed), position))
     {
-        LOG(error) << getId() << ": Failed to prepare motor";
+        LOG(error) << getId() << ": Failed to move to target position (" << position << ")";
         (void)stop(true);
         return false;
     }
@@ -184,121 +267,115 @@ bool StepperMotor::prepareForMotion()
     return true;
 }
 
-bool StepperMotor::rotateToPosition(Position position)
+bool StepperMotor::rotate(Direction direction)
 {
     assert(m_controller != nullptr);
 
+    stopMotionObservation();
     if (!prepareForMotion())
     {
         return false;
     }
 
-    const Position currentPosition = getPosition();
-    const auto     remainingMotionTime =
-        calculateMotionTime(m_maxSpeed.getValue(), std::abs(currentPosition - position));
+    m_direction            = direction;
+    const int32_t velocity = toVelocity(m_speed, m_direction);
+    LOG(debug) << getId() << ": Start rotation with target velocity " << velocity;
 
-    if (!m_controller->setTargetPosition(position))
+    if (!m_controller->prepareAndRotate(createMotionSettings(m_maxSpeed), velocity))
     {
-        LOG(error) << getId() << ": Failed to move to target position (" << position << ")";
+        LOG(error) << getId() << ": Failed to start rotation";
         (void)stop(true);
         return false;
     }
 
-    return waitAndShutdown(remainingMotionTime);
+    return true;
 }
 
-bool StepperMotor::rotate(Direction direction)
+bool StepperMotor::haltMotion(bool stopImmediately)
 {
     assert(m_controller != nullptr);
 
-    if (!prepareForMotion())
-    {
-        return false;
-    }
-
-    m_direction = direction;
-
-    if (!setSpeed(m_speed))
+    if (stopImmediately)
     {
-        return false;
+        const bool success = m_controller->haltAndHold();  // Stops abruptly!
+        (void)m_motorGroup.restore(*m_controller);
+        return success;
     }
 
-    return true;
+    // The motor has to stop with its nominal deceleration.
+    (void)m_motorGroup.restore(*m_controller);
+    return m_controller->setTargetVelocity(0);
 }
 
-bool StepperMotor::waitAndShutdown(std::chrono::milliseconds remainingMotionTime,
-                                   bool                      stopImmediately)
+std::chrono::milliseconds StepperMotor::getStopTime()
 {
     assert(m_controller != nullptr);
 
-    // FIXME Workaround to ensure that the current velocity is not zero!
+    // Ramp down time with the current deceleration.
     TicController::State state;
-    m_controller->getState(state);
+    if (!m_controller->getState(state) || (state.maxDeceleration == 0))
+    {
+        return std::chrono::milliseconds(0);
+    }
+    return std::chrono::milliseconds(
+        (static_cast<uint64_t>(std::abs(state.currentVelocity)) * MillisecondsPerDecelerationUnit) /
+        state.maxDeceleration);
+}
 
-    // Wait until motor reached target position!
-    bool errorOccurred = false;
+bool StepperMotor::waitForMotionTime(std::chrono::milliseconds motionTime)
+{
+    assert(m_controller != nullptr);
 
-    do
+    // Sleep for the computed motion time, but wake up as soon as the controller signals an error.
+    discardErrorEvents(m_ioErr);
+    const auto deadline = std::chrono::steady_clock::now() + motionTime;
+    while (isObserving())
     {
-        errorOccurred = (!m_controller->getState(state)) ||
-                        (state.operationState != TicController::OperationState::Normal);
-
-        if ((state.currentVelocity == 0) || errorOccurred)
+        const auto waitTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (waitTime.count() <= 0)
         {
             break;
         }
 
-        // Calculate wait time for polling
-        const auto startTime = std::chrono::high_resolution_clock::now();
-        const auto nextWaitTime =
-            (remainingMotionTime > MaxWaitTime) ? MaxWaitTime : remainingMotionTime;
-        std::this_thread::sleep_for(nextWaitTime);
-        const auto endTime = std::chrono::high_resolution_clock::now();
-        const auto elapsedTime =
-            std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-        remainingMotionTime = ((remainingMotionTime - elapsedTime) > MinWaitTime)
-                                  ? (remainingMotionTime - elapsedTime)
-                                  : MinWaitTime;
-    } while (!stopImmediately);
-
-    bool shutdownSuccess = m_controller->deEnergize();
-    shutdownSuccess      = m_controller->enterSafeStart() && shutdownSuccess;
-
-    if (errorOccurred)
-    {
-        m_controller->showState(state);
-        LOG(error) << getId() << ": Failed to wait for motion stop";
-        return false;
-    }
-
-    if (!shutdownSuccess)
-    {
-        LOG(error) << getId() << ": Failed to shutdown motor control";
-        return false;
+        if ((m_ioErr.waitForEvent(std::min(waitTime, ObservationInterval)).type ==
+             IGpioPin::EventType::RisingEdge) &&
+            isErrorConfirmed(*m_controller))
+        {
+            return false;
+        }
     }
 
     return true;
 }
 
-bool StepperMotor::stop(bool stopImmediately)
+StepperMotor::MotionState StepperMotor::getMotionState()
 {
-    bool success = true;
-    if (stopImmediately)
-    {
-        success = m_controller->haltAndHold();  // Stops abruptly!
-    }
-    else
-    {
-        success = m_controller->setTargetVelocity(0);
-    }
+    assert(m_controller != nullptr);
 
-    if (!success)
+    TicController::State state;
+    if (!m_controller->getState(state) ||
+        (state.operationState != TicController::OperationState::Normal) || state.hasError())
     {
-        LOG(error) << getId() << ": Failed to stop motor";
-        stopImmediately = true;  // We do not want to wait!
+        m_controller->showState(state);
+        return MotionState::Failed;
     }
 
-    return waitAndShutdown(std::chrono::milliseconds(0), stopImmediately);
+    return (state.currentVelocity == 0) ? MotionState::Stopped : MotionState::Moving;
+}
+
+void StepperMotor::waitForMotionState(bool /*isAsynchronous*/)
+{
+    // Error line events only wake up earlier, the next state read confirms them.
+    (void)m_ioErr.waitForEvent(PollWaitTime);
+}
+
+bool StepperMotor::shutdown()
+{
+    assert(m_controller != nullptr);
+
+    const bool success = m_controller->deEnergize();
+    return m_controller->enterSafeStart() && success;
 }
 
 StepperMotor::StepCount StepperMotor::getMicroStepCount() const
@@ -311,20 +388,60 @@ StepperMotor::StepCount StepperMotor::getStepsPerRound() const
     return MicroStepsPerRound;
 }
 
+bool StepperMotor::getTelemetry(Telemetry& telemetry) const
+{
+    assert(m_controller != nullptr);
+
+    TicController::State state;
+    if (!m_controller->getState(state, MaxStateAge))
+    {
+        LOG(error) << getId() << ": Failed to get telemetry";
+        return false;
+    }
+
+    const int32_t currentVelocity = state.currentVelocity;
+    const int64_t valueMilliRpm =
+        microstepsPer10kSecondsToMilliRpm(std::abs(static_cast<int64_t>(currentVelocity)));
+    telemetry.position    = state.currentPosition;
+    telemetry.velocity    = static_cast<int32_t>((currentVelocity < 0) ? -valueMilliRpm
+                                                                       : valueMilliRpm);
+    telemetry.errorFlags  = state.errorStatus;
+    telemetry.isEnergized = state.isEnergized();
+    return true;
+}
+
 StepperMotor::Speed StepperMotor::getSpeed() const
 {
     TicController::State state;
-    if (!m_controller->getState(state))
+    if (!m_controller->getState(state, MaxStateAge))
     {
         LOG(error) << getId() << ": Failed to get current velocity";
-        return Speed(0, Unit::Rpm);
+        return Speed(0, Unit::MilliRpm);
     }
-    const int valueRpm = microstepsPer10kSecondsToRpm(state.currentVelocity);
-    return Speed(valueRpm, Unit::Rpm);
+    const int32_t currentVelocity = state.currentVelocity;
+    const auto    valueMilliRpm =
+        microstepsPer10kSecondsToMilliRpm(std::abs(static_cast<int64_t>(currentVelocity)));
+    return Speed(static_cast<unsigned>(valueMilliRpm), Unit::MilliRpm);
 }
 
 bool StepperMotor::setSpeed(StepperMotor::Speed speed)
 {
+    return setSpeed(speed, false);
+}
+
+bool StepperMotor::setSpeedSynchronized(StepperMotor::Speed speed)
+{
+    return setSpeed(speed, true);
+}
+
+bool StepperMotor::cancelSpeedSynchronized()
+{
+    return m_motorGroup.cancel(*m_controller);
+}
+
+bool StepperMotor::setSpeed(StepperMotor::Speed speed, bool isSynchronized)
+{
+    speed = toMilliRpm(speed);
     if (speed.getValue() > m_maxSpeed.getValue())
     {
         LOG(error) << getId() << ": Set target speed (" << speed << ") exceeds max speed ("
@@ -332,13 +449,27 @@ bool StepperMotor::setSpeed(StepperMotor::Speed speed)
         return false;
     }
 
-    m_speed = speed;
-    const unsigned speedMicrosteps =
-        static_cast<unsigned>(std::abs(rpmToMicrostepsPer10kSeconds(speed.getValue())));
-    const int32_t velocity =
-        static_cast<int32_t>(speedMicrosteps) * ((m_direction == Direction::Forward) ? 1 : -1);
+    m_speed                = speed;
+    const int32_t velocity = toVelocity(speed, m_direction);
     LOG(debug) << getId() << ": Set target velocity to " << velocity;
 
+    if (isSynchronized)
+    {
+        if (!m_motorGroup.changeVelocity(*m_controller, velocity))
+        {
+            LOG(error) << getId() << ": Failed to change velocity synchronized";
+            return false;
+        }
+        return true;
+    }
+
+    // A trim of a held back speed change is applied together with the other motors.
+    if (m_motorGroup.updateHeldVelocity(*m_controller, velocity))
+    {
+        return true;
+    }
+
+    (void)m_motorGroup.restore(*m_controller);
     if (!m_controller->setTargetVelocity(velocity))
     {
         LOG(error) << getId() << ": Failed to set target velocity";
@@ -25,9 +25,10 @@
 #include <cassert>
 
 #include "HardwareAbstractionLayer/HalHelper.hpp"
-#include "HardwareAbstractionLayer/I2cControl.hpp"
+#include "HardwareAbstractionLayer/I2cBusArbiter.hpp"
 #include "HardwareAbstractionLayer/StepperMotor.hpp"
 #include "HardwareAbstractionLayer/StepperMotorControl.hpp"
+#include "HardwareAbstractionLayer/StepperMotorGroup.hpp"
 
 using namespace sugo::hal;
 
@@ -42,7 +43,7 @@ bool StepperMotorControl::init(const common::IConfiguration& configuration)
 
     auto deviceName = std::string("/dev/") + configuration.getOption("device").get<std::string>();
     LOG(debug) << getId() << ": Open device '" << deviceName << "'";
-    m_i2c = new I2cControl();
+    m_i2c = new I2cBusArbiter();
 
     if (!m_i2c->init(deviceName))
     {
@@ -51,14 +52,27 @@ bool StepperMotorControl::init(const common::IConfiguration& configuration)
         return false;
     }
 
+    // All motors share the bus, so their commands are passed through the arbiter.
+    if (!m_i2c->start())
+    {
+        LOG(error) << getId() << ": Failed to start I2C bus arbitration";
+        finalize();
+        return false;
+    }
+
+    m_motorGroup = new StepperMotorGroup(*m_i2c);
     return initEnabledSubComponents<IStepperMotor, StepperMotor>(
-        configuration, "motor", m_stepperMotorMap, *m_i2c, m_ioErr, m_ioRst);
+        configuration, "motor", m_stepperMotorMap, *m_i2c, *m_motorGroup, m_ioErr, m_ioRst);
 }
 
 void StepperMotorControl::finalize()
 {
+    delete m_motorGroup;
+    m_motorGroup = nullptr;
+
     if (m_i2c != nullptr)
     {
+        m_i2c->stop();
         delete m_i2c;
         m_i2c = nullptr;
     }
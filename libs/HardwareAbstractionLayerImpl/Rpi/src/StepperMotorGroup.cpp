@@ -0,0 +1,325 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+#include "Common/Logger.hpp"
+#include "HardwareAbstractionLayer/I2cControl.hpp"
+#include "HardwareAbstractionLayer/StepperMotorGroup.hpp"
+#include "HardwareAbstractionLayer/TicController.hpp"
+
+namespace
+{
+constexpr char     Me[]            = "StepperMotorGroup: ";
+constexpr uint32_t MinAcceleration = 100u;  ///< Tic minimum in microsteps per 100 s².
+/// A velocity change divided by an acceleration gives the ramp time in 1/100 s.
+constexpr double RampTimeUnitsPerSecond = 100.0;
+
+/// Returns the acceleration to finish the velocity change within the ramp time, which is limited
+/// by the nominal acceleration.
+uint32_t getSharedAcceleration(uint32_t velocityDelta, double rampTime, uint32_t nominal)
+{
+    if (rampTime <= 0.0)
+    {
+        return nominal;
+    }
+    return std::clamp(
+        static_cast<uint32_t>(std::ceil(static_cast<double>(velocityDelta) / rampTime)),
+        std::min(MinAcceleration, nominal), nominal);
+}
+}  // namespace
+
+using namespace sugo::hal;
+
+StepperMotorGroup::~StepperMotorGroup()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isRunning = false;
+        m_restoreCondition.notify_one();
+    }
+
+    if (m_restorer.isRunning())
+    {
+        m_restorer.join();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [controller, limits] : m_reducedLimits)
+    {
+        (void)restoreLimits(*controller, limits);
+    }
+    m_reducedLimits.clear();
+}
+
+void StepperMotorGroup::add(TicController& controller)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_members.insert(&controller);
+}
+
+void StepperMotorGroup::remove(TicController& controller)
+{
+    (void)restore(controller);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_members.erase(&controller);
+}
+
+bool StepperMotorGroup::changeVelocity(TicController& controller, int32_t velocity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    assert(m_members.count(&controller) != 0);
+
+    // Only the last velocity change of each motor counts.
+    auto change = std::find_if(
+        m_velocityChanges.begin(), m_velocityChanges.end(),
+        [&controller](const VelocityChange& item) { return item.controller == &controller; });
+    if (change == m_velocityChanges.end())
+    {
+        m_velocityChanges.push_back({&controller, velocity});
+    }
+    else
+    {
+        change->velocity = velocity;
+    }
+
+    if (m_velocityChanges.size() < m_members.size())
+    {
+        // The other motors have to follow within the hold timeout.
+        if (!m_holdDeadline.has_value())
+        {
+            m_holdDeadline = Clock::now() + m_holdTimeout;
+        }
+        return startRestorer();
+    }
+    return apply();
+}
+
+bool StepperMotorGroup::updateHeldVelocity(TicController& controller, int32_t velocity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto change = std::find_if(
+        m_velocityChanges.begin(), m_velocityChanges.end(),
+        [&controller](const VelocityChange& item) { return item.controller == &controller; });
+    if (change == m_velocityChanges.end())
+    {
+        return false;
+    }
+
+    change->velocity = velocity;
+    return true;
+}
+
+bool StepperMotorGroup::cancel(TicController& controller)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return cancelHeldChanges(controller);
+}
+
+bool StepperMotorGroup::cancelHeldChanges(TicController& controller)
+{
+    const bool isHeld = std::any_of(
+        m_velocityChanges.begin(), m_velocityChanges.end(),
+        [&controller](const VelocityChange& item) { return item.controller == &controller; });
+    if (!isHeld)
+    {
+        return false;
+    }
+
+    // Without the change of this motor, the other changes cannot be completed anymore.
+    LOG(warning) << Me << "Discarded " << m_velocityChanges.size()
+                 << " held back velocity changes";
+    m_velocityChanges.clear();
+    m_holdDeadline.reset();
+    return true;
+}
+
+bool StepperMotorGroup::restore(TicController& controller)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    (void)cancelHeldChanges(controller);
+
+    auto limits = m_reducedLimits.find(&controller);
+    if (limits == m_reducedLimits.end())
+    {
+        return true;
+    }
+
+    const bool success = restoreLimits(controller, limits->second);
+    m_reducedLimits.erase(limits);
+    return success;
+}
+
+bool StepperMotorGroup::apply()
+{
+    std::vector<VelocityChange> changes;
+    changes.swap(m_velocityChanges);
+    m_holdDeadline.reset();
+
+    // The motor with the longest ramp at its nominal acceleration sets the ramp time.
+    std::vector<Limits>   nominalLimits;
+    std::vector<uint32_t> velocityDeltas;
+    double                rampTime = 0.0;
+    for (const auto& change : changes)
+    {
+        TicController::State state;
+        if (!change.controller->getState(state))
+        {
+            LOG(error) << Me << "Failed to get motor state";
+            return false;
+        }
+
+        // Limits, which are still reduced by the former ramps, are known already. All others are
+        // read from the controller, since a reset reloads them from its non-volatile memory.
+        const auto reducedLimits = m_reducedLimits.find(change.controller);
+        nominalLimits.push_back((reducedLimits != m_reducedLimits.end())
+                                    ? reducedLimits->second
+                                    : Limits{state.maxAcceleration, state.maxDeceleration});
+
+        const int64_t currentVelocity = state.currentVelocity;
+        const bool    isAccelerating =
+            std::abs(static_cast<int64_t>(change.velocity)) > std::abs(currentVelocity);
+        const uint32_t nominalAcceleration = isAccelerating ? nominalLimits.back().maxAcceleration
+                                                            : nominalLimits.back().maxDeceleration;
+        velocityDeltas.push_back(static_cast<uint32_t>(
+            std::abs(static_cast<int64_t>(change.velocity) - currentVelocity)));
+        if (nominalAcceleration > 0)
+        {
+            rampTime = std::max(rampTime, static_cast<double>(velocityDeltas.back()) /
+                                              static_cast<double>(nominalAcceleration));
+        }
+    }
+
+    bool success = true;
+    for (size_t index = 0; index < changes.size(); ++index)
+    {
+        TicController& controller = *changes[index].controller;
+        const Limits&  nominal    = nominalLimits[index];
+        const Limits   shared{
+            getSharedAcceleration(velocityDeltas[index], rampTime, nominal.maxAcceleration),
+            getSharedAcceleration(velocityDeltas[index], rampTime, nominal.maxDeceleration)};
+        m_reducedLimits[&controller] = nominal;
+        success = controller.setMaxAcceleration(shared.maxAcceleration) && success;
+        success = controller.setMaxDeceleration(shared.maxDeceleration) && success;
+    }
+
+    if (!success)
+    {
+        LOG(error) << Me << "Failed to set shared acceleration profile";
+        return false;
+    }
+
+    // The commands are queued for each addressed device, so they keep their order per device.
+    I2cControl::Batch batch(changes.front().controller->getAddress());
+    for (const auto& change : changes)
+    {
+        change.controller->addTargetVelocity(batch, change.velocity);
+    }
+
+    const auto startTime = Clock::now();
+    if (!m_i2cControl.transfer(batch))
+    {
+        LOG(error) << Me << "Failed to change velocities";
+        return false;
+    }
+    m_lastSkew = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime);
+    LOG(debug) << Me << "Changed velocity of " << changes.size() << " motors with a skew of "
+               << m_lastSkew.count() << "us";
+
+    // The nominal limits are restored as soon as the ramps have been finished.
+    m_restoreTime = startTime + std::chrono::duration_cast<Clock::duration>(
+                                    std::chrono::duration<double>(rampTime /
+                                                                  RampTimeUnitsPerSecond));
+    return startRestorer();
+}
+
+bool StepperMotorGroup::restoreLimits(TicController& controller, const Limits& limits) const
+{
+    bool success = controller.setMaxAcceleration(limits.maxAcceleration);
+    success      = controller.setMaxDeceleration(limits.maxDeceleration) && success;
+    if (!success)
+    {
+        LOG(error) << Me << "Failed to restore nominal acceleration";
+    }
+    return success;
+}
+
+bool StepperMotorGroup::startRestorer()
+{
+    if (!m_isRunning)
+    {
+        m_isRunning = true;
+        if (!m_restorer.start([this] { runRestorer(); }))
+        {
+            m_isRunning = false;
+            LOG(error) << Me << "Failed to start restorer thread";
+            return false;
+        }
+    }
+    m_restoreCondition.notify_one();
+    return true;
+}
+
+void StepperMotorGroup::runRestorer()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_isRunning)
+    {
+        if (!m_restoreTime.has_value() && !m_holdDeadline.has_value())
+        {
+            m_restoreCondition.wait(lock);
+            continue;
+        }
+
+        const auto now = Clock::now();
+        if (m_holdDeadline.has_value() && (now >= *m_holdDeadline))
+        {
+            LOG(error) << Me << "Discarded " << m_velocityChanges.size()
+                       << " held back velocity changes, which were not completed in time";
+            m_velocityChanges.clear();
+            m_holdDeadline.reset();
+        }
+
+        if (m_restoreTime.has_value() && (now >= *m_restoreTime))
+        {
+            m_restoreTime.reset();
+            for (const auto& [controller, limits] : m_reducedLimits)
+            {
+                (void)restoreLimits(*controller, limits);
+            }
+            m_reducedLimits.clear();
+        }
+
+        if (m_restoreTime.has_value() || m_holdDeadline.has_value())
+        {
+            const auto deadline =
+                std::min(m_restoreTime.value_or(Clock::time_point::max()),
+                         m_holdDeadline.value_or(Clock::time_point::max()));
+            m_restoreCondition.wait_until(lock, deadline);
+        }
+    }
+}
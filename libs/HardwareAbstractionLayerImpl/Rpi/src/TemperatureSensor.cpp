@@ -23,6 +23,8 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <cassert>
+#include <chrono>
+#include <limits>
 
 #include "Common/Logger.hpp"
 #include "HardwareAbstractionLayer/Max31865.hpp"
@@ -30,6 +32,16 @@
 
 using namespace sugo::hal;
 
+namespace
+{
+/// Time of one conversion in auto mode.
+constexpr std::chrono::milliseconds ConversionTime(20);
+/// Max time to wait for a data-ready event.
+constexpr std::chrono::milliseconds MaxDataReadyWaitTime(5 * ConversionTime);
+/// Max age of a published sample, before it is treated as failure.
+constexpr std::chrono::milliseconds MaxSampleAge(10 * ConversionTime);
+}  // namespace
+
 TemperatureSensor::~TemperatureSensor()
 {
     finalize();
@@ -57,11 +69,45 @@ bool TemperatureSensor::init(const common::IConfiguration& configuration)
         return false;
     }
 
+    const std::string dataReady = configuration.getOption(id::DataReady).get<std::string>();
+    if (dataReady.empty())
+    {
+        LOG(debug) << getId() << ": no data-ready pin set, sensor needs to be polled";
+        return true;
+    }
+
+    LOG(debug) << getId() << ": data-ready set to " << dataReady;
+    const auto itPin = m_gpioPins.find(dataReady);
+    if ((itPin == m_gpioPins.end()) || !itPin->second ||
+        (itPin->second->getDirection() != IGpioPin::Direction::In))
+    {
+        LOG(error) << getId() << ": failed to get data-ready input pin";
+        finalize();
+        return false;
+    }
+
+    m_dataReadyPin = itPin->second;
+    m_doObserve    = true;
+    if (!m_dataReadyObserver.start([this] { observeDataReady(); }))
+    {
+        LOG(error) << getId() << ": failed to start data-ready observation";
+        finalize();
+        return false;
+    }
+
     return true;
 }
 
 void TemperatureSensor::finalize()
 {
+    if (m_dataReadyObserver.isRunning())
+    {
+        m_doObserve = false;
+        m_dataReadyObserver.join();
+    }
+    m_dataReadyPin.reset();
+    m_lastSampleTime = 0;
+
     if (m_driver != nullptr)
     {
         delete m_driver;
@@ -73,5 +119,77 @@ TemperatureSensor::Temperature TemperatureSensor::getTemperature() const
 {
     assert(m_driver != nullptr);
 
-    return Temperature(m_driver->getTemperature(), Unit::Celcius);
+    if (!m_dataReadyPin)
+    {
+        return Temperature(m_driver->getTemperature(), Unit::DeciCelcius);
+    }
+
+    // With a data-ready pin the latest published sample is up to date. The driver is only used by
+    // the data-ready observer, since the sensor must not be accessed concurrently.
+    const Clock::rep lastSampleTime = m_lastSampleTime.load();
+    if (lastSampleTime == 0)
+    {
+        LOG(warning) << getId() << ": no sample published yet";
+        return Temperature(std::numeric_limits<RawTemperature>::min(), Unit::DeciCelcius);
+    }
+
+    const Clock::duration sampleAge =
+        Clock::now().time_since_epoch() - Clock::duration(lastSampleTime);
+    if (sampleAge > MaxSampleAge)
+    {
+        LOG(error) << getId() << ": no new sample since "
+                   << std::chrono::duration_cast<std::chrono::milliseconds>(sampleAge).count()
+                   << "ms";
+        return Temperature(std::numeric_limits<RawTemperature>::min(), Unit::DeciCelcius);
+    }
+    return Temperature(m_lastSample.load(), Unit::DeciCelcius);
+}
+
+bool TemperatureSensor::registerSampleHandler(SampleHandler handler)
+{
+    if (!m_dataReadyPin)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sampleHandler = std::move(handler);
+    return true;
+}
+
+void TemperatureSensor::observeDataReady()
+{
+    while (m_doObserve)
+    {
+        const auto event = m_dataReadyPin->waitForEvent(MaxDataReadyWaitTime);
+
+        if (!m_doObserve)
+        {
+            break;
+        }
+
+        // The data-ready pin is configured active-low, so a rising edge signals a new conversion.
+        // If an edge has been missed, the pin stays active until the sample has been read out.
+        if ((event.type == IGpioPin::EventType::RisingEdge) ||
+            ((event.type == IGpioPin::EventType::Timeout) &&
+             (m_dataReadyPin->getState() == IGpioPin::State::High)))
+        {
+            publishSample();
+        }
+    }
+}
+
+void TemperatureSensor::publishSample()
+{
+    const Temperature sample(m_driver->getTemperature(), Unit::DeciCelcius);
+
+    // The sample is stored before its time, which marks it as valid.
+    m_lastSample     = sample.getValue();
+    m_lastSampleTime = Clock::now().time_since_epoch().count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_sampleHandler)
+    {
+        m_sampleHandler(sample);
+    }
 }
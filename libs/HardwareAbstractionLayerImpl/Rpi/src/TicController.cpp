@@ -27,6 +27,7 @@
 #include <chrono>
 #include <iomanip>
 #include <thread>
+#include <vector>
 
 #include "Common/Logger.hpp"
 #include "HardwareAbstractionLayer/HalTypes.hpp"
@@ -35,14 +36,66 @@
 namespace
 {
 constexpr size_t MaxBlockSize = 15u;  ///< Maximum size a read response at once!
+constexpr size_t StateBlockCount =
+    (sizeof(sugo::hal::TicController::State) + MaxBlockSize - 1u) / MaxBlockSize;
+
+constexpr uint16_t MaxCurrentLimit = 4480u;  ///< Tic249 limit in mA!
+
+/// Errors which are set while the motor is stopped, without any effect to the settings.
+constexpr uint16_t ExpectedErrors =
+    sugo::hal::TicController::ErrorStatus::IntentionallyDeEnergized |
+    sugo::hal::TicController::ErrorStatus::SafeStartViolation;
+
+// Command identifiers
+constexpr sugo::hal::Byte CommandSetTargetPosition         = 0xE0;
+constexpr sugo::hal::Byte CommandSetTargetVelocity         = 0xE3;
+constexpr sugo::hal::Byte CommandHaltAndSetPosition        = 0xEC;
+constexpr sugo::hal::Byte CommandHaltAndHold               = 0x89;
+constexpr sugo::hal::Byte CommandGoHome                    = 0x97;
+constexpr sugo::hal::Byte CommandResetCommandTimeout       = 0x8C;
+constexpr sugo::hal::Byte CommandDeEnergize                = 0x86;
+constexpr sugo::hal::Byte CommandEnergize                  = 0x85;
+constexpr sugo::hal::Byte CommandExitSafeStart             = 0x83;
+constexpr sugo::hal::Byte CommandEnterSafeStart            = 0x8F;
+constexpr sugo::hal::Byte CommandReset                     = 0xB0;
+constexpr sugo::hal::Byte CommandSetMaxSpeed               = 0xE6;
+constexpr sugo::hal::Byte CommandSetStartingSpeed          = 0xE5;
+constexpr sugo::hal::Byte CommandSetMaxAcceleration        = 0xEA;
+constexpr sugo::hal::Byte CommandSetMaxDeceleration        = 0xE9;
+constexpr sugo::hal::Byte CommandSetStepMode               = 0x94;
+constexpr sugo::hal::Byte CommandSetCurrentLimit           = 0x91;
+constexpr sugo::hal::Byte CommandGetVariable               = 0xA1;
+constexpr sugo::hal::Byte CommandGetVariableAndClearErrors = 0xA2;
+
+sugo::hal::ByteBuffer createQuickCommand(sugo::hal::Byte commandId)
+{
+    return sugo::hal::ByteBuffer{commandId};
+}
+
+sugo::hal::ByteBuffer create7BitCommand(sugo::hal::Byte commandId, sugo::hal::Byte value)
+{
+    return sugo::hal::ByteBuffer{commandId, value};
+}
+
+sugo::hal::ByteBuffer createBlockReadCommand(sugo::hal::Byte commandId, sugo::hal::Byte offset)
+{
+    return sugo::hal::ByteBuffer{commandId, offset};
+}
+
+template <class ValueT>
+sugo::hal::ByteBuffer create32BitCommand(sugo::hal::Byte commandId, ValueT value)
+{
+    const auto data = static_cast<uint32_t>(value);
+    return sugo::hal::ByteBuffer{commandId, static_cast<sugo::hal::Byte>(data >> 0 & 0xff),
+                                 static_cast<sugo::hal::Byte>(data >> 8 & 0xff),
+                                 static_cast<sugo::hal::Byte>(data >> 16 & 0xff),
+                                 static_cast<sugo::hal::Byte>(data >> 24 & 0xff)};
+}
 
-template <class ValueT = int32_t>
-constexpr void writeToBuffer(ValueT value, std::byteBuffer& buffer, unsigned offset)
+/// For Tic249 the limit is in units of 40mA!
+constexpr sugo::hal::Byte toCurrentLimitCode(uint16_t currentLimit)
 {
-    buffer[0 + offset] = static_cast<std::byte>(value >> 0 & 0xff);
-    buffer[1 + offset] = static_cast<std::byte>(value >> 8 & 0xff);
-    buffer[2 + offset] = static_cast<std::byte>(value >> 16 & 0xff);
-    buffer[3 + offset] = static_cast<std::byte>(value >> 24 & 0xff);
+    return static_cast<sugo::hal::Byte>(currentLimit / 40u);
 }
 
 const std::map<std::byte, std::string> s_operationStateName = {
@@ -153,166 +206,224 @@ void TicController::showState(const State& state) const
 
 bool TicController::setTargetPosition(int32_t position)
 {
-    static constexpr Byte commandId = 0xE0;
-    ByteBuffer            commandData{commandId, 0, 0, 0, 0};
-    writeToBuffer(position, commandData, sizeof(commandId));
-    bool success = m_i2c.write(m_address, commandData);
-
-    return success;
+    return writeCommand(create32BitCommand(CommandSetTargetPosition, position));
 }
 
 bool TicController::setTargetVelocity(int32_t velocity)
 {
-    static constexpr Byte commandId = 0xE3;
-    ByteBuffer            commandData{commandId, 0, 0, 0, 0};
-    writeToBuffer(velocity, commandData, sizeof(commandId));
-    bool success = m_i2c.write(m_address, commandData);
+    // A newer velocity supersedes a pending one and a stop is passed with priority.
+    I2cControl::Batch batch(m_address);
+    batch.write(create32BitCommand(CommandSetTargetVelocity, velocity))
+        .setPriority((velocity == 0) ? I2cControl::Batch::Priority::High
+                                     : I2cControl::Batch::Priority::Normal)
+        .setReplaceable(true);
+    invalidateState();
+    return m_i2c.transfer(batch);
+}
 
-    return success;
+void TicController::addTargetVelocity(I2cControl::Batch& batch, int32_t velocity) const
+{
+    invalidateState();
+    batch.write(m_address, create32BitCommand(CommandSetTargetVelocity, velocity));
 }
 
 bool TicController::haltAndSetPosition(int32_t position)
 {
-    static constexpr Byte commandId = 0xEC;
-    ByteBuffer            commandData{commandId, 0, 0, 0, 0};
-    writeToBuffer(position, commandData, sizeof(commandId));
-    bool success = m_i2c.write(m_address, commandData);
-
-    return success;
+    return writeCommand(create32BitCommand(CommandHaltAndSetPosition, position));
 }
 
 bool TicController::haltAndHold()
 {
-    static constexpr Byte commandId = 0x89;
-    return runSimpleCommand(commandId);
+    return runSimpleCommand(CommandHaltAndHold, I2cControl::Batch::Priority::High);
 }
 
 bool TicController::goHome(IStepperMotor::Direction direction)
 {
-    static constexpr Byte commandId = 0x97;
-    ByteBuffer            commandData{commandId, static_cast<Byte>(direction)};
-    const bool            success = m_i2c.write(m_address, commandData);
-    return success;
+    return writeCommand(create7BitCommand(CommandGoHome, static_cast<Byte>(direction)));
 }
 
 bool TicController::resetCommandTimeout()
 {
-    static constexpr Byte commandId = 0x8C;
-    return runSimpleCommand(commandId);
+    return runSimpleCommand(CommandResetCommandTimeout);
 }
 
 bool TicController::deEnergize()
 {
-    static constexpr Byte commandId = 0x86;
-    return runSimpleCommand(commandId);
+    return runSimpleCommand(CommandDeEnergize, I2cControl::Batch::Priority::High);
 }
 
 bool TicController::energize()
 {
-    static constexpr Byte commandId = 0x85;
-    return runSimpleCommand(commandId);
+    return runSimpleCommand(CommandEnergize);
 }
 
 bool TicController::exitSafeStart()
 {
-    static constexpr Byte commandId = 0x83;
-    return runSimpleCommand(commandId);
+    return runSimpleCommand(CommandExitSafeStart);
 }
 
 bool TicController::enterSafeStart()
 {
-    static constexpr Byte commandId = 0x8F;
-    return runSimpleCommand(commandId);
+    return runSimpleCommand(CommandEnterSafeStart);
 }
 
 bool TicController::reset()
 {
-    static constexpr Byte commandId = 0xB0;
-    return runSimpleCommand(commandId);
+    // Reloads all settings from the non-volatile memory.
+    invalidateSettings();
+    return runSimpleCommand(CommandReset);
 }
 
 bool TicController::setMaxSpeed(uint32_t maxSpeed)
 {
-    static constexpr Byte commandId = 0xE6;
-    ByteBuffer            commandData{commandId, 0, 0, 0, 0};
-    writeToBuffer(maxSpeed, commandData, sizeof(commandId));
-    bool success = m_i2c.write(m_address, commandData);
-    return success;
+    return writeSetting(m_settings.maxSpeed, maxSpeed,
+                        create32BitCommand(CommandSetMaxSpeed, maxSpeed));
 }
 
 bool TicController::setStartingSpeed(uint32_t maxStartingSpeed)
 {
-    static constexpr Byte commandId = 0xE5;
-    ByteBuffer            commandData{commandId, 0, 0, 0, 0};
-    writeToBuffer(maxStartingSpeed, commandData, sizeof(commandId));
-    bool success = m_i2c.write(m_address, commandData);
-    return success;
+    return writeSetting(m_settings.startingSpeed, maxStartingSpeed,
+                        create32BitCommand(CommandSetStartingSpeed, maxStartingSpeed));
 }
 
 bool TicController::setMaxAcceleration(uint32_t maxAccel)
 {
-    static constexpr Byte commandId = 0xEA;
-    ByteBuffer            commandData{commandId, 0, 0, 0, 0};
-    writeToBuffer(maxAccel, commandData, sizeof(commandId));
-    bool success = m_i2c.write(m_address, commandData);
-    return success;
+    return writeSetting(m_settings.maxAcceleration, maxAccel,
+                        create32BitCommand(CommandSetMaxAcceleration, maxAccel));
 }
 
 bool TicController::setMaxDeceleration(uint32_t maxDecel)
 {
-    static constexpr Byte commandId = 0xE9;
-    ByteBuffer            commandData{commandId, 0, 0, 0, 0};
-    writeToBuffer(maxDecel, commandData, sizeof(commandId));
-    bool success = m_i2c.write(m_address, commandData);
-    return success;
+    return writeSetting(m_settings.maxDeceleration, maxDecel,
+                        create32BitCommand(CommandSetMaxDeceleration, maxDecel));
 }
 
 bool TicController::setStepMode(StepMode stepMode)
 {
-    static constexpr Byte commandId = 0x94;
-    ByteBuffer            commandData{commandId, static_cast<Byte>(stepMode)};
-    const bool            success = m_i2c.write(m_address, commandData);
-    return success;
+    return writeSetting(m_settings.stepMode, stepMode,
+                        create7BitCommand(CommandSetStepMode, static_cast<Byte>(stepMode)));
 }
 
 bool TicController::setCurrentLimit(uint16_t currentLimit)
 {
-    if (currentLimit > 4480u)  // Tic249 limit!
+    if (currentLimit > MaxCurrentLimit)
     {
         LOG(error) << m_me << "Current limit set to high";
         return false;
     }
-    static constexpr Byte commandId = 0x91;
-    // For Tic249 the limit is in units of 40mA!
-    Byte       value = static_cast<Byte>(currentLimit / 40u);
-    ByteBuffer commandData{commandId, value};
-    const bool success = m_i2c.write(m_address, commandData);
-    return success;
+    return writeSetting(
+        m_settings.currentLimit, currentLimit,
+        create7BitCommand(CommandSetCurrentLimit, toCurrentLimitCode(currentLimit)));
+}
+
+bool TicController::prepareAndRotate(const MotionSettings& settings, int32_t velocity)
+{
+    return prepareAndGo(settings, create32BitCommand(CommandSetTargetVelocity, velocity));
+}
+
+bool TicController::prepareAndMoveTo(const MotionSettings& settings, int32_t position)
+{
+    return prepareAndGo(settings, create32BitCommand(CommandSetTargetPosition, position));
+}
+
+bool TicController::prepareAndGo(const MotionSettings& settings, const ByteBuffer& motionCommand)
+{
+    if (settings.currentLimit > MaxCurrentLimit)
+    {
+        LOG(error) << m_me << "Current limit set to high";
+        return false;
+    }
+
+    // Changed settings, error clearing, energizing and the motion start are sent at once.
+    I2cControl::Batch batch(m_address);
+    {
+        std::lock_guard<std::mutex> lock(m_settingsMutex);
+        if (m_settings.stepMode != settings.stepMode)
+        {
+            batch.write(
+                create7BitCommand(CommandSetStepMode, static_cast<Byte>(settings.stepMode)));
+        }
+        if (m_settings.maxSpeed != settings.maxSpeed)
+        {
+            batch.write(create32BitCommand(CommandSetMaxSpeed, settings.maxSpeed));
+        }
+        if (m_settings.currentLimit != settings.currentLimit)
+        {
+            batch.write(create7BitCommand(CommandSetCurrentLimit,
+                                          toCurrentLimitCode(settings.currentLimit)));
+        }
+    }
+    batch.read(createBlockReadCommand(CommandGetVariableAndClearErrors, 0x00), sizeof(uint16_t))
+        .write(createQuickCommand(CommandExitSafeStart))
+        .write(createQuickCommand(CommandEnergize))
+        .write(motionCommand);
+
+    invalidateState();
+    if (!m_i2c.transfer(batch))
+    {
+        LOG(error) << m_me << "Failed to prepare and start motion";
+        invalidateSettings();
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_settingsMutex);
+    m_settings.stepMode     = settings.stepMode;
+    m_settings.maxSpeed     = settings.maxSpeed;
+    m_settings.currentLimit = settings.currentLimit;
+    return true;
 }
 
 bool TicController::getVariable(Byte variableOff, ByteBuffer& receiveData) const
 {
-    static constexpr Byte commandId = 0xA1;
-    ByteBuffer            commandData{commandId, variableOff};
-    const bool            success = m_i2c.read(m_address, commandData, receiveData);
-    return success;
+    return m_i2c.read(m_address, createBlockReadCommand(CommandGetVariable, variableOff),
+                      receiveData, I2cControl::Batch::Priority::Low);
 }
 
 bool TicController::getVariableAndClearErrors(Byte variableOff, ByteBuffer& receiveData) const
 {
-    static constexpr Byte commandId = 0xA2;
-    ByteBuffer            commandData{commandId, variableOff};
-    const bool            success = m_i2c.read(m_address, commandData, receiveData);
-    return success;
+    invalidateState();  // Clears the occurred errors!
+    return m_i2c.read(m_address,
+                      createBlockReadCommand(CommandGetVariableAndClearErrors, variableOff),
+                      receiveData);
+}
+
+bool TicController::runSimpleCommand(Byte commandId, I2cControl::Batch::Priority priority)
+{
+    return writeCommand(createQuickCommand(commandId), priority);
 }
 
-bool TicController::runSimpleCommand(Byte commandId)
+bool TicController::writeCommand(const ByteBuffer&           commandData,
+                                 I2cControl::Batch::Priority priority)
 {
-    ByteBuffer commandData{commandId};
-    const bool success = m_i2c.write(m_address, commandData);
+    // Any command could change the controller state.
+    invalidateState();
+    return m_i2c.write(m_address, commandData, priority);
+}
+
+template <class ValueT>
+bool TicController::writeSetting(std::optional<ValueT>& setting, ValueT value,
+                                 const ByteBuffer& commandData)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_settingsMutex);
+        if (setting == value)
+        {
+            return true;  // Already set!
+        }
+    }
+
+    const bool                  success = writeCommand(commandData);
+    std::lock_guard<std::mutex> lock(m_settingsMutex);
+    setting = success ? std::optional<ValueT>(value) : std::nullopt;
     return success;
 }
 
+void TicController::invalidateSettings() const
+{
+    std::lock_guard<std::mutex> lock(m_settingsMutex);
+    m_settings = Settings{};
+}
+
 bool TicController::checkError()
 {
     bool errorState = false;
@@ -365,6 +476,7 @@ bool TicController::checkError()
         else
         {
             errors = "UNKNOWN";
+            invalidateSettings();
         }
 
         if (errorState)
@@ -378,22 +490,75 @@ bool TicController::checkError()
 
 bool TicController::getState(TicController::State& state) const
 {
-    assert(sizeof(TicController::State) < 256u);
-    size_t remainingBytes = sizeof(State);
-    size_t offset         = 0;  // Operation state offset!
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    return readState(state);
+}
+
+bool TicController::getState(TicController::State& state, std::chrono::milliseconds maxAge) const
+{
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    if (m_stateTime.has_value() && ((Clock::now() - m_stateTime.value()) <= maxAge))
+    {
+        state = m_state;
+        return true;
+    }
+    return readState(state);
+}
+
+void TicController::invalidateState() const
+{
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_stateTime.reset();
+}
 
-    while (remainingBytes > 0)
+bool TicController::readState(TicController::State& state) const
+{
+    static_assert(sizeof(TicController::State) < 256u);
+
+    // The controller responds with one block per command, but all blocks are requested within
+    // the same transaction, so the state is consistent. As a status request, a pending stop
+    // command to another device is transferred first, if the bus is arbitrated.
+    I2cControl::Batch batch(m_address);
+    batch.setPriority(I2cControl::Batch::Priority::Low);
+    for (size_t offset = 0; offset < sizeof(State); offset += MaxBlockSize)
     {
-        const size_t nextBytes = (remainingBytes > MaxBlockSize) ? MaxBlockSize : remainingBytes;
-        ByteBuffer   buffer(nextBytes, static_cast<Byte>(0xff));
-        if (!getVariable(static_cast<Byte>(offset), buffer))
-        {
-            return false;
-        }
-        std::copy(buffer.begin(), buffer.end(), reinterpret_cast<Byte*>(&state) + offset);
-        remainingBytes -= nextBytes;
-        offset += nextBytes;
+        batch.read(createBlockReadCommand(CommandGetVariable, static_cast<Byte>(offset)),
+                   std::min(sizeof(State) - offset, MaxBlockSize));
     }
 
+    if (!m_i2c.transfer(batch))
+    {
+        m_stateTime.reset();
+        return false;
+    }
+
+    Byte* data = reinterpret_cast<Byte*>(&m_state);
+    for (size_t index = 0; index < StateBlockCount; ++index)
+    {
+        const ByteBuffer& block = batch.getResponse(index);
+        data                    = std::copy(block.begin(), block.end(), data);
+    }
+    m_stateTime = Clock::now();
+    state       = m_state;
+
+    // A restarted controller or an unexpected error could have discarded the written settings.
+    if ((m_state.operationState == OperationState::Reset) ||
+        ((m_state.errorStatus & ~ExpectedErrors) != 0) || !isMatchingSettings(m_state))
+    {
+        invalidateSettings();
+    }
     return true;
 }
+
+bool TicController::isMatchingSettings(const State& state) const
+{
+    const auto isMatching = [](const std::optional<uint32_t>& setting, uint32_t value) {
+        return !setting.has_value() || (setting.value() == value);
+    };
+
+    std::lock_guard<std::mutex> lock(m_settingsMutex);
+    return isMatching(m_settings.maxSpeed, state.maxSpeed) &&
+           isMatching(m_settings.startingSpeed, state.startingSpeed) &&
+           isMatching(m_settings.maxAcceleration, state.maxAcceleration) &&
+           isMatching(m_settings.maxDeceleration, state.maxDeceleration);
+}
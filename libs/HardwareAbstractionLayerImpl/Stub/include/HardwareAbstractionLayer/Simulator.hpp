@@ -27,8 +27,12 @@
 #include "Common/IRunnable.hpp"
 #include "HardwareAbstractionLayer/IGpioPin.hpp"
 #include "HardwareAbstractionLayer/ITemperatureSensor.hpp"
+#include "HardwareAbstractionLayer/StepperModel.hpp"
+#include "HardwareAbstractionLayer/ThermalModel.hpp"
 
 #include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <optional>
@@ -38,6 +42,11 @@ namespace sugo::hal
 /**
  * @brief Class to simulate the hardware behaviour
  *
+ * The temperature of each heater is simulated by a thermal model, which is driven by the heater
+ * relay. Each stepper motor is simulated by its own stepper model. The simulation runs in real
+ * time by default. With the simulated time enabled, the time only advances on request, so
+ * closed-loop runs are deterministic and faster than real time.
+ *
  * @note Implements the singleton pattern
  */
 class Simulator : public common::IRunnable
@@ -64,15 +73,98 @@ public:
 
     void                            registerTemperatureSensor(const Identifier& id);
     void                            unregisterTemperatureSensor(const Identifier& id);
-    ITemperatureSensor::Temperature getTemperature(const Identifier& id) const;
+    ITemperatureSensor::Temperature getTemperature(const Identifier& id);
+
+    /**
+     * @brief Replaces the thermal model of a registered temperature sensor. The new model starts
+     * at ambient temperature with the heater switched off.
+     *
+     * @param id         Temperature sensor identifier.
+     * @param parameters Thermal model parameters.
+     * @return true      If the temperature sensor is registered.
+     * @return false     If the temperature sensor is not registered.
+     */
+    bool setThermalModel(const Identifier& id, const ThermalModel::Parameters& parameters);
+
+    void registerStepperMotor(const Identifier& id);
+    void unregisterStepperMotor(const Identifier& id);
+
+    /**
+     * @brief Replaces the stepper model of a registered stepper motor. The new model starts at
+     * standstill in position zero.
+     *
+     * @param id         Stepper motor identifier.
+     * @param parameters Stepper model parameters.
+     * @return true      If the stepper motor is registered.
+     * @return false     If the stepper motor is not registered.
+     */
+    bool setStepperModel(const Identifier& id, const StepperModel::Parameters& parameters);
+
+    /**
+     * @brief Passes a command to the stepper model, which is advanced to the current time before.
+     *
+     * @param id      Stepper motor identifier.
+     * @param command Command to be applied on the stepper model.
+     * @return true   If the stepper motor is registered.
+     * @return false  If the stepper motor is not registered.
+     */
+    bool controlStepperMotor(const Identifier&                         id,
+                             const std::function<void(StepperModel&)>& command);
+
+    /**
+     * @brief Injects errors into a stepper motor, which stop it abruptly until it is reset.
+     *
+     * @param id         Stepper motor identifier.
+     * @param errorFlags Error flags to be set.
+     * @return true      If the stepper motor is registered.
+     * @return false     If the stepper motor is not registered.
+     */
+    bool injectStepperMotorError(const Identifier& id, uint32_t errorFlags);
+
+    /**
+     * @brief Returns the state of a registered stepper motor at the current time.
+     *
+     * @param id Stepper motor identifier.
+     * @return The stepper motor state.
+     */
+    StepperModel::State getStepperMotorState(const Identifier& id);
+
+    /**
+     * @brief Switches between real time and simulated time.
+     *
+     * @param enable Indicates if the simulated time should be used.
+     */
+    void enableSimulatedTime(bool enable);
+
+    /**
+     * @brief Advances the simulated time.
+     *
+     * @param duration Time to advance.
+     * @return true    If the simulated time is enabled.
+     * @return false   If the simulated time is not enabled.
+     */
+    bool advanceTime(Clock::duration duration);
+
+    /**
+     * @brief Waits for a duration of the simulation time. With the simulated time enabled, the
+     * caller either advances the time itself or waits until the time has been advanced by others.
+     * The latter is bounded by the duration in real time, so the caller could check for an abort.
+     *
+     * @param duration    Time to wait.
+     * @param advanceTime Indicates if the simulated time should be advanced by the caller.
+     */
+    void sleepFor(Clock::duration duration, bool advanceTime = false);
+
+    /**
+     * @brief Returns the current simulation time.
+     *
+     * @return The simulated time if enabled, otherwise the real time.
+     */
+    Clock::time_point now() const;
 
 private:
     Simulator() = default;
 
-    static constexpr ITemperatureSensor::RawTemperature KelvinPerSecond    = 20;
-    static constexpr ITemperatureSensor::RawTemperature MaxTemperature     = 220;
-    static constexpr ITemperatureSensor::RawTemperature DefaultTemperature = 25;
-
     struct GpioPin
     {
         IGpioPin::State     m_state     = IGpioPin::State::Low;
@@ -85,22 +177,36 @@ private:
 
     struct TemperatureSensor
     {
-        bool                                       m_heatingUp = false;
-        mutable Clock::time_point                  m_lastTemperatureChange;
-        mutable ITemperatureSensor::RawTemperature m_curentTemperature = DefaultTemperature;
+        ThermalModel      m_model;
+        Clock::time_point m_lastUpdate;
 
-        ITemperatureSensor::Temperature getTemperature() const;
+        void update(Clock::time_point now);
+    };
+
+    struct StepperMotor
+    {
+        StepperModel      m_model;
+        Clock::time_point m_lastUpdate;
+
+        void update(Clock::time_point now);
     };
 
     void switchHeater(const Identifier& heaterTemperatureSensorId, IGpioPin::State state);
 
+    Clock::time_point getTime() const;
+
     using PinMap  = std::map<Identifier, GpioPin>;
     PinMap m_pins = {};
 
     using TemperatureSensorMap                = std::map<Identifier, TemperatureSensor>;
     TemperatureSensorMap m_temperatureSensors = {};
 
+    using StepperMotorMap           = std::map<Identifier, StepperMotor>;
+    StepperMotorMap m_stepperMotors = {};
+
     std::optional<Clock::time_point> m_startTime;
-    std::mutex                       m_mutex;
+    std::optional<Clock::time_point> m_simulatedTime;
+    mutable std::mutex               m_mutex;
+    std::condition_variable          m_timeAdvanced;
 };
 }  // namespace sugo::hal
\ No newline at end of file
@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace sugo::hal
+{
+/**
+ * @brief Class simulates a stepper motor driven by a Tic controller.
+ * Like the controller, the velocity is changed at a fixed control period within the acceleration
+ * and deceleration limits, either towards a target velocity or along a trapezoidal profile
+ * towards a target position. The position is integrated exactly within each control period, so
+ * the model could be advanced by any time step. Any error stops the motor abruptly and keeps it
+ * de-energized until the errors are cleared.
+ */
+class StepperModel
+{
+public:
+    /// @brief Model time duration type in seconds.
+    using Duration = std::chrono::duration<double>;
+
+    /// @brief Model parameters.
+    struct Parameters
+    {
+        double stepsPerRound = 1600.0;  ///< Microsteps per round, which is the position unit.
+        double acceleration  = 120.0;   ///< Max acceleration in RPM/s.
+        double deceleration  = 120.0;   ///< Max deceleration in RPM/s.
+        double currentLimit  = 1.5;     ///< Coil current limit of the controller in A.
+        double cornerSpeed   = 60.0;    ///< Speed in RPM above which back-EMF limits the current.
+    };
+
+    /// @brief Simulated state of the motor.
+    struct State
+    {
+        double   position    = 0.0;    ///< Position in microsteps.
+        double   velocity    = 0.0;    ///< Signed velocity in RPM.
+        double   current     = 0.0;    ///< Coil current in A.
+        uint32_t errorFlags  = 0;      ///< Pending error flags.
+        bool     isEnergized = false;  ///< Indicates if the coils are energized.
+        bool     isMoving    = false;  ///< Indicates if the motion is not finished yet.
+    };
+
+    /// Control period of the controller, at which the velocity is updated.
+    static constexpr Duration ControlPeriod{0.001};
+
+    /// @brief Constructs a new stepper model object with default parameters.
+    StepperModel();
+
+    /**
+     * @brief Constructs a new stepper model object at standstill.
+     *
+     * @param parameters Model parameters.
+     */
+    explicit StepperModel(const Parameters& parameters);
+
+    /**
+     * @brief Energizes the motor coils.
+     *
+     * @return true  If the motor could be energized.
+     * @return false If errors are pending.
+     */
+    bool energize();
+
+    /// @brief De-energizes the motor coils, so the motor stops abruptly.
+    void deEnergize();
+
+    /**
+     * @brief Rotates the motor with the target velocity.
+     *
+     * @param velocity Signed target velocity in RPM.
+     */
+    void setTargetVelocity(double velocity);
+
+    /**
+     * @brief Moves the motor to the target position.
+     *
+     * @param position Target position in microsteps.
+     * @param maxSpeed Max speed of the motion in RPM.
+     */
+    void setTargetPosition(double position, double maxSpeed);
+
+    /**
+     * @brief Stops the motor.
+     *
+     * @param stopImmediately Indicates if the motor stops abruptly instead of ramping down.
+     */
+    void stop(bool stopImmediately);
+
+    /**
+     * @brief Injects errors, which stop the motor abruptly.
+     *
+     * @param errorFlags Error flags to be set.
+     */
+    void injectError(uint32_t errorFlags);
+
+    /// @brief Clears all pending errors.
+    void clearErrors()
+    {
+        m_errorFlags = 0;
+    }
+
+    /**
+     * @brief Advances the model time.
+     *
+     * @param duration Time to advance.
+     */
+    void advance(Duration duration);
+
+    /**
+     * @brief Returns the current state of the motor.
+     *
+     * @return The current state.
+     */
+    State getState() const;
+
+    /**
+     * @brief Returns the model parameters.
+     *
+     * @return The model parameters.
+     */
+    const Parameters& getParameters() const
+    {
+        return m_parameters;
+    }
+
+private:
+    /// @brief Motion mode of the controller.
+    enum class Mode
+    {
+        Velocity,
+        Position
+    };
+
+    /**
+     * @brief Updates the velocity and integrates the position over one control period.
+     *
+     * @param duration Control period in s.
+     */
+    void control(double duration);
+
+    /**
+     * @brief Returns the velocity to be approached within the next control period.
+     *
+     * @return Signed velocity in RPM.
+     */
+    double getControlVelocity() const;
+
+    /**
+     * @brief Returns the coil current at the current velocity.
+     *
+     * @return Current in A.
+     */
+    double getCurrent() const;
+
+    Parameters m_parameters;                       ///< Model parameters.
+    Mode       m_mode           = Mode::Velocity;  ///< Current motion mode.
+    double     m_position       = 0.0;             ///< Position in microsteps.
+    double     m_velocity       = 0.0;             ///< Signed velocity in RPM.
+    double     m_targetVelocity = 0.0;             ///< Target velocity in RPM.
+    double     m_targetPosition = 0.0;             ///< Target position in microsteps.
+    double     m_maxSpeed       = 0.0;             ///< Max speed of the position motion in RPM.
+    double     m_pendingTime    = 0.0;             ///< Time in s not advanced yet.
+    uint32_t   m_errorFlags     = 0;               ///< Pending error flags.
+    bool       m_isEnergized    = false;           ///< Energized indication.
+};
+}  // namespace sugo::hal
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <random>
+
+namespace sugo::hal
+{
+/**
+ * @brief Class simulates the temperature of a heater as first order plus dead time process.
+ * The heater power takes effect after the dead time and the temperature approaches the ambient
+ * temperature plus the power dependent gain with the time constant. Between power changes the
+ * exact exponential solution is used, so the model could be advanced by any time step.
+ */
+class ThermalModel
+{
+public:
+    /// @brief Model time duration type in seconds.
+    using Duration = std::chrono::duration<double>;
+
+    /// @brief Model parameters.
+    struct Parameters
+    {
+        double ambientTemperature = 25.0;   ///< Ambient temperature in °C.
+        double heaterGain         = 250.0;  ///< Temperature rise at full heater power in K.
+        double timeConstant       = 60.0;   ///< Time constant in s.
+        double deadTime           = 2.0;    ///< Delay of heater power changes in s.
+        double sensorNoise        = 0.1;    ///< Standard deviation of the sensor noise in K.
+    };
+
+    /// Default seed of the sensor noise, which makes simulation runs reproducible.
+    static constexpr unsigned DefaultSeed = 42;
+
+    /// @brief Constructs a new thermal model object with default parameters.
+    ThermalModel();
+
+    /**
+     * @brief Constructs a new thermal model object at ambient temperature.
+     *
+     * @param parameters Model parameters.
+     * @param seed       Seed of the sensor noise.
+     */
+    explicit ThermalModel(const Parameters& parameters, unsigned seed = DefaultSeed);
+
+    /**
+     * @brief Sets the heater power, which takes effect after the dead time.
+     *
+     * @param power Relative heater power from 0 (off) to 1 (full power).
+     */
+    void setHeaterPower(double power);
+
+    /**
+     * @brief Advances the model time.
+     *
+     * @param duration Time to advance.
+     */
+    void advance(Duration duration);
+
+    /**
+     * @brief Returns the real temperature of the heater.
+     *
+     * @return Temperature in °C.
+     */
+    double getTemperature() const
+    {
+        return m_temperature;
+    }
+
+    /**
+     * @brief Returns a temperature measurement including the sensor noise.
+     *
+     * @return Measured temperature in °C.
+     */
+    double measureTemperature();
+
+    /**
+     * @brief Returns the model parameters.
+     *
+     * @return The model parameters.
+     */
+    const Parameters& getParameters() const
+    {
+        return m_parameters;
+    }
+
+private:
+    /// @brief Pending heater power change.
+    struct PowerChange
+    {
+        double time  = 0.0;  ///< Model time in s when the change takes effect.
+        double power = 0.0;  ///< New heater power.
+    };
+
+    /**
+     * @brief Integrates the temperature with a constant heater power.
+     *
+     * @param duration Time to integrate in s.
+     */
+    void integrate(double duration);
+
+    Parameters                       m_parameters;    ///< Model parameters.
+    double                           m_temperature;   ///< Current temperature in °C.
+    double                           m_time  = 0.0;   ///< Model time in s.
+    double                           m_power = 0.0;   ///< Effective heater power.
+    std::deque<PowerChange>          m_powerChanges;  ///< Pending heater power changes.
+    std::mt19937                     m_random;        ///< Random generator of the sensor noise.
+    std::normal_distribution<double> m_noise;         ///< Standard normal sensor noise.
+};
+}  // namespace sugo::hal
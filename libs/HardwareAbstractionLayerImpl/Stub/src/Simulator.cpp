@@ -26,6 +26,8 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <thread>
 
 #include "Common/Logger.hpp"
 #include "HardwareAbstractionLayer/Simulator.hpp"
@@ -98,7 +100,8 @@ bool Simulator::setState(const Identifier& id, IGpioPin::State state)
 
 void Simulator::registerTemperatureSensor(const Identifier& id)
 {
-    m_temperatureSensors[id] = {false, Clock::now(), DefaultTemperature};
+    std::lock_guard lock(m_mutex);
+    m_temperatureSensors[id] = {ThermalModel{}, getTime()};
 }
 
 void Simulator::unregisterTemperatureSensor(const Identifier& id)
@@ -131,46 +134,203 @@ void Simulator::switchHeater(const Identifier& heaterTemperatureSensorId, IGpioP
     }
 
     auto& temperatureSensor = m_temperatureSensors.at(heaterTemperatureSensorId);
+    temperatureSensor.update(getTime());
 
     if (state == IGpioPin::State::High)
     {
         LOG(debug) << "Simulation - start heating up for sensor " << heaterTemperatureSensorId;
-        temperatureSensor.m_heatingUp = true;
+        temperatureSensor.m_model.setHeaterPower(1.0);
     }
     else
     {
         LOG(debug) << "Simulation - start cooling down for sensor " << heaterTemperatureSensorId;
-        temperatureSensor.m_heatingUp = false;
+        temperatureSensor.m_model.setHeaterPower(0.0);
+    }
+}
+
+ITemperatureSensor::Temperature Simulator::getTemperature(const Identifier& id)
+{
+    std::lock_guard lock(m_mutex);
+    auto&           temperatureSensor = m_temperatureSensors.at(id);
+    temperatureSensor.update(getTime());
+
+    const auto temperature = static_cast<ITemperatureSensor::RawTemperature>(
+        std::lround(temperatureSensor.m_model.measureTemperature() *
+                    ITemperatureSensor::DeciCelciusPerCelcius));
+    LOG(debug) << "Simulation - temperature on sensor " << id << ": " << temperature;
+    return ITemperatureSensor::Temperature{temperature, Unit::DeciCelcius};
+}
+
+bool Simulator::setThermalModel(const Identifier& id, const ThermalModel::Parameters& parameters)
+{
+    std::lock_guard lock(m_mutex);
+    auto            it = m_temperatureSensors.find(id);
+
+    if (it == m_temperatureSensors.end())
+    {
+        LOG(warning) << "No temperature sensor found: " << id;
+        return false;
     }
-    temperatureSensor.m_lastTemperatureChange = Clock::now();
+
+    it->second = {ThermalModel{parameters}, getTime()};
+    return true;
+}
+
+void Simulator::registerStepperMotor(const Identifier& id)
+{
+    std::lock_guard lock(m_mutex);
+    m_stepperMotors[id] = {StepperModel{}, getTime()};
+}
+
+void Simulator::unregisterStepperMotor(const Identifier& id)
+{
+    std::lock_guard lock(m_mutex);
+    auto            it = m_stepperMotors.find(id);
+
+    if (it != m_stepperMotors.end())
+    {
+        m_stepperMotors.erase(it);
+    }
+}
+
+bool Simulator::setStepperModel(const Identifier& id, const StepperModel::Parameters& parameters)
+{
+    std::lock_guard lock(m_mutex);
+    auto            it = m_stepperMotors.find(id);
+
+    if (it == m_stepperMotors.end())
+    {
+        LOG(warning) << "No stepper motor found: " << id;
+        return false;
+    }
+
+    it->second = {StepperModel{parameters}, getTime()};
+    return true;
+}
+
+bool Simulator::controlStepperMotor(const Identifier&                         id,
+                                    const std::function<void(StepperModel&)>& command)
+{
+    std::lock_guard lock(m_mutex);
+    auto            it = m_stepperMotors.find(id);
+
+    if (it == m_stepperMotors.end())
+    {
+        LOG(warning) << "No stepper motor found: " << id;
+        return false;
+    }
+
+    it->second.update(getTime());
+    command(it->second.m_model);
+    return true;
+}
+
+bool Simulator::injectStepperMotorError(const Identifier& id, uint32_t errorFlags)
+{
+    LOG(debug) << "Simulation - inject error on stepper motor " << id << ": " << errorFlags;
+    return controlStepperMotor(
+        id, [errorFlags](StepperModel& model) { model.injectError(errorFlags); });
 }
 
-ITemperatureSensor::Temperature Simulator::getTemperature(const Identifier& id) const
+StepperModel::State Simulator::getStepperMotorState(const Identifier& id)
 {
-    const auto temperature = m_temperatureSensors.at(id).getTemperature();
-    LOG(debug) << "Simulation - temperature on sensor " << id << ": " << temperature.getValue();
-    return temperature;
+    std::lock_guard lock(m_mutex);
+    auto&           stepperMotor = m_stepperMotors.at(id);
+    stepperMotor.update(getTime());
+    return stepperMotor.m_model.getState();
 }
 
-ITemperatureSensor::Temperature Simulator::TemperatureSensor::getTemperature() const
+void Simulator::enableSimulatedTime(bool enable)
 {
-    const auto secondsElapsed =
-        std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - m_lastTemperatureChange)
-            .count();
-    const ITemperatureSensor::RawTemperature temperatureDiff =
-        static_cast<ITemperatureSensor::RawTemperature>(secondsElapsed) * KelvinPerSecond;
-    m_lastTemperatureChange = Clock::now();
+    std::lock_guard lock(m_mutex);
+    for (auto& [id, temperatureSensor] : m_temperatureSensors)
+    {
+        temperatureSensor.update(getTime());
+    }
+    for (auto& [id, stepperMotor] : m_stepperMotors)
+    {
+        stepperMotor.update(getTime());
+    }
 
-    if (m_heatingUp)
+    if (enable)
     {
-        m_curentTemperature =
-            std::clamp(m_curentTemperature + temperatureDiff, DefaultTemperature, MaxTemperature);
-        return ITemperatureSensor::Temperature{m_curentTemperature, Unit::Celcius};
+        m_simulatedTime = Clock::time_point{};
     }
     else
     {
-        m_curentTemperature =
-            std::clamp(m_curentTemperature - temperatureDiff, DefaultTemperature, MaxTemperature);
-        return ITemperatureSensor::Temperature{m_curentTemperature, Unit::Celcius};
+        m_simulatedTime.reset();
+    }
+    m_timeAdvanced.notify_all();
+
+    // Continue the models from the new time base
+    for (auto& [id, temperatureSensor] : m_temperatureSensors)
+    {
+        temperatureSensor.m_lastUpdate = getTime();
+    }
+    for (auto& [id, stepperMotor] : m_stepperMotors)
+    {
+        stepperMotor.m_lastUpdate = getTime();
     }
-}
\ No newline at end of file
+}
+
+bool Simulator::advanceTime(Clock::duration duration)
+{
+    std::lock_guard lock(m_mutex);
+
+    if (!m_simulatedTime.has_value())
+    {
+        LOG(warning) << "Simulated time is not enabled";
+        return false;
+    }
+
+    *m_simulatedTime += duration;
+    m_timeAdvanced.notify_all();
+    return true;
+}
+
+void Simulator::sleepFor(Clock::duration duration, bool advanceTime)
+{
+    std::unique_lock lock(m_mutex);
+
+    if (!m_simulatedTime.has_value())
+    {
+        lock.unlock();
+        std::this_thread::sleep_for(duration);
+        return;
+    }
+
+    if (advanceTime)
+    {
+        *m_simulatedTime += duration;
+        m_timeAdvanced.notify_all();
+        return;
+    }
+
+    const auto wakeUpTime = *m_simulatedTime + duration;
+    (void)m_timeAdvanced.wait_for(lock, duration, [this, wakeUpTime] {
+        return !m_simulatedTime.has_value() || (*m_simulatedTime >= wakeUpTime);
+    });
+}
+
+Simulator::Clock::time_point Simulator::now() const
+{
+    std::lock_guard lock(m_mutex);
+    return getTime();
+}
+
+Simulator::Clock::time_point Simulator::getTime() const
+{
+    return m_simulatedTime.value_or(Clock::now());
+}
+
+void Simulator::TemperatureSensor::update(Clock::time_point now)
+{
+    m_model.advance(now - m_lastUpdate);
+    m_lastUpdate = now;
+}
+
+void Simulator::StepperMotor::update(Clock::time_point now)
+{
+    m_model.advance(now - m_lastUpdate);
+    m_lastUpdate = now;
+}
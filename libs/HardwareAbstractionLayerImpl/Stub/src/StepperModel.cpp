@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "HardwareAbstractionLayer/StepperModel.hpp"
+
+namespace
+{
+constexpr double SecondsPerMinute = 60.0;
+
+/// Returns the value moved towards the target by the passed max change.
+double approach(double value, double target, double maxChange)
+{
+    return (value < target) ? std::min(value + maxChange, target)
+                            : std::max(value - maxChange, target);
+}
+}  // namespace
+
+using namespace sugo::hal;
+
+StepperModel::StepperModel() : StepperModel(Parameters{})
+{
+}
+
+StepperModel::StepperModel(const Parameters& parameters) : m_parameters(parameters)
+{
+    assert(m_parameters.stepsPerRound > 0.0);
+    assert(m_parameters.acceleration > 0.0);
+    assert(m_parameters.deceleration > 0.0);
+    assert(m_parameters.cornerSpeed > 0.0);
+}
+
+bool StepperModel::energize()
+{
+    if (m_errorFlags != 0)
+    {
+        return false;
+    }
+
+    m_isEnergized = true;
+    return true;
+}
+
+void StepperModel::deEnergize()
+{
+    m_isEnergized = false;
+    stop(true);
+}
+
+void StepperModel::setTargetVelocity(double velocity)
+{
+    m_mode           = Mode::Velocity;
+    m_targetVelocity = velocity;
+}
+
+void StepperModel::setTargetPosition(double position, double maxSpeed)
+{
+    m_mode           = Mode::Position;
+    m_targetPosition = position;
+    m_maxSpeed       = std::abs(maxSpeed);
+}
+
+void StepperModel::stop(bool stopImmediately)
+{
+    if (stopImmediately)
+    {
+        m_velocity = 0.0;
+    }
+    setTargetVelocity(0.0);
+}
+
+void StepperModel::injectError(uint32_t errorFlags)
+{
+    if (errorFlags != 0)
+    {
+        m_errorFlags |= errorFlags;
+        deEnergize();
+    }
+}
+
+void StepperModel::advance(Duration duration)
+{
+    const double period = ControlPeriod.count();
+    m_pendingTime += duration.count();
+    while (m_pendingTime >= period)
+    {
+        control(period);
+        m_pendingTime -= period;
+    }
+}
+
+StepperModel::State StepperModel::getState() const
+{
+    const bool isMoving =
+        (m_velocity != 0.0) ||
+        (m_isEnergized && (m_mode == Mode::Position) && (m_position != m_targetPosition));
+    return {m_position, m_velocity, getCurrent(), m_errorFlags, m_isEnergized, isMoving};
+}
+
+void StepperModel::control(double duration)
+{
+    if (!m_isEnergized)
+    {
+        return;
+    }
+
+    // Ramps towards standstill use the deceleration, all others the acceleration. A reversal
+    // ramps down to standstill first.
+    const double controlVelocity = getControlVelocity();
+    const bool   isReversal      = (m_velocity * controlVelocity) < 0.0;
+    const bool   isSlowingDown   = isReversal || (std::abs(controlVelocity) < std::abs(m_velocity));
+    const double maxChange =
+        (isSlowingDown ? m_parameters.deceleration : m_parameters.acceleration) * duration;
+    const double velocity = approach(m_velocity, isReversal ? 0.0 : controlVelocity, maxChange);
+
+    // The velocity changes linearly within the control period.
+    const double lastPosition = m_position;
+    m_position += (m_velocity + velocity) / 2.0 * duration * m_parameters.stepsPerRound /
+                  SecondsPerMinute;
+    m_velocity = velocity;
+
+    // The position motion ends as soon as the target has been reached.
+    if ((m_mode == Mode::Position) &&
+        ((m_targetPosition - lastPosition) * (m_targetPosition - m_position) <= 0.0))
+    {
+        m_position = m_targetPosition;
+        m_velocity = 0.0;
+    }
+}
+
+double StepperModel::getControlVelocity() const
+{
+    if (m_mode == Mode::Velocity)
+    {
+        return m_targetVelocity;
+    }
+
+    // Ramps down as soon as the stopping distance would be passed within the next period.
+    const double stepsPerSecond   = m_parameters.stepsPerRound / SecondsPerMinute;
+    const double remaining        = m_targetPosition - m_position;
+    const double velocity         = m_velocity * stepsPerSecond;
+    const double stoppingDistance = (velocity * velocity) /
+                                        (2.0 * m_parameters.deceleration * stepsPerSecond) +
+                                    std::abs(velocity) * ControlPeriod.count();
+    if ((remaining == 0.0) ||
+        ((remaining * velocity > 0.0) && (stoppingDistance >= std::abs(remaining))))
+    {
+        return 0.0;
+    }
+    return std::copysign(m_maxSpeed, remaining);
+}
+
+double StepperModel::getCurrent() const
+{
+    if (!m_isEnergized)
+    {
+        return 0.0;
+    }
+
+    // The chopper holds the current limit, until the back-EMF exceeds the supply voltage.
+    const double speed = std::abs(m_velocity);
+    return (speed <= m_parameters.cornerSpeed)
+               ? m_parameters.currentLimit
+               : m_parameters.currentLimit * m_parameters.cornerSpeed / speed;
+}
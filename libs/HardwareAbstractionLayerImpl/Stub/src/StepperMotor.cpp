@@ -22,14 +22,44 @@
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-#include "HardwareAbstractionLayer/StepperMotor.hpp"
+#include <cmath>
+
 #include "Common/IConfiguration.hpp"
 #include "Common/Logger.hpp"
+#include "HardwareAbstractionLayer/Simulator.hpp"
+#include "HardwareAbstractionLayer/StepperMotor.hpp"
 
 namespace
 {
-sugo::hal::IStepperMotor::Position s_curPosition = 0;
+constexpr int                       MicroStepsPerStep  = 8;
+constexpr int                       FullStepsPerRound  = 200;
+constexpr int                       MicroStepsPerRound = FullStepsPerRound * MicroStepsPerStep;
+constexpr std::chrono::milliseconds PollWaitTime(10u);  ///< State polling while moving.
+
+static_assert(sugo::hal::StepperModel::Parameters{}.stepsPerRound == MicroStepsPerRound,
+              "The simulated motor has to use the step mode of the real one");
+
+/// Returns the speed in RPM.
+double toRpm(sugo::hal::IStepperMotor::Speed speed)
+{
+    return static_cast<double>(sugo::hal::IStepperMotor::toMilliRpm(speed).getValue()) /
+           sugo::hal::IStepperMotor::MilliRpmPerRpm;
+}
+
+/// Returns the signed velocity in RPM of the speed in the passed direction.
+double toVelocity(sugo::hal::IStepperMotor::Speed     speed,
+                  sugo::hal::IStepperMotor::Direction direction)
+{
+    return toRpm(speed) * ((direction == sugo::hal::IStepperMotor::Direction::Forward) ? 1 : -1);
+}
+
+/// Returns the signed velocity in RPM as milli-RPM.
+int32_t toVelocityMilliRpm(double velocity)
+{
+    return static_cast<int32_t>(std::lround(velocity * sugo::hal::IStepperMotor::MilliRpmPerRpm));
 }
+}  // namespace
+
 using namespace sugo::hal;
 
 StepperMotor::~StepperMotor()
@@ -41,20 +71,22 @@ bool StepperMotor::init(const sugo::common::IConfiguration& configuration)
 {
     const auto address =
         static_cast<uint8_t>(configuration.getOption(id::I2cAddress).get<unsigned>());
-    m_maxSpeed =
-        IStepperMotor::Speed(configuration.getOption(id::MaxSpeedRpm).get<unsigned>(), Unit::Rpm);
+    m_maxSpeed = toMilliRpm(
+        IStepperMotor::Speed(configuration.getOption(id::MaxSpeedRpm).get<unsigned>(), Unit::Rpm));
     m_direction = (configuration.getOption(id::Direction).get<std::string>() == "backward")
                       ? IStepperMotor::Direction::Backward
                       : IStepperMotor::Direction::Forward;
     LOG(debug) << getId() << "." << id::I2cAddress << ": " << address;
     LOG(debug) << getId() << "." << id::MaxSpeedRpm << ": " << m_maxSpeed;
     LOG(debug) << getId() << "." << id::Direction << ": " << m_direction;
-    s_curPosition = 0;
+    Simulator::getInstance().registerStepperMotor(getId());
     return true;
 }
 
 void StepperMotor::finalize()
 {
+    stopMotionObservation();
+    Simulator::getInstance().unregisterStepperMotor(getId());
 }
 
 bool StepperMotor::reset()
@@ -63,51 +95,164 @@ bool StepperMotor::reset()
     {
         stop(true);
     }
+
+    // Like a reset of the controller, all pending errors are cleared.
+    return Simulator::getInstance().controlStepperMotor(
+        getId(), [](StepperModel& model) { model.clearErrors(); });
+}
+
+StepperMotor::Position StepperMotor::getPosition() const
+{
+    return static_cast<Position>(
+        std::lround(Simulator::getInstance().getStepperMotorState(getId()).position));
+}
+
+bool StepperMotor::prepareForMotion()
+{
+    const auto state = Simulator::getInstance().getStepperMotorState(getId());
+    if (state.errorFlags != 0)
+    {
+        LOG(error) << getId() << ": Motor has pending errors (" << state.errorFlags << ")";
+        return false;
+    }
+
+    if (state.velocity != 0.0)
+    {
+        LOG(error) << getId() << ": Motor is still moving";
+        return false;
+    }
+
     return true;
 }
 
-bool StepperMotor::rotateToPosition(Position position)
+bool StepperMotor::startMotionToPosition(Position position, std::chrono::milliseconds& motionTime)
 {
-    s_curPosition += position;
+    stopMotionObservation();
+    if (!prepareForMotion())
+    {
+        return false;
+    }
+
+    // The simulated motion is observed until it has finished, so no motion time is needed.
+    motionTime            = std::chrono::milliseconds(0);
+    const double maxSpeed = toRpm(m_maxSpeed);
+    bool         success  = false;
+    (void)Simulator::getInstance().controlStepperMotor(getId(), [&](StepperModel& model) {
+        success = model.energize();
+        model.setTargetPosition(static_cast<double>(position), maxSpeed);
+    });
+
+    if (!success)
+    {
+        LOG(error) << getId() << ": Failed to move to target position (" << position << ")";
+        (void)stop(true);
+        return false;
+    }
+
     return true;
 }
 
 bool StepperMotor::rotate(Direction direction)
 {
-    m_direction = direction;
+    stopMotionObservation();
+    if (!prepareForMotion())
+    {
+        return false;
+    }
+
+    m_direction           = direction;
+    const double velocity = toVelocity(m_speed, m_direction);
+    LOG(debug) << getId() << ": Start rotation with target velocity " << velocity;
+
+    bool success = false;
+    (void)Simulator::getInstance().controlStepperMotor(getId(), [&](StepperModel& model) {
+        success = model.energize();
+        model.setTargetVelocity(velocity);
+    });
+
+    if (!success)
+    {
+        LOG(error) << getId() << ": Failed to start rotation";
+        (void)stop(true);
+        return false;
+    }
+
     return true;
 }
 
-bool StepperMotor::stop(bool stopImmediately)
+bool StepperMotor::haltMotion(bool stopImmediately)
 {
-    (void)stopImmediately;
+    return Simulator::getInstance().controlStepperMotor(
+        getId(), [stopImmediately](StepperModel& model) { model.stop(stopImmediately); });
+}
+
+std::chrono::milliseconds StepperMotor::getStopTime()
+{
+    // The ramp down is observed on the simulated state.
+    return std::chrono::milliseconds(0);
+}
+
+bool StepperMotor::waitForMotionTime(std::chrono::milliseconds /*motionTime*/)
+{
+    // The simulated motion is observed until it has finished, so no motion time is waited for.
     return true;
 }
 
-StepperMotor::Position StepperMotor::getPosition() const
+StepperMotor::MotionState StepperMotor::getMotionState()
+{
+    const auto state = Simulator::getInstance().getStepperMotorState(getId());
+    if (state.errorFlags != 0)
+    {
+        LOG(error) << getId() << ": Motor has errors (" << state.errorFlags << ")";
+        return MotionState::Failed;
+    }
+
+    return state.isMoving ? MotionState::Moving : MotionState::Stopped;
+}
+
+void StepperMotor::waitForMotionState(bool isAsynchronous)
+{
+    // Polls the simulated state, so the motion finishes with the simulated time as well. The
+    // caller of a synchronous motion blocks the time control, so it advances the time itself.
+    Simulator::getInstance().sleepFor(PollWaitTime, !isAsynchronous);
+}
+
+bool StepperMotor::shutdown()
 {
-    return s_curPosition;
+    return Simulator::getInstance().controlStepperMotor(
+        getId(), [](StepperModel& model) { model.deEnergize(); });
 }
 
 StepperMotor::StepCount StepperMotor::getMicroStepCount() const
 {
-    static constexpr StepCount microStepCount = 1u;
-    return microStepCount;
+    return MicroStepsPerStep;
 }
 
 StepperMotor::StepCount StepperMotor::getStepsPerRound() const
 {
-    static constexpr StepCount stepsPerRound = 200u;
-    return stepsPerRound;
+    return MicroStepsPerRound;
+}
+
+bool StepperMotor::getTelemetry(Telemetry& telemetry) const
+{
+    const auto state      = Simulator::getInstance().getStepperMotorState(getId());
+    telemetry.position    = static_cast<Position>(std::lround(state.position));
+    telemetry.velocity    = toVelocityMilliRpm(state.velocity);
+    telemetry.errorFlags  = state.errorFlags;
+    telemetry.isEnergized = state.isEnergized;
+    return true;
 }
 
 StepperMotor::Speed StepperMotor::getSpeed() const
 {
-    return Speed(0u, Unit::Rpm);
+    const auto    state    = Simulator::getInstance().getStepperMotorState(getId());
+    const int32_t velocity = toVelocityMilliRpm(state.velocity);
+    return Speed(static_cast<unsigned>(std::abs(velocity)), Unit::MilliRpm);
 }
 
 bool StepperMotor::setSpeed(Speed speed)
 {
+    speed = toMilliRpm(speed);
     if (speed.getValue() > m_maxSpeed.getValue())
     {
         LOG(error) << getId() << ": Set target speed (" << speed << ") exceeds max speed ("
@@ -115,6 +260,21 @@ bool StepperMotor::setSpeed(Speed speed)
         return false;
     }
 
-    m_speed = speed;
-    return true;
-}
\ No newline at end of file
+    m_speed               = speed;
+    const double velocity = toVelocity(speed, m_direction);
+    LOG(debug) << getId() << ": Set target velocity to " << velocity;
+
+    return Simulator::getInstance().controlStepperMotor(
+        getId(), [velocity](StepperModel& model) { model.setTargetVelocity(velocity); });
+}
+
+bool StepperMotor::setSpeedSynchronized(Speed speed)
+{
+    // The simulated motors share no bus, so their speed changes are not held back.
+    return setSpeed(speed);
+}
+
+bool StepperMotor::cancelSpeedSynchronized()
+{
+    return false;
+}
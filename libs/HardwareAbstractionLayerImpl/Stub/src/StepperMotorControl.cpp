@@ -25,6 +25,7 @@
 #include "HardwareAbstractionLayer/StepperMotorControl.hpp"
 #include "HardwareAbstractionLayer/HalHelper.hpp"
 #include "HardwareAbstractionLayer/StepperMotor.hpp"
+#include "HardwareAbstractionLayer/StepperMotorGroup.hpp"
 
 namespace sugo::hal
 {
@@ -49,12 +50,16 @@ bool StepperMotorControl::init(const common::IConfiguration& configuration)
     auto deviceName = configuration.getOption("device").get<std::string>();
     LOG(debug) << getId() << ": Open device '" << deviceName << "'";
 
+    m_motorGroup = new StepperMotorGroup(s_i2cControlDummy);
     return initEnabledSubComponents<IStepperMotor, StepperMotor>(
-        configuration, "motor", m_stepperMotorMap, s_i2cControlDummy, m_ioErr, m_ioRst);
+        configuration, "motor", m_stepperMotorMap, s_i2cControlDummy, *m_motorGroup, m_ioErr,
+        m_ioRst);
 }
 
 void StepperMotorControl::finalize()
 {
+    delete m_motorGroup;
+    m_motorGroup = nullptr;
 }
 
 void StepperMotorControl::reset()
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HardwareAbstractionLayer/StepperMotorGroup.hpp"
+
+using namespace sugo::hal;
+
+// The stub motors have no controller, so the group has no members.
+
+StepperMotorGroup::~StepperMotorGroup() = default;
+
+void StepperMotorGroup::add(TicController& /*controller*/)
+{
+}
+
+void StepperMotorGroup::remove(TicController& /*controller*/)
+{
+}
+
+bool StepperMotorGroup::changeVelocity(TicController& /*controller*/, int32_t /*velocity*/)
+{
+    return true;
+}
+
+bool StepperMotorGroup::updateHeldVelocity(TicController& /*controller*/, int32_t /*velocity*/)
+{
+    return false;
+}
+
+bool StepperMotorGroup::cancel(TicController& /*controller*/)
+{
+    return false;
+}
+
+bool StepperMotorGroup::restore(TicController& /*controller*/)
+{
+    return true;
+}
@@ -37,6 +37,8 @@ bool TemperatureSensor::init(const common::IConfiguration& configuration)
 {
     const auto chipSelect = configuration.getOption(id::ChipSelect).get<std::string>();
     LOG(debug) << getId() << "." << id::ChipSelect << ": " << chipSelect;
+    const auto dataReady = configuration.getOption(id::DataReady).get<std::string>();
+    LOG(debug) << getId() << "." << id::DataReady << ": " << dataReady;
 
     return true;
 }
@@ -49,3 +51,9 @@ TemperatureSensor::Temperature TemperatureSensor::getTemperature() const
 {
     return Simulator::getInstance().getTemperature(getId());
 }
+
+bool TemperatureSensor::registerSampleHandler(SampleHandler)
+{
+    // The simulation does not provide a data-ready signal, the sensor has to be polled!
+    return false;
+}
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "HardwareAbstractionLayer/ThermalModel.hpp"
+
+using namespace sugo::hal;
+
+ThermalModel::ThermalModel() : ThermalModel(Parameters{})
+{
+}
+
+ThermalModel::ThermalModel(const Parameters& parameters, unsigned seed)
+    : m_parameters(parameters), m_temperature(parameters.ambientTemperature), m_random(seed)
+{
+    assert(m_parameters.timeConstant > 0.0);
+    assert(m_parameters.deadTime >= 0.0);
+    assert(m_parameters.sensorNoise >= 0.0);
+}
+
+void ThermalModel::setHeaterPower(double power)
+{
+    m_powerChanges.push_back({m_time + m_parameters.deadTime, std::clamp(power, 0.0, 1.0)});
+}
+
+void ThermalModel::advance(Duration duration)
+{
+    const double endTime = m_time + duration.count();
+
+    // Integrate piecewise between the power changes which take effect in the meantime.
+    while (!m_powerChanges.empty() && (m_powerChanges.front().time <= endTime))
+    {
+        integrate(m_powerChanges.front().time - m_time);
+        m_power = m_powerChanges.front().power;
+        m_powerChanges.pop_front();
+    }
+    integrate(endTime - m_time);
+}
+
+void ThermalModel::integrate(double duration)
+{
+    if (duration <= 0.0)
+    {
+        return;
+    }
+
+    const double steadyTemperature =
+        m_parameters.ambientTemperature + m_parameters.heaterGain * m_power;
+    m_temperature = steadyTemperature + (m_temperature - steadyTemperature) *
+                                            std::exp(-duration / m_parameters.timeConstant);
+    m_time += duration;
+}
+
+double ThermalModel::measureTemperature()
+{
+    return m_temperature + m_parameters.sensorNoise * m_noise(m_random);
+}
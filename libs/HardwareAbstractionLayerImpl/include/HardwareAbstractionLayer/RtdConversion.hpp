@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "HardwareAbstractionLayer/ITemperatureSensor.hpp"
+
+namespace sugo::hal::rtd
+{
+/// @brief Resistance value type in centi Ohm (1/100 Ohm).
+using Resistance = int32_t;
+
+/// @brief Fixed-point temperature value type in deci Celcius (1/10 degree Celcius).
+using Temperature = ITemperatureSensor::RawTemperature;
+
+/// @brief Nominal resistance of a PT100 at 0°C in centi Ohm.
+inline constexpr Resistance NominalResistance = 10000;
+
+/// @brief Lowest temperature covered by the look-up table in Celcius.
+inline constexpr int16_t MinTableTemperature = -50;
+
+/// @brief Highest temperature covered by the look-up table in Celcius.
+inline constexpr int16_t MaxTableTemperature = 250;
+
+/// @brief Callendar-Van Dusen coefficients according to IEC 60751.
+inline constexpr double CoefficientA = 3.9083e-3;
+inline constexpr double CoefficientB = -5.775e-7;
+inline constexpr double CoefficientC = -4.183e-12;
+
+/**
+ * @brief Calculates the PT100 resistance for a temperature by the Callendar-Van Dusen equation.
+ *
+ * @param temperature Temperature in Celcius.
+ * @return Resistance in centi Ohm.
+ */
+constexpr double callendarVanDusen(double temperature)
+{
+    const double t2 = temperature * temperature;
+    double       r  = 1.0 + CoefficientA * temperature + CoefficientB * t2;
+    if (temperature < 0.0)
+    {
+        r += CoefficientC * (temperature - 100.0) * t2 * temperature;
+    }
+    return static_cast<double>(NominalResistance) * r;
+}
+
+/// @brief Resistance to temperature look-up table entry.
+struct ResistanceTemperature
+{
+    Resistance resistance;   ///< Resistance in centi Ohm.
+    int16_t    temperature;  ///< Temperature in Celcius.
+};
+
+/// @brief Number of entries of the look-up table (one per degree Celcius).
+inline constexpr std::size_t TableSize = MaxTableTemperature - MinTableTemperature + 1;
+
+/// @brief Look-up table type.
+using ResistanceTemperatureTable = std::array<ResistanceTemperature, TableSize>;
+
+/**
+ * @brief Generates the resistance to temperature look-up table at compile time.
+ *
+ * @return Look-up table sorted by ascending resistance.
+ */
+constexpr ResistanceTemperatureTable generateTable()
+{
+    ResistanceTemperatureTable table{};
+    for (std::size_t i = 0; i < table.size(); ++i)
+    {
+        const auto temperature = static_cast<int16_t>(MinTableTemperature + static_cast<int>(i));
+        // All table resistances are positive, so adding 0.5 rounds correctly.
+        table[i] = {static_cast<Resistance>(callendarVanDusen(temperature) + 0.5), temperature};
+    }
+    return table;
+}
+
+/// @brief Resistance to temperature look-up table.
+inline constexpr ResistanceTemperatureTable ResistanceToTemperatureLookUpTable = generateTable();
+
+static_assert(ResistanceToTemperatureLookUpTable.front().resistance == 8031,
+              "Unexpected resistance at -50°C");
+static_assert(ResistanceToTemperatureLookUpTable[50].resistance == NominalResistance,
+              "Unexpected resistance at 0°C");
+static_assert(ResistanceToTemperatureLookUpTable.back().resistance == 19410,
+              "Unexpected resistance at 250°C");
+
+/**
+ * @brief Converts a PT100 resistance into a temperature value. The table is binary searched
+ * and the result is linearly interpolated between the two neighboured entries.
+ * Resistances below the table range are clamped to the lowest table temperature.
+ *
+ * @param resistance Resistance in centi Ohm.
+ * @return Temperature in deci Celcius or std::nullopt if the resistance exceeds the table.
+ */
+inline std::optional<Temperature> toTemperature(Resistance resistance)
+{
+    const auto& table = ResistanceToTemperatureLookUpTable;
+    if (resistance <= table.front().resistance)
+    {
+        return static_cast<Temperature>(table.front().temperature) *
+               ITemperatureSensor::DeciCelciusPerCelcius;
+    }
+    if (resistance > table.back().resistance)
+    {
+        return std::nullopt;
+    }
+
+    // First entry with a greater or equal resistance, never the first one here!
+    const auto upper = std::lower_bound(
+        table.cbegin(), table.cend(), resistance,
+        [](const ResistanceTemperature& entry, Resistance value) {
+            return entry.resistance < value;
+        });
+    const auto lower = upper - 1;
+
+    const Resistance range = upper->resistance - lower->resistance;
+    const Resistance delta = resistance - lower->resistance;
+    constexpr Temperature scale = ITemperatureSensor::DeciCelciusPerCelcius;
+    return static_cast<Temperature>(lower->temperature) * scale +
+           (delta * scale + range / 2) / range;
+}
+}  // namespace sugo::hal::rtd
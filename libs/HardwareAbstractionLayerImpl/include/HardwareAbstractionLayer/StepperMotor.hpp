@@ -25,19 +25,25 @@
 #pragma once
 
 #include "HardwareAbstractionLayer/IGpioPin.hpp"
-#include "HardwareAbstractionLayer/IStepperMotor.hpp"
+#include "HardwareAbstractionLayer/StepperMotorBase.hpp"
 
 namespace sugo::hal
 {
 class TicController;
 class I2cControl;
+class StepperMotorGroup;
 
 /// @brief Class represents an ADC input
-class StepperMotor : public IStepperMotor
+class StepperMotor : public StepperMotorBase
 {
 public:
-    StepperMotor(const Identifier& id, I2cControl& i2cControl, IGpioPin& ioErr, IGpioPin& ioRst)
-        : IStepperMotor(id), m_i2cControl(i2cControl), m_ioErr(ioErr), m_ioRst(ioRst)
+    StepperMotor(const Identifier& id, I2cControl& i2cControl, StepperMotorGroup& motorGroup,
+                 IGpioPin& ioErr, IGpioPin& ioRst)
+        : StepperMotorBase(id),
+          m_i2cControl(i2cControl),
+          m_motorGroup(motorGroup),
+          m_ioErr(ioErr),
+          m_ioRst(ioRst)
     {
     }
     ~StepperMotor() override;
@@ -46,7 +52,6 @@ public:
     void finalize();
 
     bool reset() override;
-    bool rotateToPosition(Position position) override;
     bool rotate(Direction direction) override;
 
     bool rotate() override
@@ -54,10 +59,10 @@ public:
         return rotate(m_direction);
     }
 
-    bool      stop(bool stopImmediately = false) override;
     Position  getPosition() const override;
     StepCount getMicroStepCount() const override;
     StepCount getStepsPerRound() const override;
+    bool      getTelemetry(Telemetry& telemetry) const override;
     Speed     getSpeed() const override;
 
     Speed getMaxSpeed() const override
@@ -67,23 +72,35 @@ public:
 
     void setMaxSpeed(Speed maxSpeed) override
     {
-        m_maxSpeed = maxSpeed;
+        m_maxSpeed = toMilliRpm(maxSpeed);
     }
 
     bool setSpeed(Speed speed) override;
+    bool setSpeedSynchronized(Speed speed) override;
+    bool cancelSpeedSynchronized() override;
+
+protected:
+    bool startMotionToPosition(Position position, std::chrono::milliseconds& motionTime) override;
+    bool haltMotion(bool stopImmediately) override;
+    bool waitForMotionTime(std::chrono::milliseconds motionTime) override;
+    bool shutdown() override;
+
+    std::chrono::milliseconds getStopTime() override;
+    MotionState               getMotionState() override;
+    void                      waitForMotionState(bool isAsynchronous) override;
 
 private:
+    bool setSpeed(Speed speed, bool isSynchronized);
     bool prepareForMotion();
-    bool waitAndShutdown(std::chrono::milliseconds remainingMotionTime,
-                         bool                      stopImmediately = false);
-
-    I2cControl&    m_i2cControl;
-    IGpioPin&      m_ioErr;
-    IGpioPin&      m_ioRst;
-    TicController* m_controller = nullptr;
-    Speed          m_maxSpeed   = Speed(0, Unit::Rpm);
-    Speed          m_speed      = Speed(0, Unit::Rpm);
-    Direction      m_direction  = Direction::Forward;
+
+    I2cControl&        m_i2cControl;
+    StepperMotorGroup& m_motorGroup;
+    IGpioPin&          m_ioErr;
+    IGpioPin&          m_ioRst;
+    TicController*     m_controller = nullptr;
+    Speed              m_maxSpeed   = Speed(0, Unit::MilliRpm);
+    Speed              m_speed      = Speed(0, Unit::MilliRpm);
+    Direction          m_direction  = Direction::Forward;
 };
 
 }  // namespace sugo::hal
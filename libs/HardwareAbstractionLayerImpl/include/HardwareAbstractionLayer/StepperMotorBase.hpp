@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "Common/Thread.hpp"
+#include "HardwareAbstractionLayer/IStepperMotor.hpp"
+
+namespace sugo::hal
+{
+/**
+ * @brief Base class of the stepper motors, which observes the motions until they have finished.
+ * The motion is either observed synchronously by the caller or asynchronously by the motion
+ * observer thread. The motor specific parts are provided by the derived class.
+ */
+class StepperMotorBase : public IStepperMotor
+{
+public:
+    bool rotateToPosition(Position position) override;
+    bool rotateToPositionAsync(Position position, MotionCompletionHandler handler) override;
+    bool stop(bool stopImmediately = false) override;
+    bool stopAsync(bool stopImmediately, MotionCompletionHandler handler) override;
+
+protected:
+    /// @brief Motion state of the motor.
+    enum class MotionState
+    {
+        Moving,
+        Stopped,
+        Failed
+    };
+
+    explicit StepperMotorBase(const Identifier& id)
+        : IStepperMotor(id), m_motionObserver(id + "Motion")
+    {
+    }
+
+    /**
+     * @brief Starts the observation of the current motion by the motion observer thread.
+     *
+     * @param motionTime      Expected time of the motion.
+     * @param stopImmediately Indicates if the motor has been stopped immediately.
+     * @param handler         Handler to be called when the motion has finished.
+     * @return true           If the observation could be started successfully.
+     * @return false          If the observation could not be started successfully.
+     */
+    bool startMotionObservation(std::chrono::milliseconds motionTime, bool stopImmediately,
+                                MotionCompletionHandler handler);
+
+    /// @brief Aborts a running motion observation and waits until it has finished.
+    void stopMotionObservation();
+
+    /**
+     * @brief Indicates if the current motion is still observed.
+     *
+     * @return true  If the motion is observed.
+     * @return false If the observation has been aborted.
+     */
+    bool isObserving() const
+    {
+        return m_doObserve;
+    }
+
+    /**
+     * @brief Starts a motion to the passed position.
+     *
+     * @param position   Target position.
+     * @param motionTime Expected time of the motion.
+     * @return true      If the motion could be started successfully.
+     * @return false     If the motion could not be started successfully.
+     */
+    virtual bool startMotionToPosition(Position                   position,
+                                       std::chrono::milliseconds& motionTime) = 0;
+
+    /**
+     * @brief Halts the current motion.
+     *
+     * @param stopImmediately Indicates if the motor should stop abruptly or with its deceleration.
+     * @return true           If the motor could be halted successfully.
+     * @return false          If the motor could not be halted successfully.
+     */
+    virtual bool haltMotion(bool stopImmediately) = 0;
+
+    /**
+     * @brief Returns the time the motor needs to ramp down after it has been halted.
+     *
+     * @return The ramp down time.
+     */
+    virtual std::chrono::milliseconds getStopTime() = 0;
+
+    /**
+     * @brief Waits for the expected motion time, but returns as soon as the observation has been
+     * aborted.
+     *
+     * @param motionTime Expected time of the motion.
+     * @return true      If no error has occurred while waiting.
+     * @return false     If an error has occurred while waiting.
+     */
+    virtual bool waitForMotionTime(std::chrono::milliseconds motionTime) = 0;
+
+    /**
+     * @brief Returns the current motion state.
+     *
+     * @return The motion state.
+     */
+    virtual MotionState getMotionState() = 0;
+
+    /**
+     * @brief Waits until the motion state should be polled again.
+     *
+     * @param isAsynchronous Indicates if the motion is observed by the motion observer thread.
+     */
+    virtual void waitForMotionState(bool isAsynchronous) = 0;
+
+    /**
+     * @brief Shuts the motor down after the motion has finished.
+     *
+     * @return true  If the motor could be shut down successfully.
+     * @return false If the motor could not be shut down successfully.
+     */
+    virtual bool shutdown() = 0;
+
+private:
+    std::chrono::milliseconds initiateStop(bool& stopImmediately);
+
+    bool         waitForMotion(std::chrono::milliseconds motionTime, bool stopImmediately);
+    MotionResult waitAndShutdown(std::chrono::milliseconds remainingMotionTime,
+                                 bool stopImmediately, bool isAsynchronous);
+
+    common::Thread   m_motionObserver;
+    std::atomic_bool m_doObserve{false};
+};
+
+}  // namespace sugo::hal
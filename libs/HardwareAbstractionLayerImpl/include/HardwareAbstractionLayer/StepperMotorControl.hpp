@@ -30,7 +30,8 @@
 
 namespace sugo::hal
 {
-class I2cControl;
+class I2cBusArbiter;
+class StepperMotorGroup;
 
 /// @brief Class for contolling stepper motors.
 class StepperMotorControl : public IStepperMotorControl
@@ -54,10 +55,11 @@ public:
     }
 
 private:
-    IGpioPin&       m_ioErr;
-    IGpioPin&       m_ioRst;
-    I2cControl*     m_i2c = nullptr;
-    StepperMotorMap m_stepperMotorMap;
+    IGpioPin&          m_ioErr;
+    IGpioPin&          m_ioRst;
+    I2cBusArbiter*     m_i2c        = nullptr;
+    StepperMotorGroup* m_motorGroup = nullptr;
+    StepperMotorMap    m_stepperMotorMap;
 };
 
 }  // namespace sugo::hal
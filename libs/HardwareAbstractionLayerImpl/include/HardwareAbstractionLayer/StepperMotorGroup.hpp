@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "Common/Thread.hpp"
+
+namespace sugo::hal
+{
+class TicController;
+class I2cControl;
+
+/**
+ * @brief Class coordinates the velocity changes of several stepper motors on the same bus.
+ * The synchronized velocity changes are held back until each motor of the group got one, then
+ * they are applied together. The acceleration of each motor is reduced, so that all motors finish
+ * their ramps at the same time as the motor with the longest ramp. The velocity commands are sent
+ * back to back within one transaction. Once the ramps are finished, the nominal accelerations of
+ * the controllers are restored. Held back velocity changes, which are not completed within the
+ * hold timeout, are discarded.
+ */
+class StepperMotorGroup
+{
+public:
+    /// @brief Default max time to hold back the velocity changes.
+    static constexpr std::chrono::milliseconds DefaultHoldTimeout{1000};
+
+    /**
+     * @brief Constructs a new stepper motor group.
+     *
+     * @param i2cControl  Bus of all motor controllers.
+     * @param holdTimeout Max time to hold back the velocity changes.
+     */
+    explicit StepperMotorGroup(I2cControl&               i2cControl,
+                               std::chrono::milliseconds holdTimeout = DefaultHoldTimeout)
+        : m_i2cControl(i2cControl), m_holdTimeout(holdTimeout), m_restorer("StepperMotorGroup")
+    {
+    }
+
+    /// @brief Restores the reduced accelerations and stops the group.
+    ~StepperMotorGroup();
+
+    /**
+     * @brief Adds the controller of a motor to the group.
+     *
+     * @param controller Controller of the motor.
+     */
+    void add(TicController& controller);
+
+    /**
+     * @brief Removes the controller of a motor from the group and restores its nominal limits.
+     *
+     * @param controller Controller of the motor.
+     */
+    void remove(TicController& controller);
+
+    /**
+     * @brief Holds back the synchronized velocity change of a controller, until all controllers
+     * of the group got one. Then all velocity changes are applied with a shared acceleration
+     * profile.
+     *
+     * @param controller Controller of the motor.
+     * @param velocity   Target velocity in microsteps per 10,000 s.
+     * @return true if the velocity change is held back or has been applied.
+     * @return false if the velocity changes could not be applied.
+     */
+    bool changeVelocity(TicController& controller, int32_t velocity);
+
+    /**
+     * @brief Updates the held back velocity change of a controller, so that an unsynchronized
+     * velocity change is applied together with the other ones instead of discarding them.
+     *
+     * @param controller Controller of the motor.
+     * @param velocity   Target velocity in microsteps per 10,000 s.
+     * @return true if the held back velocity change has been updated.
+     * @return false if the controller has no held back velocity change.
+     */
+    bool updateHeldVelocity(TicController& controller, int32_t velocity);
+
+    /**
+     * @brief Discards the held back velocity changes of the group, if the controller has one,
+     * since they cannot be completed anymore.
+     *
+     * @param controller Controller of the motor.
+     * @return true if the held back velocity changes have been discarded.
+     * @return false if the controller has no held back velocity change.
+     */
+    bool cancel(TicController& controller);
+
+    /**
+     * @brief Restores the nominal acceleration and deceleration of a controller, if they are
+     * still reduced by a shared acceleration profile, and discards the held back velocity changes
+     * of the group, if the controller has one. Has to be called before any other velocity change
+     * or stop of the motor.
+     *
+     * @param controller Controller of the motor.
+     * @return true if succeeded
+     * @return false if failed
+     */
+    bool restore(TicController& controller);
+
+    /**
+     * @brief Returns the time between the first and the last velocity command of the last
+     * applied velocity changes, which is the maximum start skew between the motors.
+     *
+     * @return Skew of the last velocity changes.
+     */
+    std::chrono::microseconds getLastSkew() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_lastSkew;
+    }
+
+private:
+    /// @brief Used clock type.
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Held back velocity change.
+    struct VelocityChange
+    {
+        TicController* controller = nullptr;  ///< Controller of the motor.
+        int32_t        velocity   = 0;        ///< Target velocity.
+    };
+
+    /// @brief Nominal acceleration limits of a controller.
+    struct Limits
+    {
+        uint32_t maxAcceleration = 0;  ///< Max acceleration in microsteps per 100 s².
+        uint32_t maxDeceleration = 0;  ///< Max deceleration in microsteps per 100 s².
+    };
+
+    bool apply();
+    bool cancelHeldChanges(TicController& controller);
+    bool restoreLimits(TicController& controller, const Limits& limits) const;
+    bool startRestorer();
+    void runRestorer();
+
+    mutable std::mutex               m_mutex;              ///< Protects the group.
+    I2cControl&                      m_i2cControl;         ///< Bus of the controllers.
+    std::set<TicController*>         m_members;            ///< Controllers of the group.
+    std::vector<VelocityChange>      m_velocityChanges;    ///< Held back changes.
+    std::map<TicController*, Limits> m_reducedLimits;      ///< Nominal limits to be restored.
+    std::optional<Clock::time_point> m_restoreTime;        ///< End of the shared ramps.
+    std::optional<Clock::time_point> m_holdDeadline;       ///< End of the held back changes.
+    std::chrono::milliseconds        m_holdTimeout;        ///< Max hold time of the changes.
+    std::chrono::microseconds        m_lastSkew{0};        ///< Last measured skew.
+    bool                             m_isRunning = false;  ///< Restorer run indication.
+    std::condition_variable          m_restoreCondition;   ///< Signals a new deadline.
+    common::Thread                   m_restorer;           ///< Handles the deadlines.
+};
+}  // namespace sugo::hal
@@ -24,8 +24,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <limits>
+#include <memory>
+#include <mutex>
 
+#include "Common/Thread.hpp"
 #include "HardwareAbstractionLayer/IGpioControl.hpp"
 #include "HardwareAbstractionLayer/ITemperatureSensor.hpp"
 
@@ -40,7 +45,10 @@ class TemperatureSensor : public ITemperatureSensor
 public:
     TemperatureSensor(const Identifier& id, SpiControl& spiControl,
                       const IGpioControl::GpioPinMap& gpioPins)
-        : ITemperatureSensor(id), m_spiControl(spiControl), m_gpioPins(gpioPins)
+        : ITemperatureSensor(id),
+          m_spiControl(spiControl),
+          m_gpioPins(gpioPins),
+          m_dataReadyObserver(id + "DataReady")
     {
     }
     ~TemperatureSensor() override;
@@ -49,11 +57,28 @@ public:
     bool init(const common::IConfiguration& configuration) override;
 
     Temperature getTemperature() const override;
+    bool        registerSampleHandler(SampleHandler handler) override;
 
 private:
+    /// @brief Observes the data-ready pin and publishes a new sample on every conversion.
+    void observeDataReady();
+
+    /// @brief Reads a new sample from the sensor and publishes it to the sample handler.
+    void publishSample();
+
+    /// Used clock type.
+    using Clock = std::chrono::steady_clock;
+
     SpiControl&                     m_spiControl;
     const IGpioControl::GpioPinMap& m_gpioPins;
     Max31865*                       m_driver = nullptr;
+    std::shared_ptr<IGpioPin>       m_dataReadyPin;          ///< Optional data-ready pin.
+    common::Thread                  m_dataReadyObserver;     ///< Data-ready observation thread.
+    std::atomic_bool                m_doObserve{false};      ///< Observation run indication.
+    std::atomic<RawTemperature>     m_lastSample{0};         ///< Last published sample.
+    std::atomic<Clock::rep>         m_lastSampleTime{0};     ///< Time of the last sample or 0.
+    SampleHandler                   m_sampleHandler;         ///< Registered sample handler.
+    std::mutex                      m_mutex;                 ///< Protects the sample handler.
 };
 
 }  // namespace sugo::hal
@@ -66,8 +66,8 @@ void config::addConfigurationOptions(sugo::common::IConfiguration& configuration
     for (const auto& name : {".relay-switch-heater-feeder", ".relay-switch-heater-merger", ".relay-switch-light-power",
         ".relay-switch-light-run", ".relay-switch-light-ready", ".signal-filament-tension-overload", ".signal-button-stop",
         ".signal-filament-tension-low", ".signal-filament-tension-high", ".temperature-sensor-control-cs-merger",
-        ".temperature-sensor-control-cs-feeder", ".motor-control-error", ".motor-control-reset", ".relay-switch-fan-feeder",
-        ".relay-switch-fan-merger"})
+        ".temperature-sensor-control-cs-feeder", ".temperature-sensor-control-drdy-merger", ".temperature-sensor-control-drdy-feeder",
+        ".motor-control-error", ".motor-control-reset", ".relay-switch-fan-feeder", ".relay-switch-fan-merger"})
     {
         configuration.add(common::Option(id::ConfigGpioPin + name + ".pin",         IGpioPin::InvalidPin, "GPIO pin number"));
         configuration.add(common::Option(id::ConfigGpioPin + name + ".direction",   std::string("in"),    "GPIO direction (in, out)"));
@@ -106,6 +106,7 @@ void config::addConfigurationOptions(sugo::common::IConfiguration& configuration
     for (const auto& name : {".temperature-sensor-feeder", ".temperature-sensor-merger"})
     {
         configuration.add(common::Option(id::ConfigTemperatureSensor + name + ".chip-select",  std::string(""), "Chip select pin"));
+        configuration.add(common::Option(id::ConfigTemperatureSensor + name + ".data-ready",   std::string(""), "Data ready pin (optional)"));
     }
     // clang-format on
 }
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Common/Logger.hpp"
+#include "HardwareAbstractionLayer/StepperMotorBase.hpp"
+
+using namespace sugo::hal;
+
+bool StepperMotorBase::rotateToPosition(Position position)
+{
+    std::chrono::milliseconds motionTime(0);
+    if (!startMotionToPosition(position, motionTime))
+    {
+        return false;
+    }
+
+    return waitForMotion(motionTime, false);
+}
+
+bool StepperMotorBase::rotateToPositionAsync(Position position, MotionCompletionHandler handler)
+{
+    std::chrono::milliseconds motionTime(0);
+    if (!startMotionToPosition(position, motionTime))
+    {
+        return false;
+    }
+
+    return startMotionObservation(motionTime, false, std::move(handler));
+}
+
+bool StepperMotorBase::stop(bool stopImmediately)
+{
+    const auto stopTime = initiateStop(stopImmediately);
+    return waitForMotion(stopTime, stopImmediately);
+}
+
+bool StepperMotorBase::stopAsync(bool stopImmediately, MotionCompletionHandler handler)
+{
+    const auto stopTime = initiateStop(stopImmediately);
+    return startMotionObservation(stopTime, stopImmediately, std::move(handler));
+}
+
+bool StepperMotorBase::startMotionObservation(std::chrono::milliseconds motionTime,
+                                              bool stopImmediately, MotionCompletionHandler handler)
+{
+    m_doObserve        = true;
+    const bool started = m_motionObserver.start(
+        [this, motionTime, stopImmediately, handler = std::move(handler)] {
+            const MotionResult result = waitAndShutdown(motionTime, stopImmediately, true);
+            if (handler)
+            {
+                handler(result);
+            }
+        });
+
+    if (!started)
+    {
+        m_doObserve = false;
+        LOG(error) << getId() << ": Failed to start motion observation";
+    }
+
+    return started;
+}
+
+void StepperMotorBase::stopMotionObservation()
+{
+    m_doObserve = false;
+    if (m_motionObserver.isRunning())
+    {
+        m_motionObserver.join();
+    }
+}
+
+std::chrono::milliseconds StepperMotorBase::initiateStop(bool& stopImmediately)
+{
+    stopMotionObservation();
+
+    if (!haltMotion(stopImmediately))
+    {
+        LOG(error) << getId() << ": Failed to stop motor";
+        stopImmediately = true;  // We do not want to wait!
+        return std::chrono::milliseconds(0);
+    }
+
+    return stopImmediately ? std::chrono::milliseconds(0) : getStopTime();
+}
+
+bool StepperMotorBase::waitForMotion(std::chrono::milliseconds motionTime, bool stopImmediately)
+{
+    m_doObserve        = true;
+    const bool success = (waitAndShutdown(motionTime, stopImmediately, false) == MotionSucceeded);
+    m_doObserve        = false;
+    return success;
+}
+
+StepperMotorBase::MotionResult StepperMotorBase::waitAndShutdown(
+    std::chrono::milliseconds remainingMotionTime, bool stopImmediately, bool isAsynchronous)
+{
+    // The expected motion time does not include the ramps, so the motion stop is confirmed.
+    const bool  errorOccurred = !stopImmediately && !waitForMotionTime(remainingMotionTime);
+    MotionState state         = MotionState::Moving;
+    while (m_doObserve)
+    {
+        state = errorOccurred ? MotionState::Failed : getMotionState();
+        if ((state != MotionState::Moving) || stopImmediately)
+        {
+            break;
+        }
+
+        waitForMotionState(isAsynchronous);
+    }
+
+    if (!m_doObserve)
+    {
+        LOG(debug) << getId() << ": Motion observation aborted";
+        return MotionAborted;
+    }
+
+    const bool shutdownSuccess = shutdown();
+
+    if (state == MotionState::Failed)
+    {
+        LOG(error) << getId() << ": Failed to wait for motion stop";
+        return MotionFailed;
+    }
+
+    if (!shutdownSuccess)
+    {
+        LOG(error) << getId() << ": Failed to shutdown motor control";
+        return MotionFailed;
+    }
+
+    return MotionSucceeded;
+}
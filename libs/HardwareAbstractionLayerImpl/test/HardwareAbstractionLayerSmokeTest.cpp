@@ -81,7 +81,8 @@ protected:
                   << " rotated in direction: " << direction << std::endl;
         EXPECT_TRUE(stepperMotor.rotate(direction));
         std::this_thread::sleep_for(std::chrono::seconds(10));
-        EXPECT_NEAR(stepperMotor.getSpeed().getValue(), maxSpeed, 2u);
+        EXPECT_NEAR(stepperMotor.getSpeed().getValue(), maxSpeed * IStepperMotor::MilliRpmPerRpm,
+                    2u * IStepperMotor::MilliRpmPerRpm);
         EXPECT_TRUE(stepperMotor.stop(false));
         std::this_thread::sleep_for(std::chrono::seconds(2));
         EXPECT_EQ(stepperMotor.getSpeed().getValue(), 0);
@@ -162,10 +163,11 @@ TEST_F(HardwareAbstractionLayerSmokeTest, Test_MotorControl)
         EXPECT_TRUE(stepperMotor);
 
         EXPECT_EQ(stepperMotor->getStepsPerRound(), stepsPerRound);
-        EXPECT_EQ(stepperMotor->getMaxSpeed(), defaultMaxSpeed);
+        EXPECT_EQ(stepperMotor->getMaxSpeed().getValue(),
+                  defaultMaxSpeed * IStepperMotor::MilliRpmPerRpm);
         EXPECT_EQ(stepperMotor->getPosition(), 0);
         stepperMotor->setMaxSpeed({maxSpeed, Unit::Rpm});
-        EXPECT_EQ(stepperMotor->getTimePerStep(maxSpeed).count(), timePerStep);
+        EXPECT_EQ(stepperMotor->getTimePerStep({maxSpeed, Unit::Rpm}).count(), timePerStep);
 
         TestRotationTo(*stepperMotor, stepsPerRound);
         TestRotationTo(*stepperMotor, stepsPerRound * 1 / 4);
@@ -192,10 +194,13 @@ TEST_F(HardwareAbstractionLayerSmokeTest, Test_TemperatureSensorControl)
     {
         auto& tempSensor = tempSensorControl->getTemperatureSensorMap().at(sensorName);
         EXPECT_TRUE(tempSensor);
-        const auto temperature = tempSensor->getTemperature();
-        std::cout << "Sensor " << sensorName << " temperature: " << temperature << "°C"
-                  << std::endl;
-        EXPECT_EQ(temperature.getUnit(), Unit::Celcius);
-        EXPECT_NEAR(temperature.getValue(), 25, 10);
+        const auto temperature = ITemperatureSensor::toDeciCelcius(tempSensor->getTemperature());
+        std::cout << "Sensor " << sensorName << " temperature: "
+                  << static_cast<double>(temperature.getValue()) /
+                         ITemperatureSensor::DeciCelciusPerCelcius
+                  << "°C" << std::endl;
+        EXPECT_EQ(temperature.getUnit(), Unit::DeciCelcius);
+        EXPECT_NEAR(temperature.getValue(), 25 * ITemperatureSensor::DeciCelciusPerCelcius,
+                    10 * ITemperatureSensor::DeciCelciusPerCelcius);
     }
 }
\ No newline at end of file
@@ -34,6 +34,7 @@
 #include "Common/Logger.hpp"
 #include "HardwareAbstractionLayer/Configuration.hpp"
 #include "HardwareAbstractionLayer/HardwareAbstractionLayer.hpp"
+#include "HardwareAbstractionLayer/RtdConversion.hpp"
 
 using namespace sugo::hal;
 using namespace sugo;
@@ -228,3 +229,26 @@ TEST_F(HardwareAbstractionLayerTest, IHardwareAbstractionLayer_SetConfiguration)
     HardwareAbstractionLayer hal;
     EXPECT_TRUE(hal.init(config));
 }
+
+TEST_F(HardwareAbstractionLayerTest, RtdConversion_ToTemperature)
+{
+    EXPECT_EQ(rtd::toTemperature(rtd::NominalResistance), 0);
+    EXPECT_EQ(rtd::toTemperature(10039), 10);
+    EXPECT_EQ(rtd::toTemperature(10020), 5);
+    EXPECT_EQ(rtd::toTemperature(17769), 2050);
+    EXPECT_EQ(rtd::toTemperature(17780), 2053);
+    EXPECT_EQ(rtd::toTemperature(19410), 2500);
+    EXPECT_EQ(rtd::toTemperature(7000), -500);
+    EXPECT_FALSE(rtd::toTemperature(19411).has_value());
+
+    // Must be monotonic over the whole range
+    rtd::Temperature lastTemperature = rtd::toTemperature(0).value();
+    for (rtd::Resistance resistance = 0;
+         resistance <= rtd::ResistanceToTemperatureLookUpTable.back().resistance; ++resistance)
+    {
+        const auto temperature = rtd::toTemperature(resistance);
+        ASSERT_TRUE(temperature.has_value());
+        EXPECT_GE(temperature.value(), lastTemperature);
+        lastTemperature = temperature.value();
+    }
+}
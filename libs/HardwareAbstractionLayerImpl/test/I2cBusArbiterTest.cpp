@@ -0,0 +1,298 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <linux/i2c.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common/Logger.hpp"
+#include "HardwareAbstractionLayer/I2cBusArbiter.hpp"
+
+using namespace sugo;
+using namespace sugo::hal;
+
+namespace
+{
+constexpr I2cControl::Address       CoilerAddress  = 0x0e;
+constexpr I2cControl::Address       FeederAddress  = 0x0f;
+constexpr std::chrono::milliseconds QueueDelay{50};  // Time to let a thread queue its batch
+
+/// Fake I2C bus, which records the first byte of each transaction and holds the first one back.
+class FakeI2cBus : public I2cBusArbiter
+{
+public:
+    /// Recorded transaction
+    using Transaction = std::pair<I2cControl::Address, Byte>;
+    using I2cBusArbiter::transfer;
+
+    /// Lets the first transaction continue.
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isReleased = true;
+        m_condition.notify_all();
+    }
+
+    std::vector<Transaction> getTransactions() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_transactions;
+    }
+
+protected:
+    bool transfer(i2c_msg* messages, size_t count) const override
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_isReleased; });
+        for (size_t i = 0; i < count; i += ((messages[i].flags & I2C_M_STOP) != 0) ? 1 : 2)
+        {
+            m_transactions.emplace_back(static_cast<I2cControl::Address>(messages[i].addr),
+                                        static_cast<Byte>(messages[i].buf[0]));
+        }
+        return true;
+    }
+
+private:
+    mutable std::mutex               m_mutex;
+    mutable std::condition_variable  m_condition;
+    mutable std::vector<Transaction> m_transactions;
+    bool                             m_isReleased = false;
+};
+
+ByteBuffer toCommand(unsigned command)
+{
+    return ByteBuffer{static_cast<Byte>(command)};
+}
+}  // namespace
+
+class I2cBusArbiterTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        common::Logger::init();
+    }
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_bus.start());
+    }
+
+    void TearDown() override
+    {
+        m_bus.release();
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+        m_bus.stop();
+    }
+
+    /// Transfers the batch within a new thread and waits until it has been queued.
+    void transferAsync(I2cControl::Batch batch, bool expectedResult = true)
+    {
+        m_threads.emplace_back([this, batch, expectedResult]() mutable {
+            common::Logger::reinit();
+            EXPECT_EQ(m_bus.transfer(batch), expectedResult);
+        });
+        std::this_thread::sleep_for(QueueDelay);
+    }
+
+    FakeI2cBus               m_bus;
+    std::vector<std::thread> m_threads;
+};
+
+TEST_F(I2cBusArbiterTest, Transfer_WithoutArbitration)
+{
+    m_bus.stop();
+    m_bus.release();
+
+    I2cControl::Batch batch(CoilerAddress);
+    batch.write(toCommand(0x85));
+    EXPECT_TRUE(m_bus.transfer(batch));
+    EXPECT_EQ(m_bus.getTransactions(),
+              std::vector<FakeI2cBus::Transaction>({{CoilerAddress, 0x85}}));
+    EXPECT_TRUE(m_bus.getStatistics().empty());
+}
+
+TEST_F(I2cBusArbiterTest, Priority_StopBeforeStatusRead)
+{
+    // Status request of the coiler, which blocks the bus.
+    I2cControl::Batch statusRequest(CoilerAddress);
+    statusRequest.read(toCommand(0xa1), 15)
+        .read(toCommand(0xa2), 15)
+        .read(toCommand(0xa3), 15)
+        .setPriority(I2cControl::Batch::Priority::Low);
+    transferAsync(statusRequest);
+
+    I2cControl::Batch energize(CoilerAddress);
+    energize.write(toCommand(0x85));
+    transferAsync(energize);
+
+    I2cControl::Batch halt(FeederAddress);
+    halt.write(toCommand(0x89)).setPriority(I2cControl::Batch::Priority::High);
+    transferAsync(halt);
+
+    m_bus.release();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+
+    // The status request is transferred within one transaction, so the halt has to wait for it.
+    // Afterwards the halt is transferred before the pending command to the coiler.
+    EXPECT_EQ(m_bus.getTransactions(), std::vector<FakeI2cBus::Transaction>({{CoilerAddress, 0xa1},
+                                                                             {CoilerAddress, 0xa2},
+                                                                             {CoilerAddress, 0xa3},
+                                                                             {FeederAddress, 0x89},
+                                                                             {CoilerAddress, 0x85}}));
+
+    const auto statistics = m_bus.getStatistics();
+    EXPECT_EQ(statistics.at(CoilerAddress).transactions, 2u);
+    EXPECT_EQ(statistics.at(CoilerAddress).commands, 4u);
+    EXPECT_EQ(statistics.at(FeederAddress).transactions, 1u);
+    EXPECT_EQ(statistics.at(FeederAddress).failures, 0u);
+}
+
+TEST_F(I2cBusArbiterTest, Priority_AcrossDevicesOnly)
+{
+    I2cControl::Batch blocker(FeederAddress);
+    blocker.write(toCommand(0x85));
+    transferAsync(blocker);
+
+    I2cControl::Batch statusRequest(CoilerAddress);
+    statusRequest.read(toCommand(0xa1), 15).setPriority(I2cControl::Batch::Priority::Low);
+    transferAsync(statusRequest);
+
+    I2cControl::Batch velocity(FeederAddress);
+    velocity.write(toCommand(0xe3));
+    transferAsync(velocity);
+
+    I2cControl::Batch halt(FeederAddress);
+    halt.write(toCommand(0x89)).setPriority(I2cControl::Batch::Priority::High);
+    transferAsync(halt);
+
+    m_bus.release();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+
+    // The halt does not overtake the earlier velocity command to the same device, but both are
+    // transferred before the status request of the other device.
+    EXPECT_EQ(m_bus.getTransactions(), std::vector<FakeI2cBus::Transaction>({{FeederAddress, 0x85},
+                                                                             {FeederAddress, 0xe3},
+                                                                             {FeederAddress, 0x89},
+                                                                             {CoilerAddress, 0xa1}}));
+}
+
+TEST_F(I2cBusArbiterTest, Order_MultiDeviceBatch)
+{
+    I2cControl::Batch blocker(CoilerAddress);
+    blocker.write(toCommand(0x85));
+    transferAsync(blocker);
+
+    I2cControl::Batch earlier(FeederAddress);
+    earlier.write(toCommand(0x86));
+    transferAsync(earlier);
+
+    I2cControl::Batch velocities(CoilerAddress);
+    velocities.write(toCommand(0xe3)).write(FeederAddress, toCommand(0xe4));
+    transferAsync(velocities);
+
+    I2cControl::Batch later(FeederAddress);
+    later.write(toCommand(0x87));
+    transferAsync(later);
+
+    m_bus.release();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+
+    // The batch is queued for both devices, so it keeps its order to the commands of each device.
+    EXPECT_EQ(m_bus.getTransactions(), std::vector<FakeI2cBus::Transaction>({{CoilerAddress, 0x85},
+                                                                             {FeederAddress, 0x86},
+                                                                             {CoilerAddress, 0xe3},
+                                                                             {FeederAddress, 0xe4},
+                                                                             {FeederAddress, 0x87}}));
+}
+
+TEST_F(I2cBusArbiterTest, Replace_PendingVelocity)
+{
+    I2cControl::Batch blocker(FeederAddress);
+    blocker.write(toCommand(0x85));
+    transferAsync(blocker);
+
+    // Only the latest velocity is transferred, but all callers succeed.
+    for (unsigned velocity : {0x10, 0x20, 0x30})
+    {
+        I2cControl::Batch velocityUpdate(CoilerAddress);
+        velocityUpdate.write(toCommand(velocity)).setReplaceable(true);
+        transferAsync(velocityUpdate);
+    }
+
+    m_bus.release();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+
+    EXPECT_EQ(m_bus.getTransactions(), std::vector<FakeI2cBus::Transaction>(
+                                           {{FeederAddress, 0x85}, {CoilerAddress, 0x30}}));
+    EXPECT_EQ(m_bus.getStatistics().at(CoilerAddress).replaced, 2u);
+    EXPECT_EQ(m_bus.getStatistics().at(CoilerAddress).transactions, 1u);
+}
+
+TEST_F(I2cBusArbiterTest, Stop_FailsPendingBatches)
+{
+    I2cControl::Batch blocker(FeederAddress);
+    blocker.write(toCommand(0x85));
+    transferAsync(blocker);
+
+    I2cControl::Batch pending(CoilerAddress);
+    pending.write(toCommand(0x86));
+    transferAsync(pending, false);
+
+    std::thread stopper([this] {
+        common::Logger::reinit();
+        m_bus.stop();
+    });
+    std::this_thread::sleep_for(QueueDelay);
+    m_bus.release();
+    stopper.join();
+    EXPECT_EQ(m_bus.getTransactions(),
+              std::vector<FakeI2cBus::Transaction>({{FeederAddress, 0x85}}));
+}
@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+
+#include "Common/Configuration.hpp"
+#include "Common/ConfigurationFileParser.hpp"
+#include "Common/Logger.hpp"
+#include "HardwareAbstractionLayer/Configuration.hpp"
+#include "HardwareAbstractionLayer/HardwareAbstractionLayer.hpp"
+#include "HardwareAbstractionLayer/Identifier.hpp"
+#include "HardwareAbstractionLayer/Simulator.hpp"
+
+using namespace sugo;
+using namespace sugo::hal;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr std::chrono::milliseconds MotorTick{10};
+constexpr std::chrono::seconds      MotorTimeout{10};
+constexpr char HalConfigFile[] = "HardwareAbstractionLayerSmokeTestConfig.json";
+
+/// Simulated and real time of one motion phase.
+struct Measurement
+{
+    std::chrono::milliseconds simulatedTime{0};  ///< Simulated time of the phase.
+    std::chrono::microseconds realTime{0};       ///< Real time needed to simulate the phase.
+};
+
+/**
+ * @brief Advances the simulated time in motor ticks until the phase has finished.
+ *
+ * @param isDone Returns true if the phase has finished.
+ * @return The measured times of the phase.
+ */
+Measurement measure(const std::function<bool()>& isDone)
+{
+    auto&      simulator = Simulator::getInstance();
+    const auto startTime = simulator.now();
+    const auto start     = Clock::now();
+    while (!isDone() && ((simulator.now() - startTime) < MotorTimeout))
+    {
+        (void)simulator.advanceTime(MotorTick);
+    }
+    return {std::chrono::duration_cast<std::chrono::milliseconds>(simulator.now() - startTime),
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start)};
+}
+
+/// Prints the measured times of a phase.
+void print(const char* name, const Measurement& measurement)
+{
+    std::cout << name << ": simulated=" << measurement.simulatedTime.count()
+              << "ms, real=" << measurement.realTime.count() << "us" << std::endl;
+}
+}  // namespace
+
+int main()
+{
+    common::Logger::init(common::Logger::Severity::warning);
+
+    std::ifstream inStream(HalConfigFile);
+    if (!inStream.is_open())
+    {
+        std::cerr << "Failed to open " << HalConfigFile << std::endl;
+        return 1;
+    }
+    common::Configuration           configuration;
+    common::ConfigurationFileParser parser(inStream);
+    config::addConfigurationOptions(configuration);
+    parser.add(configuration);
+    if (!parser.parse())
+    {
+        std::cerr << "Failed to parse " << HalConfigFile << std::endl;
+        return 1;
+    }
+
+    auto& simulator = Simulator::getInstance();
+    simulator.enableSimulatedTime(true);
+
+    HardwareAbstractionLayer hal;
+    if (!hal.init(configuration))
+    {
+        std::cerr << "Failed to initialize the hardware abstraction layer" << std::endl;
+        return 1;
+    }
+    auto& motor = *hal.getStepperMotorControllerMap()
+                       .at(id::StepperMotorControl)
+                       ->getStepperMotorMap()
+                       .at(id::StepperMotorFeeder);
+
+    const IStepperMotor::Speed targetSpeed{60u, Unit::Rpm};
+    if (!motor.reset() || !motor.setSpeed(targetSpeed) || !motor.rotate())
+    {
+        std::cerr << "Failed to start the motor" << std::endl;
+        return 1;
+    }
+    print("start to running", measure([&] {
+              return motor.getSpeed() == IStepperMotor::toMilliRpm(targetSpeed);
+          }));
+
+    std::promise<IStepperMotor::MotionResult> stopped;
+    if (!motor.stopAsync(false,
+                         [&](IStepperMotor::MotionResult result) { stopped.set_value(result); }))
+    {
+        std::cerr << "Failed to stop the motor" << std::endl;
+        return 1;
+    }
+    print("ramp down", measure([&] { return motor.getSpeed().getValue() == 0; }));
+    const bool success = (stopped.get_future().get() == IStepperMotor::MotionSucceeded);
+
+    hal.finalize();
+    simulator.enableSimulatedTime(false);
+    return success ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#include "HardwareAbstractionLayer/RtdConversion.hpp"
+
+using namespace sugo::hal;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned Rounds = 100;
+
+/**
+ * @brief Measures the average time of one conversion over the whole table range.
+ *
+ * @param name    Benchmark name.
+ * @param convert Converts a resistance and returns its temperature.
+ */
+template <class ConvertT>
+void runBenchmark(const char* name, ConvertT convert)
+{
+    const auto& table = rtd::ResistanceToTemperatureLookUpTable;
+    const auto  numOfSamples =
+        static_cast<unsigned>(table.back().resistance - table.front().resistance + 1);
+    int64_t    checksum = 0;
+    const auto start    = Clock::now();
+
+    for (unsigned round = 0; round < Rounds; ++round)
+    {
+        for (rtd::Resistance resistance = table.front().resistance;
+             resistance <= table.back().resistance; ++resistance)
+        {
+            checksum += convert(resistance);
+        }
+    }
+
+    const auto duration =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    std::cout << name << ": conversions=" << (Rounds * numOfSamples) << ", perConversion="
+              << (static_cast<double>(duration.count()) / (Rounds * numOfSamples))
+              << "ns, checksum=" << checksum << std::endl;
+}
+}  // namespace
+
+int main()
+{
+    // Former implementation: linear search with whole degrees only.
+    runBenchmark("linear", [](rtd::Resistance resistance) {
+        const auto& table = rtd::ResistanceToTemperatureLookUpTable;
+        const auto  entry = std::find_if(
+            table.cbegin(), table.cend(),
+            [&resistance](const rtd::ResistanceTemperature& resistanceTemperature) {
+                return (resistance <= resistanceTemperature.resistance);
+            });
+        return static_cast<rtd::Temperature>(entry->temperature);
+    });
+
+    runBenchmark("interpolated", [](rtd::Resistance resistance) {
+        return rtd::toTemperature(resistance).value();
+    });
+    return 0;
+}
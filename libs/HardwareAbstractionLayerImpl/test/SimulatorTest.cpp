@@ -0,0 +1,300 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <future>
+
+#include "Common/Configuration.hpp"
+#include "Common/ConfigurationFileParser.hpp"
+#include "Common/Logger.hpp"
+#include "HardwareAbstractionLayer/Configuration.hpp"
+#include "HardwareAbstractionLayer/HardwareAbstractionLayer.hpp"
+#include "HardwareAbstractionLayer/Identifier.hpp"
+#include "HardwareAbstractionLayer/Simulator.hpp"
+#include "HardwareAbstractionLayer/StepperModel.hpp"
+#include "HardwareAbstractionLayer/ThermalModel.hpp"
+
+using namespace sugo;
+using namespace sugo::hal;
+
+namespace
+{
+const ThermalModel::Parameters HeaterModel{25.0, 300.0, 150.0, 8.0, 0.1};
+
+constexpr std::chrono::milliseconds MotorTick{10};
+constexpr std::chrono::seconds      MotorTimeout{10};
+constexpr char HalConfigFile[] = "HardwareAbstractionLayerSmokeTestConfig.json";
+}  // namespace
+
+class SimulatorTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        common::Logger::init();
+    }
+
+    void SetUp() override
+    {
+        m_simulator.registerGpioPin(id::GpioPinRelaySwitchHeaterMerger, IGpioPin::Direction::Out);
+        m_simulator.registerTemperatureSensor(id::TemperatureSensorMerger);
+        m_simulator.enableSimulatedTime(true);
+        ASSERT_TRUE(m_simulator.setThermalModel(id::TemperatureSensorMerger, HeaterModel));
+    }
+
+    void TearDown() override
+    {
+        m_simulator.enableSimulatedTime(false);
+        m_simulator.unregisterTemperatureSensor(id::TemperatureSensorMerger);
+        m_simulator.unregisterGpioPin(id::GpioPinRelaySwitchHeaterMerger);
+    }
+
+    double getTemperature()
+    {
+        return static_cast<double>(ITemperatureSensor::toDeciCelcius(
+                                       m_simulator.getTemperature(id::TemperatureSensorMerger))
+                                       .getValue()) /
+               ITemperatureSensor::DeciCelciusPerCelcius;
+    }
+
+    void switchHeater(bool switchOn)
+    {
+        if (switchOn != m_isHeaterOn)
+        {
+            EXPECT_TRUE(m_simulator.setState(id::GpioPinRelaySwitchHeaterMerger,
+                                             switchOn ? IGpioPin::State::High
+                                                      : IGpioPin::State::Low));
+            m_isHeaterOn = switchOn;
+        }
+    }
+
+    Simulator& m_simulator  = Simulator::getInstance();
+    bool       m_isHeaterOn = false;
+};
+
+TEST_F(SimulatorTest, ThermalModel_StepResponse)
+{
+    const ThermalModel::Parameters parameters{25.0, 200.0, 60.0, 2.0, 0.0};
+    ThermalModel                   model(parameters);
+    model.setHeaterPower(1.0);
+
+    model.advance(ThermalModel::Duration{parameters.deadTime});
+    EXPECT_DOUBLE_EQ(model.getTemperature(), parameters.ambientTemperature);
+
+    // Sub-second steps have to sum up to the exact solution.
+    for (unsigned i = 0; i < 600; ++i)
+    {
+        model.advance(ThermalModel::Duration{0.1});
+    }
+    EXPECT_NEAR(model.getTemperature(),
+                parameters.ambientTemperature + parameters.heaterGain * (1.0 - std::exp(-1.0)),
+                1e-6);
+    EXPECT_DOUBLE_EQ(model.measureTemperature(), model.getTemperature());
+}
+
+TEST_F(SimulatorTest, SimulatedTime)
+{
+    const auto startTime = m_simulator.now();
+    const auto ambient   = getTemperature();
+    EXPECT_NEAR(ambient, HeaterModel.ambientTemperature, 1.0);
+
+    switchHeater(true);
+    EXPECT_NEAR(getTemperature(), ambient, 1.0);
+    EXPECT_TRUE(m_simulator.advanceTime(std::chrono::seconds(60)));
+    EXPECT_EQ(m_simulator.now() - startTime, std::chrono::seconds(60));
+    EXPECT_GT(getTemperature(), ambient + 50.0);
+    switchHeater(false);
+}
+
+TEST_F(SimulatorTest, StepperModel_VelocityRamp)
+{
+    const StepperModel::Parameters parameters{1600.0, 120.0, 240.0, 1.5, 60.0};
+    StepperModel                   model(parameters);
+    model.setTargetVelocity(60.0);
+    model.advance(StepperModel::Duration{1.0});
+    EXPECT_EQ(model.getState().position, 0.0);
+    EXPECT_FALSE(model.getState().isMoving);
+    EXPECT_EQ(model.getState().current, 0.0);
+
+    // Accelerates within 0.5s to 60 RPM, which is a quarter round.
+    ASSERT_TRUE(model.energize());
+    EXPECT_EQ(model.getState().current, parameters.currentLimit);
+    for (unsigned i = 0; i < 25; ++i)
+    {
+        model.advance(StepperModel::Duration{0.01});
+    }
+    EXPECT_NEAR(model.getState().velocity, 30.0, 1e-6);
+    model.advance(StepperModel::Duration{0.25});
+    EXPECT_NEAR(model.getState().velocity, 60.0, 1e-6);
+    EXPECT_NEAR(model.getState().position, 400.0, 1e-3);
+
+    // Back-EMF reduces the current above the corner speed.
+    model.setTargetVelocity(120.0);
+    model.advance(StepperModel::Duration{1.0});
+    EXPECT_NEAR(model.getState().velocity, 120.0, 1e-6);
+    EXPECT_NEAR(model.getState().current, parameters.currentLimit / 2.0, 1e-6);
+
+    // Reverses with the deceleration down to standstill, then with the acceleration.
+    model.setTargetVelocity(-60.0);
+    model.advance(StepperModel::Duration{0.5});
+    EXPECT_NEAR(model.getState().velocity, 0.0, 1e-6);
+    model.advance(StepperModel::Duration{0.25});
+    EXPECT_NEAR(model.getState().velocity, -30.0,
+                parameters.acceleration * StepperModel::ControlPeriod.count() + 1e-6);
+}
+
+TEST_F(SimulatorTest, StepperModel_PositionProfile)
+{
+    const StepperModel::Parameters parameters{1600.0, 120.0, 120.0, 1.5, 60.0};
+    StepperModel                   model(parameters);
+    ASSERT_TRUE(model.energize());
+    model.setTargetPosition(1600.0, 60.0);
+
+    // Trapezoidal profile: 0.5s ramp up, 0.5s at 60 RPM and 0.5s ramp down.
+    double time         = 0.0;
+    double lastPosition = 0.0;
+    double maxVelocity  = 0.0;
+    while (model.getState().isMoving && (time < 10.0))
+    {
+        model.advance(StepperModel::Duration{0.01});
+        time += 0.01;
+        const auto state = model.getState();
+        EXPECT_GE(state.position, lastPosition);
+        EXPECT_LE(state.position, 1600.0);
+        lastPosition = state.position;
+        maxVelocity  = std::max(maxVelocity, state.velocity);
+    }
+    EXPECT_NEAR(time, 1.5, 0.02);
+    EXPECT_EQ(model.getState().position, 1600.0);
+    EXPECT_EQ(model.getState().velocity, 0.0);
+    EXPECT_LE(maxVelocity, 60.0);
+
+    // Short motions do not reach the max speed.
+    model.setTargetPosition(1500.0, 60.0);
+    for (time = 0.0; model.getState().isMoving && (time < 10.0); time += 0.01)
+    {
+        model.advance(StepperModel::Duration{0.01});
+        EXPECT_GE(model.getState().position, 1500.0);
+    }
+    EXPECT_NEAR(time, 2.0 * std::sqrt(100.0 / 1600.0 * 60.0 / 120.0), 0.02);
+    EXPECT_EQ(model.getState().position, 1500.0);
+}
+
+TEST_F(SimulatorTest, StepperModel_ErrorInjection)
+{
+    StepperModel model;
+    ASSERT_TRUE(model.energize());
+    model.setTargetVelocity(60.0);
+    model.advance(StepperModel::Duration{1.0});
+    ASSERT_TRUE(model.getState().isMoving);
+
+    // An error stops abruptly and prevents energizing, until it is cleared.
+    model.injectError(0x02);
+    auto state = model.getState();
+    EXPECT_EQ(state.errorFlags, 0x02u);
+    EXPECT_EQ(state.velocity, 0.0);
+    EXPECT_FALSE(state.isEnergized);
+    EXPECT_FALSE(state.isMoving);
+    EXPECT_EQ(state.current, 0.0);
+    EXPECT_FALSE(model.energize());
+
+    model.clearErrors();
+    EXPECT_TRUE(model.energize());
+    EXPECT_EQ(model.getState().errorFlags, 0u);
+}
+
+TEST_F(SimulatorTest, StepperMotor_SimulatedMotion)
+{
+    std::ifstream inStream(HalConfigFile);
+    ASSERT_TRUE(inStream.is_open());
+    common::Configuration           configuration;
+    common::ConfigurationFileParser parser(inStream);
+    config::addConfigurationOptions(configuration);
+    parser.add(configuration);
+    ASSERT_TRUE(parser.parse());
+
+    HardwareAbstractionLayer hal;
+    ASSERT_TRUE(hal.init(configuration));
+    auto& motor = *hal.getStepperMotorControllerMap()
+                       .at(id::StepperMotorControl)
+                       ->getStepperMotorMap()
+                       .at(id::StepperMotorFeeder);
+    const auto waitFor = [&](const std::function<bool()>& isDone) {
+        const auto startTime = m_simulator.now();
+        while (!isDone() && ((m_simulator.now() - startTime) < MotorTimeout))
+        {
+            EXPECT_TRUE(m_simulator.advanceTime(MotorTick));
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(m_simulator.now() -
+                                                                     startTime);
+    };
+
+    const IStepperMotor::Speed targetSpeed{60u, Unit::Rpm};
+    ASSERT_TRUE(motor.reset());
+    ASSERT_TRUE(motor.setSpeed(targetSpeed));
+    ASSERT_TRUE(motor.rotate());
+    const auto startToRunning =
+        waitFor([&] { return motor.getSpeed() == IStepperMotor::toMilliRpm(targetSpeed); });
+    EXPECT_NEAR(startToRunning.count(), 500, 2 * MotorTick.count());
+    EXPECT_DOUBLE_EQ(m_simulator.getStepperMotorState(id::StepperMotorFeeder).current, 1.5);
+
+    // The asynchronous stop finishes with the simulated ramp down.
+    std::promise<IStepperMotor::MotionResult> stopped;
+    ASSERT_TRUE(motor.stopAsync(
+        false, [&](IStepperMotor::MotionResult result) { stopped.set_value(result); }));
+    const auto rampDown = waitFor([&] { return motor.getSpeed().getValue() == 0; });
+    EXPECT_NEAR(rampDown.count(), 500, 2 * MotorTick.count());
+    EXPECT_EQ(stopped.get_future().get(), IStepperMotor::MotionSucceeded);
+
+    // The synchronous stop advances the simulated time by itself.
+    ASSERT_TRUE(motor.rotate());
+    (void)waitFor([&] { return motor.getSpeed() == IStepperMotor::toMilliRpm(targetSpeed); });
+    const auto stopTime = m_simulator.now();
+    EXPECT_TRUE(motor.stop(false));
+    EXPECT_EQ(motor.getSpeed().getValue(), 0u);
+    EXPECT_NEAR(std::chrono::duration_cast<std::chrono::milliseconds>(m_simulator.now() - stopTime)
+                    .count(),
+                500, 2 * MotorTick.count());
+
+    // Injected errors stop the motor abruptly until it is reset.
+    ASSERT_TRUE(motor.rotate());
+    (void)waitFor([&] { return motor.getSpeed().getValue() > 0; });
+    ASSERT_TRUE(m_simulator.injectStepperMotorError(id::StepperMotorFeeder, 0x02));
+    IStepperMotor::Telemetry telemetry;
+    ASSERT_TRUE(motor.getTelemetry(telemetry));
+    EXPECT_EQ(telemetry.errorFlags, 0x02u);
+    EXPECT_EQ(telemetry.velocity, 0);
+    EXPECT_FALSE(telemetry.isEnergized);
+    EXPECT_FALSE(motor.rotate());
+    EXPECT_TRUE(motor.reset());
+    EXPECT_TRUE(motor.rotate());
+    EXPECT_TRUE(motor.stop(true));
+}
@@ -0,0 +1,271 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Common/Configuration.hpp"
+#include "Common/Logger.hpp"
+#include "HardwareAbstractionLayer/IGpioPinMock.hpp"
+#include "HardwareAbstractionLayer/Identifier.hpp"
+#include "HardwareAbstractionLayer/SpiControl.hpp"
+#include "HardwareAbstractionLayer/TemperatureSensor.hpp"
+
+using namespace sugo;
+using namespace sugo::hal;
+using namespace ::testing;
+
+namespace
+{
+constexpr char                      ChipSelectPin[] = "chip-select-temperature";
+constexpr char                      DataReadyPin[]  = "data-ready-temperature";
+constexpr std::chrono::milliseconds ConversionTime{20};
+constexpr std::chrono::milliseconds MaxWaitTime{1000};
+
+/// Fake SPI device, which emulates the registers of a MAX31865.
+class FakeMax31865 : public SpiControl
+{
+public:
+    /// Starts or ends a register transaction by the chip-select pin.
+    void select(bool isSelected)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isAddress = isSelected;
+    }
+
+    /// Sets the ADC code of the RTD resistance.
+    void setAdcCode(uint16_t adcCode)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Note: Bit 0 of the LSB is the fault bit!
+        m_registers[RtdMsb] = static_cast<uint8_t>((adcCode << 1u) >> 8u);
+        m_registers[RtdLsb] = static_cast<uint8_t>((adcCode << 1u) & 0xffu);
+    }
+
+    /// Sets the fault bit of the RTD register, so the conversion fails.
+    void setFault()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_registers[RtdLsb] |= 0x01u;
+    }
+
+    /// Returns the number of transferred bytes.
+    size_t getTransferCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_transferCount;
+    }
+
+    uint8_t writeByte(uint8_t buf) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_transferCount;
+        if (m_isAddress)
+        {
+            m_isAddress = false;
+            m_isWrite   = (buf & WriteMask) != 0;
+            m_register  = buf & ~WriteMask;
+            return 0;
+        }
+
+        const size_t index = m_register++ % m_registers.size();
+        if (m_isWrite)
+        {
+            // The fault status clear bit is self-clearing.
+            m_registers[index] = (index == Config) ? (buf & ~FaultStatusClear) : buf;
+            return 0;
+        }
+        return m_registers[index];
+    }
+
+private:
+    static constexpr uint8_t WriteMask        = 0x80u;
+    static constexpr uint8_t FaultStatusClear = 0x02u;
+    static constexpr size_t  Config           = 0;
+    static constexpr size_t  RtdMsb           = 1;
+    static constexpr size_t  RtdLsb           = 2;
+
+    std::mutex             m_mutex;
+    std::array<uint8_t, 8> m_registers{};
+    bool                   m_isAddress     = false;
+    bool                   m_isWrite       = false;
+    uint8_t                m_register      = 0;
+    size_t                 m_transferCount = 0;
+};
+}  // namespace
+
+class TemperatureSensorTest : public ::testing::Test
+{
+protected:
+    TemperatureSensorTest()
+        : m_chipSelect(std::make_shared<NiceMock<IGpioPinMock>>(ChipSelectPin)),
+          m_dataReady(std::make_shared<NiceMock<IGpioPinMock>>(DataReadyPin))
+    {
+    }
+
+    static void SetUpTestCase()
+    {
+        common::Logger::init();
+    }
+
+    void SetUp() override
+    {
+        m_gpioPins.emplace(ChipSelectPin, m_chipSelect);
+        m_gpioPins.emplace(DataReadyPin, m_dataReady);
+
+        ON_CALL(*m_chipSelect, setState(_)).WillByDefault([this](IGpioPin::State state) {
+            m_spi.select(state == IGpioPin::State::High);
+            return true;
+        });
+        ON_CALL(*m_dataReady, getDirection()).WillByDefault(Return(IGpioPin::Direction::In));
+        ON_CALL(*m_dataReady, getState()).WillByDefault(Return(IGpioPin::State::Low));
+        ON_CALL(*m_dataReady, waitForEvent(_)).WillByDefault([this](std::chrono::nanoseconds) {
+            std::this_thread::sleep_for(ConversionTime);
+            return IGpioPin::Event{std::chrono::nanoseconds(0),
+                                   m_isConverting ? IGpioPin::EventType::RisingEdge
+                                                  : IGpioPin::EventType::Timeout};
+        });
+
+        // Resistance of about 100 Ohm, which is 0°C
+        m_spi.setAdcCode(7620);
+    }
+
+    FakeMax31865                            m_spi;
+    std::shared_ptr<NiceMock<IGpioPinMock>> m_chipSelect;
+    std::shared_ptr<NiceMock<IGpioPinMock>> m_dataReady;
+    IGpioControl::GpioPinMap                m_gpioPins;
+    std::atomic_bool                        m_isConverting{true};
+};
+
+TEST_F(TemperatureSensorTest, DataReadyPublishesSamples)
+{
+    TemperatureSensor     sensor("temperature", m_spi, m_gpioPins);
+    common::Configuration configuration{
+        common::Option(id::ChipSelect, std::string(ChipSelectPin), ""),
+        common::Option(id::DataReady, std::string(DataReadyPin), "")};
+    ASSERT_TRUE(sensor.init(configuration));
+
+    std::mutex                         mutex;
+    std::condition_variable            condition;
+    unsigned                           sampleCount = 0;
+    ITemperatureSensor::RawTemperature lastSample  = 0;
+    ASSERT_TRUE(sensor.registerSampleHandler([&](const ITemperatureSensor::Temperature& sample) {
+        std::lock_guard<std::mutex> lock(mutex);
+        lastSample = sample.getValue();
+        ++sampleCount;
+        condition.notify_all();
+    }));
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(condition.wait_for(lock, MaxWaitTime, [&] { return sampleCount >= 2; }));
+        EXPECT_NEAR(lastSample, 0, 1);
+    }
+
+    EXPECT_EQ(sensor.getTemperature().getUnit(), Unit::DeciCelcius);
+    EXPECT_NEAR(sensor.getTemperature().getValue(), 0, 1);
+    EXPECT_TRUE(sensor.registerSampleHandler(nullptr));
+}
+
+TEST_F(TemperatureSensorTest, DataReadyStaleSample)
+{
+    TemperatureSensor     sensor("temperature", m_spi, m_gpioPins);
+    common::Configuration configuration{
+        common::Option(id::ChipSelect, std::string(ChipSelectPin), ""),
+        common::Option(id::DataReady, std::string(DataReadyPin), "")};
+    ASSERT_TRUE(sensor.init(configuration));
+    std::this_thread::sleep_for(2 * ConversionTime);
+    EXPECT_NEAR(sensor.getTemperature().getValue(), 0, 1);
+
+    // No further conversions, the last sample must not be reported forever.
+    m_isConverting = false;
+    std::this_thread::sleep_for(20 * ConversionTime);
+    EXPECT_EQ(sensor.getTemperature().getValue(),
+              std::numeric_limits<ITemperatureSensor::RawTemperature>::min());
+
+    m_isConverting = true;
+    std::this_thread::sleep_for(2 * ConversionTime);
+    EXPECT_NEAR(sensor.getTemperature().getValue(), 0, 1);
+}
+
+TEST_F(TemperatureSensorTest, DataReadyFailedSample)
+{
+    TemperatureSensor     sensor("temperature", m_spi, m_gpioPins);
+    common::Configuration configuration{
+        common::Option(id::ChipSelect, std::string(ChipSelectPin), ""),
+        common::Option(id::DataReady, std::string(DataReadyPin), "")};
+    m_isConverting = false;
+    ASSERT_TRUE(sensor.init(configuration));
+
+    // The sensor is only read by the data-ready observer, even if there is no sample yet.
+    const size_t transferCount = m_spi.getTransferCount();
+    EXPECT_EQ(sensor.getTemperature().getValue(),
+              std::numeric_limits<ITemperatureSensor::RawTemperature>::min());
+    EXPECT_EQ(m_spi.getTransferCount(), transferCount);
+
+    std::mutex              mutex;
+    std::condition_variable condition;
+    unsigned                sampleCount = 0;
+    ASSERT_TRUE(sensor.registerSampleHandler([&](const ITemperatureSensor::Temperature&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++sampleCount;
+        condition.notify_all();
+    }));
+    m_spi.setFault();
+    m_isConverting = true;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(condition.wait_for(lock, MaxWaitTime, [&] { return sampleCount >= 1; }));
+    }
+
+    // A failed conversion is reported as published and not taken as missing sample.
+    m_isConverting = false;
+    std::this_thread::sleep_for(2 * ConversionTime);
+    const size_t observedTransferCount = m_spi.getTransferCount();
+    EXPECT_EQ(sensor.getTemperature().getValue(),
+              std::numeric_limits<ITemperatureSensor::RawTemperature>::min());
+    EXPECT_EQ(m_spi.getTransferCount(), observedTransferCount);
+}
+
+TEST_F(TemperatureSensorTest, NoDataReadyIsPolled)
+{
+    TemperatureSensor     sensor("temperature", m_spi, m_gpioPins);
+    common::Configuration configuration{
+        common::Option(id::ChipSelect, std::string(ChipSelectPin), ""),
+        common::Option(id::DataReady, std::string(""), "")};
+    ASSERT_TRUE(sensor.init(configuration));
+    EXPECT_FALSE(sensor.registerSampleHandler([](const ITemperatureSensor::Temperature&) {}));
+    EXPECT_CALL(*m_dataReady, waitForEvent(_)).Times(0);
+    EXPECT_NEAR(sensor.getTemperature().getValue(), 0, 1);
+}
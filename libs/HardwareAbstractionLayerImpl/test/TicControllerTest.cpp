@@ -0,0 +1,615 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <linux/i2c.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <future>
+#include <initializer_list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/Configuration.hpp"
+#include "Common/Logger.hpp"
+#include "HardwareAbstractionLayer/I2cControl.hpp"
+#include "HardwareAbstractionLayer/IGpioPinMock.hpp"
+#include "HardwareAbstractionLayer/Identifier.hpp"
+#include "HardwareAbstractionLayer/StepperMotor.hpp"
+#include "HardwareAbstractionLayer/StepperMotorGroup.hpp"
+#include "HardwareAbstractionLayer/TicController.hpp"
+
+using namespace sugo;
+using namespace sugo::hal;
+using namespace ::testing;
+
+namespace
+{
+constexpr I2cControl::Address       TicAddress       = 0x0e;
+constexpr I2cControl::Address       SecondTicAddress = 0x0f;
+constexpr std::chrono::microseconds BitTime{10};  // 100 kHz bus clock
+
+ByteBuffer toBytes(std::initializer_list<unsigned> values)
+{
+    ByteBuffer buffer;
+    std::transform(values.begin(), values.end(), std::back_inserter(buffer),
+                   [](unsigned value) { return static_cast<Byte>(value); });
+    return buffer;
+}
+
+/// Fake I2C device, which records all transactions and answers the variable reads of a Tic.
+class FakeI2cDevice : public I2cControl
+{
+public:
+    /// Recorded I2C message
+    struct Message
+    {
+        I2cControl::Address address;
+        uint16_t            flags;
+        ByteBuffer          data;
+    };
+
+    using Transaction = std::vector<Message>;
+    using I2cControl::transfer;
+
+    void setVariable(size_t offset, uint32_t value, size_t size = sizeof(uint32_t))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < size; ++i)
+        {
+            m_variables[offset + i] = static_cast<Byte>(value >> (i * 8u) & 0xff);
+        }
+    }
+
+    /// @warning Not synchronized with transactions of other threads.
+    const std::vector<Transaction>& getTransactions() const
+    {
+        return m_transactions;
+    }
+
+    /// Returns the time the bus has been busy with all transactions.
+    std::chrono::microseconds getBusTime() const
+    {
+        return m_busTime;
+    }
+
+protected:
+    bool transfer(i2c_msg* messages, size_t count) const override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Transaction                 transaction;
+        for (size_t i = 0; i < count; ++i)
+        {
+            Byte* data = reinterpret_cast<Byte*>(messages[i].buf);
+            if (((messages[i].flags & I2C_M_RD) != 0) && !transaction.empty())
+            {
+                // Block read of the variables at the offset of the preceding command.
+                const size_t offset = static_cast<size_t>(transaction.back().data.at(1));
+                std::copy_n(m_variables.begin() + offset, messages[i].len, data);
+            }
+            else if ((messages[i].flags & I2C_M_RD) == 0)
+            {
+                applySetting(ByteBuffer(data, data + messages[i].len));
+            }
+            transaction.push_back(
+                {static_cast<I2cControl::Address>(messages[i].addr), messages[i].flags,
+                 ByteBuffer(data, data + messages[i].len)});
+            // Start and stop condition, address and data bytes with acknowledge bit
+            m_busTime += BitTime * (2u + 9u * (1u + messages[i].len));
+        }
+        m_transactions.push_back(transaction);
+        return true;
+    }
+
+private:
+    /// Reflects written 32-bit settings in the variables, like the controller does.
+    void applySetting(const ByteBuffer& command) const
+    {
+        static const std::map<Byte, size_t> settingOffsets = {
+            {0xe5, 0x12}, {0xe6, 0x16}, {0xe9, 0x1a}, {0xea, 0x1e}};
+        const auto setting = command.empty() ? settingOffsets.end()
+                                             : settingOffsets.find(command.front());
+        if ((setting != settingOffsets.end()) && (command.size() == 1u + sizeof(uint32_t)))
+        {
+            std::copy(command.begin() + 1, command.end(), m_variables.begin() + setting->second);
+        }
+    }
+
+    mutable std::mutex                m_mutex;
+    mutable std::array<Byte, 0x80>    m_variables{};
+    mutable std::vector<Transaction>  m_transactions;
+    mutable std::chrono::microseconds m_busTime{0};
+};
+}  // namespace
+
+class TicControllerTest : public ::testing::Test
+{
+protected:
+    static std::vector<ByteBuffer> getCommands(const FakeI2cDevice::Transaction& transaction)
+    {
+        std::vector<ByteBuffer> commands;
+        for (const auto& message : transaction)
+        {
+            if ((message.flags & I2C_M_RD) == 0)
+            {
+                commands.push_back(message.data);
+            }
+        }
+        return commands;
+    }
+
+    TicControllerTest() : m_ioErr("motor-control-error"), m_ioRst("motor-control-reset")
+    {
+    }
+
+    static void SetUpTestCase()
+    {
+        common::Logger::init();
+    }
+
+    FakeI2cDevice          m_device;
+    NiceMock<IGpioPinMock> m_ioErr;
+    NiceMock<IGpioPinMock> m_ioRst;
+    TicController          m_controller{TicAddress, m_device, m_ioErr, m_ioRst};
+    StepperMotorGroup      m_motorGroup{m_device};
+};
+
+TEST_F(TicControllerTest, Batch_CombinedTransaction)
+{
+    m_device.setVariable(0x02, 0xbeef, sizeof(uint16_t));
+
+    I2cControl::Batch batch(TicAddress);
+    batch.write(toBytes({0x85})).read(toBytes({0xa1, 0x02}), 2).write(toBytes({0x83}));
+    EXPECT_EQ(batch.getMessageCount(), 4u);
+    ASSERT_TRUE(m_device.transfer(batch));
+
+    ASSERT_EQ(m_device.getTransactions().size(), 1u);
+    const auto& messages = m_device.getTransactions().front();
+    ASSERT_EQ(messages.size(), 4u);
+    for (const auto& message : messages)
+    {
+        EXPECT_EQ(message.address, TicAddress);
+    }
+    EXPECT_EQ(messages[0].flags, I2C_M_STOP);
+    EXPECT_EQ(messages[0].data, toBytes({0x85}));
+    EXPECT_EQ(messages[1].flags, 0);
+    EXPECT_EQ(messages[1].data, toBytes({0xa1, 0x02}));
+    EXPECT_EQ(messages[2].flags, I2C_M_RD | I2C_M_STOP);
+    EXPECT_EQ(messages[3].data, toBytes({0x83}));
+    EXPECT_EQ(batch.getResponse(0), toBytes({0xef, 0xbe}));
+}
+
+TEST_F(TicControllerTest, GetState_SingleTransaction)
+{
+    m_device.setVariable(0x00, TicController::OperationState::Normal, sizeof(uint8_t));
+    m_device.setVariable(0x01, TicController::StateFlags::Energized, sizeof(uint8_t));
+    m_device.setVariable(0x22, static_cast<uint32_t>(-1234));
+    m_device.setVariable(0x26, 50000);
+
+    TicController::State state;
+    ASSERT_TRUE(m_controller.getState(state));
+    EXPECT_EQ(state.operationState, TicController::OperationState::Normal);
+    EXPECT_TRUE(state.isEnergized());
+    EXPECT_EQ(state.currentPosition, -1234);
+    EXPECT_EQ(state.currentVelocity, 50000);
+
+    // The whole variable region is requested block by block, but within one transaction.
+    ASSERT_EQ(m_device.getTransactions().size(), 1u);
+    const auto& messages = m_device.getTransactions().front();
+    ASSERT_EQ(messages.size(), 6u);
+    EXPECT_EQ(messages[0].data, toBytes({0xa1, 0x00}));
+    EXPECT_EQ(messages[2].data, toBytes({0xa1, 0x0f}));
+    EXPECT_EQ(messages[4].data, toBytes({0xa1, 0x1e}));
+    EXPECT_EQ(messages[1].data.size() + messages[3].data.size() + messages[5].data.size(),
+              sizeof(TicController::State));
+}
+
+TEST_F(TicControllerTest, GetState_Cached)
+{
+    TicController::State state;
+    ASSERT_TRUE(m_controller.getState(state, std::chrono::seconds(1)));
+    ASSERT_TRUE(m_controller.getState(state, std::chrono::seconds(1)));
+    EXPECT_EQ(m_device.getTransactions().size(), 1u);
+
+    // Commands invalidate the cached state.
+    ASSERT_TRUE(m_controller.setTargetVelocity(0));
+    ASSERT_TRUE(m_controller.getState(state, std::chrono::seconds(1)));
+    EXPECT_EQ(m_device.getTransactions().size(), 3u);
+}
+
+TEST_F(TicControllerTest, PrepareAndRotate_ByteSequence)
+{
+    TicController::MotionSettings settings;
+    settings.stepMode     = TicController::StepMode::Step1_8;
+    settings.maxSpeed     = 0x01020304;
+    settings.currentLimit = 1500;
+    ASSERT_TRUE(m_controller.prepareAndRotate(settings, -2));
+
+    ASSERT_EQ(m_device.getTransactions().size(), 1u);
+    const auto              commands = getCommands(m_device.getTransactions().front());
+    const std::vector<ByteBuffer> expectedCommands = {
+        toBytes({0x94, 0x03}),                    // Set step mode
+        toBytes({0xe6, 0x04, 0x03, 0x02, 0x01}),  // Set max speed
+        toBytes({0x91, 1500 / 40}),               // Set current limit
+        toBytes({0xa2, 0x00}),                    // Get variable and clear errors
+        toBytes({0x83}),                          // Exit safe start
+        toBytes({0x85}),                          // Energize
+        toBytes({0xe3, 0xfe, 0xff, 0xff, 0xff}),  // Set target velocity
+    };
+    EXPECT_EQ(commands, expectedCommands);
+}
+
+TEST_F(TicControllerTest, PrepareAndRotate_WritesOnlyChangedSettings)
+{
+    m_device.setVariable(0x00, TicController::OperationState::Normal, sizeof(uint8_t));
+
+    TicController::MotionSettings settings;
+    settings.maxSpeed     = 1000;
+    settings.currentLimit = 1500;
+    ASSERT_TRUE(m_controller.prepareAndRotate(settings, 100));
+    EXPECT_EQ(getCommands(m_device.getTransactions().back()).size(), 7u);
+
+    // Unchanged settings are skipped
+    ASSERT_TRUE(m_controller.prepareAndRotate(settings, 100));
+    EXPECT_EQ(getCommands(m_device.getTransactions().back()).size(), 4u);
+    ASSERT_TRUE(m_controller.setMaxSpeed(settings.maxSpeed));
+    EXPECT_EQ(m_device.getTransactions().size(), 2u);
+
+    settings.maxSpeed = 2000;
+    ASSERT_TRUE(m_controller.prepareAndRotate(settings, 100));
+    EXPECT_EQ(getCommands(m_device.getTransactions().back()).front(),
+              toBytes({0xe6, 0xd0, 0x07, 0x00, 0x00}));
+    EXPECT_EQ(getCommands(m_device.getTransactions().back()).size(), 5u);
+
+    // A reset restores the settings from the non-volatile memory
+    ASSERT_TRUE(m_controller.reset());
+    ASSERT_TRUE(m_controller.prepareAndRotate(settings, 100));
+    EXPECT_EQ(getCommands(m_device.getTransactions().back()).size(), 7u);
+
+    // Expected errors of a stopped motor keep the settings, others not
+    TicController::State state;
+    m_device.setVariable(0x02,
+                         TicController::ErrorStatus::IntentionallyDeEnergized |
+                             TicController::ErrorStatus::SafeStartViolation,
+                         sizeof(uint16_t));
+    ASSERT_TRUE(m_controller.getState(state));
+    ASSERT_TRUE(m_controller.prepareAndRotate(settings, 100));
+    EXPECT_EQ(getCommands(m_device.getTransactions().back()).size(), 4u);
+
+    m_device.setVariable(0x02, TicController::ErrorStatus::LowVin, sizeof(uint16_t));
+    ASSERT_TRUE(m_controller.getState(state));
+    ASSERT_TRUE(m_controller.prepareAndRotate(settings, 100));
+    EXPECT_EQ(getCommands(m_device.getTransactions().back()).size(), 7u);
+}
+
+TEST_F(TicControllerTest, PrepareAndRotate_SettingsMismatch)
+{
+    m_device.setVariable(0x00, TicController::OperationState::Normal, sizeof(uint8_t));
+
+    TicController::MotionSettings settings;
+    settings.maxSpeed     = 1000;
+    settings.currentLimit = 1500;
+    ASSERT_TRUE(m_controller.setMaxAcceleration(500));
+    ASSERT_TRUE(m_controller.prepareAndRotate(settings, 100));
+
+    // Settings read back from the controller keep the shadow
+    TicController::State state;
+    ASSERT_TRUE(m_controller.getState(state));
+    EXPECT_EQ(state.maxSpeed, settings.maxSpeed);
+    EXPECT_EQ(state.maxAcceleration, 500u);
+    ASSERT_TRUE(m_controller.prepareAndRotate(settings, 100));
+    EXPECT_EQ(getCommands(m_device.getTransactions().back()).size(), 4u);
+
+    // A setting changed behind the back of the controller invalidates the shadow
+    m_device.setVariable(0x1e, 800);
+    ASSERT_TRUE(m_controller.getState(state));
+    ASSERT_TRUE(m_controller.prepareAndRotate(settings, 100));
+    EXPECT_EQ(getCommands(m_device.getTransactions().back()).size(), 7u);
+    const auto transactionCount = m_device.getTransactions().size();
+    ASSERT_TRUE(m_controller.setMaxAcceleration(500));
+    EXPECT_EQ(m_device.getTransactions().size(), transactionCount + 1u);
+}
+
+TEST_F(TicControllerTest, PrepareAndRotate_RestartBusTime)
+{
+    constexpr unsigned Cycles = 20;
+    m_device.setVariable(0x00, TicController::OperationState::Normal, sizeof(uint8_t));
+
+    TicController::MotionSettings settings;
+    settings.maxSpeed     = 2000000;
+    settings.currentLimit = 1500;
+
+    // Coil motor started and stopped repeatedly like by the stepper motor.
+    std::vector<std::chrono::microseconds> startTimes;
+    for (unsigned cycle = 0; cycle < Cycles; ++cycle)
+    {
+        TicController::State state;
+        const auto           startBusTime = m_device.getBusTime();
+        ASSERT_TRUE(m_controller.getState(state));
+        ASSERT_TRUE(m_controller.prepareAndRotate(settings, 1000000));
+        startTimes.push_back(m_device.getBusTime() - startBusTime);
+
+        ASSERT_TRUE(m_controller.setTargetVelocity(0));
+        ASSERT_TRUE(m_controller.getState(state));
+        ASSERT_TRUE(m_controller.deEnergize());
+        ASSERT_TRUE(m_controller.enterSafeStart());
+        m_device.setVariable(0x02,
+                             TicController::ErrorStatus::IntentionallyDeEnergized |
+                                 TicController::ErrorStatus::SafeStartViolation,
+                             sizeof(uint16_t));
+    }
+
+    // Only the first start has to write all motion settings, restarts use the shadow values.
+    for (unsigned cycle = 1; cycle < Cycles; ++cycle)
+    {
+        EXPECT_LT(startTimes[cycle], startTimes.front()) << "cycle " << cycle;
+    }
+}
+
+TEST_F(TicControllerTest, StepperMotor_StopAsync)
+{
+    constexpr std::chrono::milliseconds StopTime{100};
+    m_device.setVariable(0x00, TicController::OperationState::Normal, sizeof(uint8_t));
+
+    common::Configuration configuration{
+        common::Option(id::I2cAddress, static_cast<unsigned>(TicAddress), ""),
+        common::Option(id::MaxSpeedRpm, 100u, ""),
+        common::Option(id::Direction, std::string("forward"), "")};
+    StepperMotor motor("test-motor", m_device, m_motorGroup, m_ioErr, m_ioRst);
+    ASSERT_TRUE(motor.init(configuration));
+
+    // Ramp down time is velocity * 10 / deceleration in ms.
+    m_device.setVariable(0x1a, 10000);
+    m_device.setVariable(0x26, 10000 * StopTime.count() / 10);
+    ON_CALL(m_ioErr, waitForEvent(_)).WillByDefault([](std::chrono::nanoseconds timeout) {
+        std::this_thread::sleep_for(timeout);
+        return IGpioPin::Event{};
+    });
+
+    std::promise<IStepperMotor::MotionResult> completion;
+    const auto                                startTime = std::chrono::steady_clock::now();
+    ASSERT_TRUE(motor.stopAsync(
+        false, [&](IStepperMotor::MotionResult result) { completion.set_value(result); }));
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, StopTime);
+
+    auto result = completion.get_future();
+    EXPECT_EQ(result.wait_for(StopTime / 2), std::future_status::timeout);
+    m_device.setVariable(0x26, 0);
+    ASSERT_EQ(result.wait_for(StopTime * 2), std::future_status::ready);
+    EXPECT_EQ(result.get(), IStepperMotor::MotionSucceeded);
+}
+
+TEST_F(TicControllerTest, StepperMotor_StopAsyncAborted)
+{
+    m_device.setVariable(0x00, TicController::OperationState::Normal, sizeof(uint8_t));
+
+    common::Configuration configuration{
+        common::Option(id::I2cAddress, static_cast<unsigned>(TicAddress), ""),
+        common::Option(id::MaxSpeedRpm, 100u, ""),
+        common::Option(id::Direction, std::string("forward"), "")};
+    StepperMotor motor("test-motor", m_device, m_motorGroup, m_ioErr, m_ioRst);
+    ASSERT_TRUE(motor.init(configuration));
+
+    m_device.setVariable(0x1a, 1);
+    m_device.setVariable(0x26, 10000);
+    ON_CALL(m_ioErr, waitForEvent(_)).WillByDefault([](std::chrono::nanoseconds timeout) {
+        std::this_thread::sleep_for(timeout);
+        return IGpioPin::Event{};
+    });
+
+    // A further stop aborts the observation of the former one.
+    std::promise<IStepperMotor::MotionResult> aborted;
+    ASSERT_TRUE(motor.stopAsync(
+        false, [&](IStepperMotor::MotionResult result) { aborted.set_value(result); }));
+    std::promise<IStepperMotor::MotionResult> completion;
+    ASSERT_TRUE(motor.stopAsync(
+        true, [&](IStepperMotor::MotionResult result) { completion.set_value(result); }));
+
+    auto result = aborted.get_future();
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(result.get(), IStepperMotor::MotionAborted);
+    result = completion.get_future();
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(result.get(), IStepperMotor::MotionSucceeded);
+}
+
+TEST_F(TicControllerTest, StepperMotor_StopAsyncErrorLine)
+{
+    constexpr std::chrono::milliseconds StopTime{100};
+    m_device.setVariable(0x00, TicController::OperationState::Normal, sizeof(uint8_t));
+
+    common::Configuration configuration{
+        common::Option(id::I2cAddress, static_cast<unsigned>(TicAddress), ""),
+        common::Option(id::MaxSpeedRpm, 100u, ""),
+        common::Option(id::Direction, std::string("forward"), "")};
+    StepperMotor motor("test-motor", m_device, m_motorGroup, m_ioErr, m_ioRst);
+    ASSERT_TRUE(motor.init(configuration));
+
+    // Each wait for an error is answered by an edge, but pending edges are discarded before.
+    m_device.setVariable(0x1a, 10000);
+    m_device.setVariable(0x26, 10000 * StopTime.count() / 10);
+    ON_CALL(m_ioErr, waitForEvent(_)).WillByDefault([](std::chrono::nanoseconds timeout) {
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, BitTime));
+        return IGpioPin::Event{std::chrono::nanoseconds(0), (timeout.count() == 0)
+                                                                ? IGpioPin::EventType::Timeout
+                                                                : IGpioPin::EventType::RisingEdge};
+    });
+
+    // The error line driven by another controller does not stop the observation.
+    m_device.setVariable(0x02, TicController::ErrorStatus::ErrLineHigh, sizeof(uint16_t));
+    std::promise<IStepperMotor::MotionResult> completion;
+    ASSERT_TRUE(motor.stopAsync(
+        false, [&](IStepperMotor::MotionResult result) { completion.set_value(result); }));
+    auto result = completion.get_future();
+    EXPECT_EQ(result.wait_for(StopTime / 2), std::future_status::timeout);
+
+    // An error of the own controller is confirmed.
+    m_device.setVariable(0x02, TicController::ErrorStatus::MotorDriverError, sizeof(uint16_t));
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(result.get(), IStepperMotor::MotionFailed);
+}
+
+TEST_F(TicControllerTest, StepperMotor_TelemetrySharesStateRead)
+{
+    m_device.setVariable(0x00, TicController::OperationState::Normal, sizeof(uint8_t));
+
+    common::Configuration configuration{
+        common::Option(id::I2cAddress, static_cast<unsigned>(TicAddress), ""),
+        common::Option(id::MaxSpeedRpm, 100u, ""),
+        common::Option(id::Direction, std::string("forward"), "")};
+    StepperMotor motor("test-motor", m_device, m_motorGroup, m_ioErr, m_ioRst);
+    ASSERT_TRUE(motor.init(configuration));
+
+    // A speed query and a following telemetry sample share one state read.
+    const size_t transactionCount = m_device.getTransactions().size();
+    (void)motor.getSpeed();
+    IStepperMotor::Telemetry telemetry;
+    ASSERT_TRUE(motor.getTelemetry(telemetry));
+    EXPECT_EQ(m_device.getTransactions().size(), transactionCount + 1);
+}
+
+TEST_F(TicControllerTest, MotorGroup_SynchronizedVelocityChange)
+{
+    TicController secondController{SecondTicAddress, m_device, m_ioErr, m_ioRst};
+    m_device.setVariable(0x1a, 10000);  // max deceleration
+    m_device.setVariable(0x1e, 10000);  // max acceleration
+    m_device.setVariable(0x26, 0);      // current velocity
+    m_motorGroup.add(m_controller);
+    m_motorGroup.add(secondController);
+
+    // The velocity change is held back, until each motor of the group got one.
+    EXPECT_TRUE(m_motorGroup.changeVelocity(m_controller, 1000000));
+    EXPECT_TRUE(m_device.getTransactions().empty());
+    ASSERT_TRUE(m_motorGroup.changeVelocity(secondController, 500000));
+
+    // Both velocities are sent back to back within the same transaction.
+    const auto messages = m_device.getTransactions().back();
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0].address, TicAddress);
+    EXPECT_EQ(messages[0].data, toBytes({0xe3, 0x40, 0x42, 0x0f, 0x00}));
+    EXPECT_EQ(messages[1].address, SecondTicAddress);
+    EXPECT_EQ(messages[1].data, toBytes({0xe3, 0x20, 0xa1, 0x07, 0x00}));
+    EXPECT_GT(m_motorGroup.getLastSkew().count(), 0);
+
+    // The second motor needs half of the acceleration to finish its ramp with the first one.
+    auto findSetting = [this](I2cControl::Address address, unsigned command) {
+        for (const auto& transaction : m_device.getTransactions())
+        {
+            for (const auto& message : transaction)
+            {
+                if ((message.address == address) && (message.data.at(0) == Byte(command)))
+                {
+                    return message.data;
+                }
+            }
+        }
+        return ByteBuffer{};
+    };
+    EXPECT_EQ(findSetting(TicAddress, 0xea), toBytes({0xea, 0x10, 0x27, 0x00, 0x00}));
+    EXPECT_EQ(findSetting(TicAddress, 0xe9), toBytes({0xe9, 0x10, 0x27, 0x00, 0x00}));
+    EXPECT_EQ(findSetting(SecondTicAddress, 0xea), toBytes({0xea, 0x88, 0x13, 0x00, 0x00}));
+    EXPECT_EQ(findSetting(SecondTicAddress, 0xe9), toBytes({0xe9, 0x88, 0x13, 0x00, 0x00}));
+
+    // The nominal limits are restored after the ramp of one second.
+    TicController::State state;
+    ASSERT_TRUE(secondController.getState(state));
+    EXPECT_EQ(state.maxAcceleration, 5000u);
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while ((state.maxAcceleration != 10000u) && (std::chrono::steady_clock::now() < timeout))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ASSERT_TRUE(secondController.getState(state));
+    }
+    EXPECT_EQ(state.maxAcceleration, 10000u);
+    EXPECT_EQ(state.maxDeceleration, 10000u);
+}
+
+TEST_F(TicControllerTest, MotorGroup_TrimOfHeldVelocityChange)
+{
+    m_device.setVariable(0x00, TicController::OperationState::Normal, sizeof(uint8_t));
+    m_device.setVariable(0x1a, 10000);  // max deceleration
+    m_device.setVariable(0x1e, 10000);  // max acceleration
+    m_device.setVariable(0x26, 0);      // current velocity
+
+    common::Configuration coilConfiguration{
+        common::Option(id::I2cAddress, static_cast<unsigned>(TicAddress), ""),
+        common::Option(id::MaxSpeedRpm, 100u, ""),
+        common::Option(id::Direction, std::string("forward"), "")};
+    common::Configuration feederConfiguration{
+        common::Option(id::I2cAddress, static_cast<unsigned>(SecondTicAddress), ""),
+        common::Option(id::MaxSpeedRpm, 100u, ""),
+        common::Option(id::Direction, std::string("forward"), "")};
+    StepperMotor coilMotor("coil-motor", m_device, m_motorGroup, m_ioErr, m_ioRst);
+    StepperMotor feederMotor("feeder-motor", m_device, m_motorGroup, m_ioErr, m_ioRst);
+    ASSERT_TRUE(coilMotor.init(coilConfiguration));
+    ASSERT_TRUE(feederMotor.init(feederConfiguration));
+
+    // The tension trim of the coil motor arrives between both synchronized speed changes.
+    ASSERT_TRUE(coilMotor.setSpeedSynchronized(IStepperMotor::Speed(50, Unit::Rpm)));
+    const size_t transactionCount = m_device.getTransactions().size();
+    ASSERT_TRUE(coilMotor.setSpeed(IStepperMotor::Speed(60, Unit::Rpm)));
+    EXPECT_EQ(m_device.getTransactions().size(), transactionCount);
+
+    // The trimmed velocity is applied together with the one of the feeder motor.
+    ASSERT_TRUE(feederMotor.setSpeedSynchronized(IStepperMotor::Speed(30, Unit::Rpm)));
+    const auto messages = m_device.getTransactions().back();
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0].address, TicAddress);
+    EXPECT_EQ(messages[0].data, toBytes({0xe3, 0x00, 0x24, 0xf4, 0x00}));
+    EXPECT_EQ(messages[1].address, SecondTicAddress);
+    EXPECT_EQ(messages[1].data, toBytes({0xe3, 0x00, 0x12, 0x7a, 0x00}));
+
+    // A trim without a held back change is applied immediately.
+    const size_t appliedCount = m_device.getTransactions().size();
+    ASSERT_TRUE(coilMotor.setSpeed(IStepperMotor::Speed(61, Unit::Rpm)));
+    EXPECT_GT(m_device.getTransactions().size(), appliedCount);
+}
+
+TEST_F(TicControllerTest, MotorGroup_HeldVelocityChangeDiscarded)
+{
+    constexpr std::chrono::milliseconds HoldTimeout{50};
+    TicController     secondController{SecondTicAddress, m_device, m_ioErr, m_ioRst};
+    StepperMotorGroup motorGroup{m_device, HoldTimeout};
+    m_device.setVariable(0x26, 0);  // current velocity
+    motorGroup.add(m_controller);
+    motorGroup.add(secondController);
+
+    // A held back change, which is not completed in time, is discarded.
+    EXPECT_TRUE(motorGroup.changeVelocity(m_controller, 1000000));
+    std::this_thread::sleep_for(HoldTimeout * 4);
+    EXPECT_FALSE(motorGroup.updateHeldVelocity(m_controller, 1000000));
+    EXPECT_TRUE(motorGroup.changeVelocity(secondController, 500000));
+    EXPECT_TRUE(m_device.getTransactions().empty());
+
+    // A canceled change discards the held back changes of the other motors.
+    EXPECT_TRUE(motorGroup.cancel(secondController));
+    EXPECT_FALSE(motorGroup.cancel(secondController));
+    EXPECT_TRUE(motorGroup.changeVelocity(m_controller, 1000000));
+    EXPECT_TRUE(m_device.getTransactions().empty());
+}
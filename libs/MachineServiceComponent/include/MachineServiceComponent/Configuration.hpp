@@ -36,11 +36,22 @@ namespace def
 inline static constexpr unsigned ConfigMotorSpeedDefault             = 50;
 inline static constexpr unsigned ConfigMotorSpeedMax                 = 100;
 inline static constexpr unsigned ConfigMotorSpeedIncrement           = 10;
-inline static constexpr int      ConfigHeaterTemperatureMax          = 205;
-inline static constexpr int      ConfigHeaterTemperatureMin          = 195;
+inline static constexpr float    ConfigHeaterTemperatureMax          = 205.0f;
+inline static constexpr float    ConfigHeaterTemperatureMin          = 195.0f;
+inline static constexpr unsigned ConfigHeaterControlWindow           = 5000;
+inline static constexpr float    ConfigHeaterPidProportional         = 0.05f;
+inline static constexpr float    ConfigHeaterPidIntegral             = 0.0025f;
+inline static constexpr float    ConfigHeaterPidDerivative           = 0.2f;
+inline static constexpr bool     ConfigHeaterPidAutoTune             = false;
 inline static constexpr unsigned ConfigObservationTimeoutGpioPin     = 1000;
 inline static constexpr unsigned ConfigObservationTimeoutTemperature = 1000;
-inline static constexpr unsigned ConfigObservationTimeoutTension     = 1000;
+inline static constexpr unsigned ConfigObservationTimeoutTension     = 250;
+inline static constexpr float    ConfigTensionControlProportional    = 5.0f;
+inline static constexpr float    ConfigTensionControlIntegral        = 10.0f;
+inline static constexpr unsigned ConfigMotorTelemetrySampleInterval  = 20;
+inline static constexpr unsigned ConfigMotorTelemetryDecimation      = 25;
+
+inline static const std::string ConfigHeaterControl{"pid"};
 }  // namespace def
 
 namespace description
@@ -48,14 +59,35 @@ namespace description
 inline static const std::string ConfigMotorSpeedMax{"Maximum motor speed"};
 inline static const std::string ConfigMotorSpeedDefault{"Default motor speed"};
 inline static const std::string ConfigMotorSpeedIncrement{"Motor speed increment"};
-inline static const std::string ConfigHeaterTemperatureMax{"Maximum heater temperature"};
-inline static const std::string ConfigHeaterTemperatureMin{"Minimum heater temperature"};
+inline static const std::string ConfigHeaterTemperatureMax{
+    "Maximum heater temperature (resolution 0.1°C)"};
+inline static const std::string ConfigHeaterTemperatureMin{
+    "Minimum heater temperature (resolution 0.1°C)"};
+inline static const std::string ConfigHeaterControl{"Heater control mode (pid, hysteresis)"};
+inline static const std::string ConfigHeaterControlWindow{
+    "Heater relay time-proportioning window in ms"};
+inline static const std::string ConfigHeaterPidProportional{
+    "Heater PID proportional gain (duty cycle per K)"};
+inline static const std::string ConfigHeaterPidIntegral{
+    "Heater PID integral gain (duty cycle per K and s)"};
+inline static const std::string ConfigHeaterPidDerivative{
+    "Heater PID derivative gain (duty cycle per K/s)"};
+inline static const std::string ConfigHeaterPidAutoTune{
+    "Heater PID gains are determined by relay auto-tuning on first switch on"};
 inline static const std::string ConfigObservationTimeoutGpioPin{
     "Observation timeout for GPIO pins"};
 inline static const std::string ConfigObservationTimeoutTemperature{
     "Observation timeout for temperature values"};
 inline static const std::string ConfigObservationTimeoutTension{
-    "Observation timeout for filament tension values"};
+    "Control interval for the filament tension in ms"};
+inline static const std::string ConfigTensionControlProportional{
+    "Filament tension control proportional gain (rpm per tension level)"};
+inline static const std::string ConfigTensionControlIntegral{
+    "Filament tension control integral gain (rpm per tension level and s)"};
+inline static const std::string ConfigMotorTelemetrySampleInterval{
+    "Sample interval of the motor telemetry in ms"};
+inline static const std::string ConfigMotorTelemetryDecimation{
+    "Number of motor telemetry samples per published summary"};
 }  // namespace description
 
 namespace id
@@ -68,6 +100,13 @@ inline static const std::string ConfigMotorSpeedIncrement{ConfigMotorSpeed + ".i
 inline static const std::string ConfigHeater{ConfigMachineServiceComponent + ".heater"};
 inline static const std::string ConfigHeaterTemperatureMax{ConfigHeater + ".max-temperature"};
 inline static const std::string ConfigHeaterTemperatureMin{ConfigHeater + ".min-temperature"};
+inline static const std::string ConfigHeaterControl{ConfigHeater + ".control"};
+inline static const std::string ConfigHeaterControlWindow{ConfigHeater + ".control-window"};
+inline static const std::string ConfigHeaterPid{ConfigHeater + ".pid"};
+inline static const std::string ConfigHeaterPidProportional{ConfigHeaterPid + ".proportional"};
+inline static const std::string ConfigHeaterPidIntegral{ConfigHeaterPid + ".integral"};
+inline static const std::string ConfigHeaterPidDerivative{ConfigHeaterPid + ".derivative"};
+inline static const std::string ConfigHeaterPidAutoTune{ConfigHeaterPid + ".auto-tune"};
 inline static const std::string ConfigObservationTimeout{ConfigMachineServiceComponent +
                                                          ".observation-timeout"};
 inline static const std::string ConfigObservationTimeoutGpioPin{ConfigObservationTimeout +
@@ -76,6 +115,17 @@ inline static const std::string ConfigObservationTimeoutTemperature{ConfigObserv
                                                                     ".temperature"};
 inline static const std::string ConfigObservationTimeoutTension{ConfigObservationTimeout +
                                                                 ".tension"};
+inline static const std::string ConfigTensionControl{ConfigMachineServiceComponent +
+                                                     ".tension-control"};
+inline static const std::string ConfigTensionControlProportional{ConfigTensionControl +
+                                                                 ".proportional"};
+inline static const std::string ConfigTensionControlIntegral{ConfigTensionControl + ".integral"};
+inline static const std::string ConfigMotorTelemetry{ConfigMachineServiceComponent +
+                                                     ".motor-telemetry"};
+inline static const std::string ConfigMotorTelemetrySampleInterval{ConfigMotorTelemetry +
+                                                                   ".sample-interval"};
+inline static const std::string ConfigMotorTelemetryDecimation{ConfigMotorTelemetry +
+                                                               ".decimation"};
 }  // namespace id
 
 namespace config
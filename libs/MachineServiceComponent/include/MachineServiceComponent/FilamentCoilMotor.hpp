@@ -24,13 +24,21 @@
 
 #pragma once
 
+#include <chrono>
+#include <mutex>
+
+#include "Common/PidController.hpp"
 #include "Common/ServiceLocator.hpp"
+#include "Common/Timer.hpp"
 #include "MachineServiceComponent/MotorService.hpp"
 #include "ServiceComponent/IFilamentCoilMotor.hpp"
 
 namespace sugo::machine_service_component
 {
-/// @brief Class represents a filament coil motor.
+/**
+ * @brief Class represents a filament coil motor. While running, the motor speed is trimmed by a
+ * PI controller, which keeps the filament tension within the range of the tension sensors.
+ */
 class FilamentCoilMotor : public service_component::IFilamentCoilMotor, public MotorService
 {
 public:
@@ -45,15 +53,18 @@ public:
                       common::IProcessContext&        processContext,
                       const common::ServiceLocator&   serviceLocator);
 
+    ~FilamentCoilMotor() override;
+
 protected:
     // Request handlers
     message_broker::ResponseMessage onRequestSetMotorSpeed(
         const message_broker::Message& request) override;
-    message_broker::ResponseMessage onRequestIncreaseMotorOffsetSpeed(
-        const message_broker::Message& request) override;
-    message_broker::ResponseMessage onRequestDecreaseMotorOffsetSpeed(
+    message_broker::ResponseMessage onRequestSetFilamentTension(
         const message_broker::Message& request) override;
 
+    // Motor service
+    void onMotorTelemetry(const common::Json& telemetry) override;
+
     // Transition actions
     void handleError(const Event& event, const State& state) override;
     void stopMotor(const Event& event, const State& state) override;
@@ -62,7 +73,28 @@ protected:
     void switchOn(const Event& event, const State& state) override;
 
 private:
+    /// @brief Filament tension level, which is the measurement of the tension control.
+    enum class Tension : int
+    {
+        Low    = -1,
+        Normal = 0,
+        High   = 1
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    bool startTensionControl();
+    void stopTensionControl();
+    void updateTensionControl();
+    void setFilamentTension(Tension tension);
+    void controlTension(Tension tension);
+
     const common::ServiceLocator& m_serviceLocator;
+    std::mutex                    m_tensionMutex;               ///< Protects control and speed.
+    common::PidController         m_tensionController;          ///< Speed trim controller.
+    Tension                       m_tension = Tension::Normal;  ///< Current tension level.
+    Clock::time_point             m_lastTensionUpdate;          ///< Last tension control update.
+    common::Timer                 m_tensionControlTimer;        ///< Tension control timer.
 };
 
 }  // namespace sugo::machine_service_component
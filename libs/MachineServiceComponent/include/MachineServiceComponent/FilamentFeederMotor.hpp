@@ -46,11 +46,16 @@ public:
                         common::IProcessContext&        processContext,
                         const common::ServiceLocator&   serviceLocator);
 
+    ~FilamentFeederMotor() override;
+
 protected:
     // Request handlers
     message_broker::ResponseMessage onRequestSetMotorSpeed(
         const message_broker::Message& request) override;
 
+    // Motor service
+    void onMotorTelemetry(const common::Json& telemetry) override;
+
     // Transition actions
     void handleError(const Event& event, const State& state) override;
     void stopMotor(const Event& event, const State& state) override;
@@ -29,7 +29,6 @@
 
 #include "Common/IRunnable.hpp"
 #include "Common/ServiceLocator.hpp"
-#include "Common/Timer.hpp"
 #include "HardwareAbstractionLayer/IHalObject.hpp"
 #include "MachineServiceComponent/GpioPinEventObserver.hpp"
 #include "MachineServiceComponent/HardwareService.hpp"
@@ -99,7 +98,6 @@ protected:
     virtual void onFilamentTensionEvent(FilamentTensionEvent event) = 0;
 
 private:
-    void repeatFilamentTensionEvent();
     void handleFilamentTensionEvent(const hal::IGpioPin::Event& gpioEvent,
                                     const hal::Identifier&      pinId);
 
@@ -109,7 +107,6 @@ private:
                                       m_tensionOverloadSensorObserver;  ///< Observer for tension sensor overload.
     std::atomic<FilamentTensionEvent> m_lastFilamentTensionEvent =
         FilamentTensionEvent::FilamentTensionNormal;  ///< Last filament tension event.
-    common::Timer m_tensionEventRepeatTimer;          ///< Timer to check tension events.
-    std::mutex    m_mutex;                            ///< Mutex to avoid simultaneous access.
+    std::mutex m_mutex;                               ///< Mutex to avoid simultaneous access.
 };
 }  // namespace sugo::machine_service_component
\ No newline at end of file
@@ -25,20 +25,33 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
 #include <string>
 
+#include "Common/PidAutoTuner.hpp"
+#include "Common/PidController.hpp"
+#include "Common/RingBuffer.hpp"
 #include "Common/ServiceLocator.hpp"
 #include "Common/Timer.hpp"
 #include "HardwareAbstractionLayer/IHalObject.hpp"
+#include "HardwareAbstractionLayer/ITemperatureSensor.hpp"
 #include "MachineServiceComponent/HardwareService.hpp"
 
 namespace sugo::machine_service_component
 {
-/// @brief Class provides a heater control service.
+/**
+ * @brief Class provides a heater control service. The heater relay is either switched at the
+ * configured temperature limits (hysteresis) or driven by a PID controlled duty cycle within a
+ * fixed time-proportioning window. In the latter case the target temperature is the center of the
+ * temperature limits and the target range is reached as soon as the minimum is exceeded.
+ */
 class HeaterService : public HardwareService
 {
 public:
-    /// @brief Temperature value type
+    /// @brief Fixed-point temperature value type in deci Celcius (1/10 degree Celcius).
     using Temperature = int32_t;
 
     /**
@@ -51,6 +64,21 @@ public:
     HeaterService(hal::Identifier heaterId, hal::Identifier temperatureSensorId,
                   const common::ServiceLocator& serviceLocator);
 
+    /// @brief Filtered temperature state of the heater.
+    struct TemperatureSnapshot
+    {
+        Temperature temperature = 0;  ///< Median filtered temperature in deci Celcius.
+        Temperature rate        = 0;  ///< Temperature change in deci Kelvin per second.
+    };
+
+    /**
+     * @brief Returns the latest filtered temperature state. The call is lock-free and does not
+     * access the sensor, so it could be used from any context.
+     *
+     * @return The temperature snapshot.
+     */
+    TemperatureSnapshot getTemperatureSnapshot() const;
+
 protected:
     /**
      * @brief Temperature limit event.
@@ -59,7 +87,8 @@ protected:
     enum TemperatureLimitEvent
     {
         MaxTemperatureReached,
-        MinTemperatureReached
+        MinTemperatureReached,
+        TargetTemperatureReached  ///< Minimum exceeded, only if PID controlled.
     };
 
     /**
@@ -71,6 +100,16 @@ protected:
      */
     bool switchHeater(bool switchOn);
 
+    /**
+     * @brief Switches the heater on behalf of a temperature limit event. If the heater is PID
+     * controlled, the relay is only driven by the heater control and will not be switched here.
+     *
+     * @param heatingOn Indicates if heating is requested or not.
+     * @return true     If the heater could be switched successfully.
+     * @return false    If the heater could not be switched successfully.
+     */
+    bool setHeating(bool heatingOn);
+
     /**
      * @brief Updates the current temperature and calls the appropriate handler callbacks.
      */
@@ -82,17 +121,27 @@ protected:
     virtual void onTemperatureLimitEvent(TemperatureLimitEvent event) = 0;
 
     /**
-     * @brief Returns the current temperature.
+     * @brief Returns the current filtered temperature rounded to whole degrees.
      *
-     * @return The current temperature.
+     * @return The current temperature in Celcius or the unchanged error value of the sensor
+     * (minimum or maximum value of the type).
      */
     int32_t getTemperature() const
     {
-        return m_currentTemperature.load();
+        const Temperature temperature = getTemperatureSnapshot().temperature;
+        if ((temperature == std::numeric_limits<Temperature>::min()) ||
+            (temperature == std::numeric_limits<Temperature>::max()))
+        {
+            return temperature;
+        }
+        const Temperature halfDegree = hal::ITemperatureSensor::DeciCelciusPerCelcius / 2;
+        return ((temperature >= 0) ? (temperature + halfDegree) : (temperature - halfDegree)) /
+               hal::ITemperatureSensor::DeciCelciusPerCelcius;
     }
 
     /**
-     * @brief Starts the temperature sensor observation.
+     * @brief Starts the temperature sensor observation. Sensors which publish their samples on
+     * their own are observed by a sample handler, all others are polled periodically.
      *
      * @return true  If observation could be started successfully.
      * @return false If observation could not be started successfully.
@@ -106,16 +155,149 @@ protected:
      */
     void stopTemperatureObservation();
 
-private:
-    /// @brief Update heater temperature and check.
+    /**
+     * @brief Starts the PID heater control, if it is configured. Has to be called after the
+     * temperature observation has been started.
+     *
+     * @return true  If heater control could be started successfully.
+     * @return false If heater control could not be started successfully or the control window
+     * is too short for the control ticks.
+     */
+    bool startHeaterControl();
+
+    /**
+     * @brief Stops the PID heater control. The heater relay state is left unchanged.
+     *
+     */
+    void stopHeaterControl();
+
+    /**
+     * @brief Prepares the temperature observation without starting the observer timer, so the
+     * temperature could be polled by the caller instead.
+     *
+     * @return true  If the sensor publishes its samples on its own.
+     * @return false If the sensor has to be polled.
+     */
+    bool prepareTemperatureObservation();
+
+    /**
+     * @brief Prepares the PID heater control without starting the control tick timer, so the
+     * control ticks could be driven by the caller instead.
+     *
+     * @return true  If heater control could be prepared successfully.
+     * @return false If the control window is too short for the control ticks.
+     */
+    bool prepareHeaterControl();
+
+    /// @brief Polls the temperature and checks it against the limits.
     void updateHeaterTemperatureAndCheck();
 
+    /// @brief Control tick handler, which drives the heater relay.
+    void updateHeaterControl();
+
+private:
+    /// @brief Used clock type.
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Temperature sample.
+    struct TemperatureSample
+    {
+        Temperature       temperature = 0;  ///< Measured temperature in deci Celcius.
+        Clock::time_point timestamp;        ///< Time of the measurement.
+    };
+
+    /// Number of samples used for the rate of change.
+    static constexpr std::size_t SampleCapacity = 16;
+    /// Number of latest samples used for the median filter.
+    static constexpr std::size_t MedianWindowSize = 5;
+
+    /// @brief Temperature sample buffer type.
+    using SampleBuffer = common::RingBuffer<TemperatureSample, SampleCapacity>;
+
+    /// @brief Heater controller types.
+    using AutoTuner            = common::PidAutoTuner;
+    using ControllerParameters = common::PidController::Parameters;
+
+    /// Number of control ticks of one time-proportioning window.
+    static constexpr unsigned ControlTicksPerWindow = 20;
+    /// Min control window, so each control tick takes at least one millisecond.
+    static constexpr std::chrono::milliseconds MinControlWindow{ControlTicksPerWindow};
+
+    /**
+     * @brief Sets a new current temperature.
+     *
+     * @param value Temperature value of the sensor.
+     */
+    void setHeaterTemperature(const hal::ITemperatureSensor::Temperature& value);
+
+    /// @brief Checks the current temperature against the limits.
+    void checkHeaterTemperature();
+
+    /**
+     * @brief Returns the median of the latest samples.
+     *
+     * @return The median filtered temperature.
+     */
+    Temperature getMedianTemperature() const;
+
+    /**
+     * @brief Returns the rate of change of all samples.
+     *
+     * @return Temperature change in deci Kelvin per second.
+     */
+    Temperature getTemperatureRate() const;
+
+    /**
+     * @brief Packs a snapshot into one value, so it could be exchanged atomically.
+     *
+     * @param snapshot Snapshot to pack.
+     * @return The packed snapshot.
+     */
+    static uint64_t packSnapshot(const TemperatureSnapshot& snapshot);
+
+    /**
+     * @brief Returns a configured temperature limit as fixed-point value.
+     *
+     * @param optionId Configuration option identifier of the limit.
+     * @return The temperature limit in deci Celcius.
+     */
+    Temperature getTemperatureLimit(const std::string& optionId) const;
+
+    /**
+     * @brief Returns the configured PID controller gains.
+     *
+     * @return The controller gains.
+     */
+    ControllerParameters getControllerParameters() const;
+
+    /**
+     * @brief Switches the heater relay on behalf of the heater control, if the state changes.
+     *
+     * @param switchOn Indicates if the heater should be switched on or off.
+     */
+    void switchHeaterByControl(bool switchOn);
+
     const hal::Identifier         m_heaterId;             ///< Heater actor identifier.
     const hal::Identifier         m_temperatureSensorId;  ///< Heater temperature sensor identifier.
     const common::ServiceLocator& m_serviceLocator;       ///< Service locator instance.
     common::Timer                 m_temperatureObserver;  ///< Temperature observer timer.
-    std::atomic<Temperature>      m_currentTemperature     = 0;  ///< Current measured temperature.
-    Temperature                   m_lastCheckedTemperature = 0;  ///< Last measured temperture.
+    SampleBuffer                  m_samples;              ///< Latest temperature samples.
+    std::atomic<uint64_t>         m_snapshot{0};          ///< Packed temperature snapshot.
+    Temperature                   m_lastCheckedTemperature = 0;      ///< Last checked temperature.
+    Temperature                   m_temperatureMax         = 0;      ///< Cached max temperature.
+    Temperature                   m_temperatureMin         = 0;      ///< Cached min temperature.
+    Temperature                   m_temperatureTarget      = 0;      ///< Cached target temperature.
+    bool                          m_isSampleDriven         = false;  ///< Sensor publishes samples.
+    const bool                    m_isPidControlled;      ///< Heater relay is PID controlled.
+    const double                  m_controlWindow;        ///< Control window in seconds.
+    common::Timer                 m_heaterControl;        ///< Heater control tick timer.
+    common::PidController         m_controller;           ///< Heater PID controller.
+    std::optional<AutoTuner>      m_autoTuner;            ///< Active PID auto-tuner.
+    ControllerParameters          m_tunedParameters;      ///< Auto-tuned controller gains.
+    bool                          m_isTuned      = false;  ///< Gains have been auto-tuned.
+    unsigned                      m_controlTick  = 0;      ///< Control tick within the window.
+    unsigned                      m_heatingTicks = 0;      ///< Heating ticks of the window.
+    bool                          m_isHeaterOn   = false;  ///< Relay state of the heater control.
 };
 
 }  // namespace sugo::machine_service_component
@@ -78,6 +78,17 @@ protected:
 private:
     void switchOff();
 
+    /**
+     * @brief Sets the current motor speed to the coil and the feeder motor, which change their
+     * velocity synchronously. If one of them fails, the former motor speed is kept.
+     *
+     * @param request          Request which caused the speed change.
+     * @param formerMotorSpeed Motor speed before the speed change.
+     * @return Response to the request.
+     */
+    message_broker::ResponseMessage setMotorSpeed(const message_broker::Message& request,
+                                                  unsigned formerMotorSpeed);
+
     const common::ServiceLocator& m_serviceLocator;  ///< Service locator instance.
     bool                          m_isFilamentMergerControlRunning =
         false;  ///< Indicates if filament merger control unit is running.
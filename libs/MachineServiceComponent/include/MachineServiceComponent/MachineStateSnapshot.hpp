@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "Common/Types.hpp"
+
+namespace sugo::machine_service_component
+{
+/**
+ * @brief Class keeps the last known values of the machine state. Each change increments the
+ * version of the snapshot, and each value remembers the version it was changed last. Clients
+ * knowing a version only need the values changed since then.
+ */
+class MachineStateSnapshot
+{
+public:
+    /// @brief Snapshot version, which starts with 0 for the empty snapshot.
+    using Version = uint64_t;
+
+    /**
+     * @brief Sets a value of the snapshot.
+     *
+     * @param key   Key of the value.
+     * @param value New value.
+     * @return true  If the value has been changed and the version incremented.
+     * @return false If the value has been set already.
+     */
+    bool set(const std::string& key, const common::Json& value);
+
+    /**
+     * @brief Returns the current version.
+     *
+     * @return Current version.
+     */
+    Version getVersion() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_version;
+    }
+
+    /**
+     * @brief Returns all values of the snapshot.
+     *
+     * @param[out] version Version of the returned values.
+     * @return Object with all values.
+     */
+    common::Json get(Version& version) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        version = m_version;
+        return m_values;
+    }
+
+    /**
+     * @brief Returns the values changed after the passed version. If the passed version is newer
+     * than the current one, it has been from a different snapshot and all values are returned.
+     *
+     * @param since        Version known by the client.
+     * @param[out] version Version of the returned values.
+     * @return Object with the changed values.
+     */
+    common::Json getChangesSince(Version since, Version& version) const;
+
+private:
+    mutable std::mutex             m_mutex;        ///< Protects the snapshot.
+    Version                        m_version = 0;  ///< Current version.
+    common::Json                   m_values = common::Json::object();  ///< Current values.
+    std::map<std::string, Version> m_versions;  ///< Version of the last change of each value.
+};
+}  // namespace sugo::machine_service_component
@@ -28,9 +28,11 @@
 #include <string>
 
 #include "Common/ServiceLocator.hpp"
+#include "Common/Types.hpp"
 #include "HardwareAbstractionLayer/IStepperMotor.hpp"
 #include "MachineServiceComponent/Configuration.hpp"
 #include "MachineServiceComponent/HardwareService.hpp"
+#include "MachineServiceComponent/MotorTelemetrySampler.hpp"
 
 namespace sugo::machine_service_component
 {
@@ -51,21 +53,44 @@ protected:
      * @brief Sets the motor max speed.
      * The value will only be set within the allowed range.
      *
-     * @param motorSpeed Motor speed to set
-     * @return true      If the speed value could be set successfully.
-     * @return false     If the speed value could not be set successfully.
+     * @param motorSpeed     Motor speed to set of unit hal::Unit::Rpm or hal::Unit::MilliRpm.
+     * @param isSynchronized Indicates if the speed is changed together with the other motors,
+     *                       see hal::IStepperMotor::setSpeedSynchronized().
+     * @return true          If the speed value could be set successfully.
+     * @return false         If the speed value could not be set successfully.
      */
-    bool setMotorSpeed(unsigned motorSpeed);
+    bool setMotorSpeed(hal::IStepperMotor::Speed motorSpeed, bool isSynchronized = false);
+
+    /**
+     * @brief Cancels the held back synchronized speed change and sets the former motor speed,
+     * see hal::IStepperMotor::cancelSpeedSynchronized().
+     *
+     * @param motorSpeed Former motor speed of unit hal::Unit::Rpm or hal::Unit::MilliRpm.
+     * @return true      If the former speed could be set successfully.
+     * @return false     If the former speed could not be set successfully.
+     */
+    bool cancelMotorSpeed(hal::IStepperMotor::Speed motorSpeed);
 
     /**
      * @brief Sets the motor offset speed, which will be added to the current speed.
-     * The value will only be set within the allowed range.
+     * The value will only be set within the allowed range and the motor is only updated if the
+     * resulting offset speed changed.
+     *
+     * @param motorOffsetSpeed Motor offset speed to set in milli-RPM.
+     * @return true            If the offset speed value could be set successfully.
+     * @return false           If the offset speed value could not be set successfully.
+     */
+    bool setMotorOffsetSpeed(int motorOffsetSpeed);
+
+    /**
+     * @brief Returns the current motor offset speed.
      *
-     * @param motorSpeed Motor speed to set
-     * @return true      If the offset speed value could be set successfully.
-     * @return false     If the offset speed value could not be set successfully.
+     * @return The current motor offset speed in milli-RPM.
      */
-    bool addMotorOffsetSpeed(int motorOffsetSpeed);
+    int getMotorOffsetSpeed() const
+    {
+        return m_motorOffsetSpeed;
+    }
 
     /**
      * @brief Starts the motor rotation.
@@ -90,19 +115,52 @@ protected:
      */
     void stopMotorRotation(bool immediately = false);
 
+    /**
+     * @brief Starts to stop the motor rotation without waiting for the motor to stand still.
+     *
+     * @param handler     Handler to be called from a different context, once the motor stopped.
+     * @param immediately Indicates if the rotation should be stopped immediately.
+     * @return true       If the stop could be started successfully.
+     * @return false      If the stop could not be started successfully.
+     */
+    bool stopMotorRotationAsync(hal::IStepperMotor::MotionCompletionHandler handler,
+                                bool                                        immediately = false);
+
+    /**
+     * @brief Starts sampling the motor telemetry, whose summaries are passed to
+     * onMotorTelemetry().
+     *
+     * @return true  If the sampling could be started successfully.
+     * @return false If the sampling could not be started successfully.
+     */
+    bool startMotorTelemetry();
+
+    /// @brief Stops sampling the motor telemetry.
+    void stopMotorTelemetry();
+
+    /**
+     * @brief Called with each motor telemetry summary from the sampler context.
+     * Has to be stopped with stopMotorTelemetry() before the implementing class is destroyed.
+     *
+     * @param telemetry Telemetry summary in JSON format.
+     */
+    virtual void onMotorTelemetry(const common::Json& telemetry) = 0;
+
 private:
     /**
      * @brief Sets the motor speed.
      *
+     * @param isSynchronized Indicates if the speed is changed together with the other motors.
      * @return true If the motor speed could be set.
      * @return false If the motor speed could not be set.
      */
-    bool setMotorSpeed();
+    bool setMotorSpeed(bool isSynchronized = false);
 
     std::shared_ptr<hal::IStepperMotor> m_stepperMotor;          ///< Stepper motor object.
-    const unsigned                      m_maxMotorSpeed    = 0;  ///< Max motor speed.
-    unsigned                            m_motorSpeed       = 0;  ///< Current set motor speed.
-    int                                 m_motorOffsetSpeed = 0;  ///< Motor offset speed.
+    const unsigned                      m_maxMotorSpeed    = 0;  ///< Max motor speed [mRPM].
+    unsigned                            m_motorSpeed       = 0;  ///< Current set speed [mRPM].
+    int                                 m_motorOffsetSpeed = 0;  ///< Motor offset speed [mRPM].
+    MotorTelemetrySampler               m_telemetrySampler;      ///< Motor telemetry sampler.
 };
 
 }  // namespace sugo::machine_service_component
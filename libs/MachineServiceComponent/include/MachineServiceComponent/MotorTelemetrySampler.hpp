@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "Common/IRunnable.hpp"
+#include "Common/RingBuffer.hpp"
+#include "Common/Timer.hpp"
+#include "HardwareAbstractionLayer/IStepperMotor.hpp"
+
+namespace sugo::machine_service_component
+{
+/**
+ * @brief Class samples the state of a stepper motor at a fixed rate and passes decimated
+ * summaries to a handler. The samples are passed from the sample context to the summary context
+ * by a lock-free ring buffer, so a slow summary handler never delays the sampling.
+ */
+class MotorTelemetrySampler : public common::IRunnable
+{
+public:
+    /// @brief Summary of all samples within one summary interval.
+    struct Summary
+    {
+        unsigned                     sampleCount = 0;      ///< Number of summarized samples.
+        unsigned                     lostSamples = 0;      ///< Failed or dropped samples.
+        hal::IStepperMotor::Position position    = 0;      ///< Last position in microsteps.
+        int32_t                      velocity    = 0;      ///< Mean velocity in milli-RPM.
+        int32_t                      minVelocity = 0;      ///< Minimum velocity in milli-RPM.
+        int32_t                      maxVelocity = 0;      ///< Maximum velocity in milli-RPM.
+        uint32_t                     errorFlags  = 0;      ///< All error flags set meanwhile.
+        bool                         isEnergized = false;  ///< Last energized state.
+    };
+
+    /// @brief Handler which receives the summaries.
+    using SummaryHandler = std::function<void(const Summary&)>;
+
+    /**
+     * @brief Construct a new motor telemetry sampler.
+     *
+     * @param stepperMotor   Stepper motor to be sampled.
+     * @param sampleInterval Interval between two samples.
+     * @param decimation     Number of samples per summary.
+     * @param summaryHandler Handler to be called with each summary from a different context.
+     */
+    MotorTelemetrySampler(std::shared_ptr<hal::IStepperMotor> stepperMotor,
+                          std::chrono::milliseconds sampleInterval, unsigned decimation,
+                          SummaryHandler summaryHandler);
+    ~MotorTelemetrySampler() override;
+
+    bool start() override;
+    void stop() override;
+
+    bool isRunning() const override
+    {
+        return m_sampleTimer.isRunning();
+    }
+
+private:
+    /// Max number of buffered samples, which has to cover the samples of one summary interval.
+    static constexpr std::size_t SampleCapacity = 256u;
+
+    /// Buffer of the samples, which are not summarized yet.
+    using SampleBuffer = common::RingBuffer<hal::IStepperMotor::Telemetry, SampleCapacity>;
+
+    /// @brief Reads one sample from the motor.
+    void sample();
+
+    /// @brief Summarizes all buffered samples and passes the summary to the handler.
+    void summarize();
+
+    std::shared_ptr<hal::IStepperMotor> m_stepperMotor;    ///< Stepper motor to be sampled.
+    SummaryHandler                      m_summaryHandler;  ///< Summary handler.
+    SampleBuffer                        m_samples;         ///< Samples not yet summarized.
+    std::atomic<unsigned>               m_lostSamples{0};  ///< Lost samples since last summary.
+    common::Timer                       m_sampleTimer;     ///< Timer of the sample context.
+    common::Timer                       m_summaryTimer;    ///< Timer of the summary context.
+};
+}  // namespace sugo::machine_service_component
@@ -30,9 +30,24 @@ namespace sugo::machine_service_component::id
 {
 inline static const std::string Result{"result"};
 inline static const std::string Speed{"speed"};
+inline static const std::string Synchronized{"synchronized"};
+inline static const std::string Cancel{"cancel"};
 inline static const std::string TensionControl{"tension-control"};
+inline static const std::string Tension{"tension"};
+inline static const std::string TensionLow{"low"};
+inline static const std::string TensionNormal{"normal"};
+inline static const std::string TensionHigh{"high"};
 inline static const std::string Type{"type"};
+inline static const std::string SampleCount{"samples"};
+inline static const std::string LostSamples{"lost-samples"};
+inline static const std::string Position{"position"};
+inline static const std::string Velocity{"velocity"};
+inline static const std::string VelocityMin{"velocity-min"};
+inline static const std::string VelocityMax{"velocity-max"};
+inline static const std::string ErrorFlags{"error-flags"};
+inline static const std::string Energized{"energized"};
 inline static const std::string Temperature{"temperature"};
+inline static const std::string TemperatureRate{"temperature-rate"};
 inline static const std::string ErrorSetMotorSpeedOutOfRange{"error-setmotorspeed-outofrange"};
 inline static const std::string ErrorParameterInvalid{"error-parameter-invalid"};
 }  // namespace sugo::machine_service_component::id
\ No newline at end of file
@@ -27,6 +27,8 @@
 #include "Common/ServiceLocator.hpp"
 #include "Common/Thread.hpp"
 #include "Common/Types.hpp"
+#include "HardwareAbstractionLayer/Identifier.hpp"
+#include "MachineServiceComponent/MachineStateSnapshot.hpp"
 #include "MachineServiceComponent/UserLightService.hpp"
 #include "RemoteControl/IClientRequestHandler.hpp"
 #include "ServiceComponent/IUserInterfaceControl.hpp"
@@ -79,21 +81,39 @@ protected:
     void onNotificationMachineControlRunning(const message_broker::Message& request) override;
     void onNotificationMachineControlSwitchedOff(const message_broker::Message& request) override;
     void onNotificationMachineControlErrorOccurred(const message_broker::Message& request) override;
+    void onNotificationMachineControlMotorSpeedChanged(
+        const message_broker::Message& request) override;
+    void onNotificationFilamentFeederMotorMotorTelemetry(
+        const message_broker::Message& request) override;
+    void onNotificationFilamentCoilMotorMotorTelemetry(
+        const message_broker::Message& request) override;
 
     // Transition actions
     void handleMachineStateChange(const Event& event, const State& state) override;
 
 private:
-    /// @brief Updates the state machine.
+    /// @brief Sends the current machine state to the clients.
     void updateMachineState();
 
+    /**
+     * @brief Forwards a motor telemetry notification to the clients.
+     *
+     * @param motor Identifier of the motor.
+     * @param notification Motor telemetry notification.
+     */
+    void forwardMotorTelemetry(const hal::Identifier&         motor,
+                               const message_broker::Message& notification);
+
     /**
      * @brief Creates a new state message in JSON format.
      *
      * @param type Current state type.
+     * @param values State values of the message.
+     * @param version Snapshot version of the state values.
      * @return common::Json Created state message in JSON format.
      */
-    common::Json createStateMessage(const std::string& type);
+    static common::Json createStateMessage(const std::string& type, common::Json values,
+                                           MachineStateSnapshot::Version version);
 
     /**
      * @brief Converts a user interface event to a string.
@@ -106,7 +126,7 @@ private:
     UserLightService m_userLightService;  ///< User light service. // TODO Pass services as
                                           ///< interfaces from outside!
     SendNotificationCallback m_cbSendNotification = nullptr;  ///< Notification send callback.
-    Event m_lastMachineEvent = Event::MachineSwitchedOff;     ///< Last machine event.
+    MachineStateSnapshot     m_stateSnapshot;  ///< Machine state known by the clients.
 };
 
 }  // namespace sugo::machine_service_component
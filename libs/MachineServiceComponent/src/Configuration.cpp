@@ -41,6 +41,21 @@ void config::addConfigurationOptions(sugo::common::IConfiguration& configuration
     configuration.add(common::Option(id::ConfigHeaterTemperatureMin,
                                      def::ConfigHeaterTemperatureMin,
                                      description::ConfigHeaterTemperatureMin));
+    configuration.add(common::Option(id::ConfigHeaterControl, def::ConfigHeaterControl,
+                                     description::ConfigHeaterControl));
+    configuration.add(common::Option(id::ConfigHeaterControlWindow,
+                                     def::ConfigHeaterControlWindow,
+                                     description::ConfigHeaterControlWindow));
+    configuration.add(common::Option(id::ConfigHeaterPidProportional,
+                                     def::ConfigHeaterPidProportional,
+                                     description::ConfigHeaterPidProportional));
+    configuration.add(common::Option(id::ConfigHeaterPidIntegral, def::ConfigHeaterPidIntegral,
+                                     description::ConfigHeaterPidIntegral));
+    configuration.add(common::Option(id::ConfigHeaterPidDerivative,
+                                     def::ConfigHeaterPidDerivative,
+                                     description::ConfigHeaterPidDerivative));
+    configuration.add(common::Option(id::ConfigHeaterPidAutoTune, def::ConfigHeaterPidAutoTune,
+                                     description::ConfigHeaterPidAutoTune));
     configuration.add(common::Option(id::ConfigObservationTimeoutGpioPin,
                                      def::ConfigObservationTimeoutGpioPin,
                                      description::ConfigObservationTimeoutTemperature));
@@ -50,4 +65,16 @@ void config::addConfigurationOptions(sugo::common::IConfiguration& configuration
     configuration.add(common::Option(id::ConfigObservationTimeoutTension,
                                      def::ConfigObservationTimeoutTension,
                                      description::ConfigObservationTimeoutTension));
+    configuration.add(common::Option(id::ConfigTensionControlProportional,
+                                     def::ConfigTensionControlProportional,
+                                     description::ConfigTensionControlProportional));
+    configuration.add(common::Option(id::ConfigTensionControlIntegral,
+                                     def::ConfigTensionControlIntegral,
+                                     description::ConfigTensionControlIntegral));
+    configuration.add(common::Option(id::ConfigMotorTelemetrySampleInterval,
+                                     def::ConfigMotorTelemetrySampleInterval,
+                                     description::ConfigMotorTelemetrySampleInterval));
+    configuration.add(common::Option(id::ConfigMotorTelemetryDecimation,
+                                     def::ConfigMotorTelemetryDecimation,
+                                     description::ConfigMotorTelemetryDecimation));
 }
\ No newline at end of file
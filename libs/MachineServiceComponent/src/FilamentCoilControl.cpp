@@ -129,18 +129,20 @@ void FilamentCoilControl::controlFilamentTension(const IFilamentCoilControl::Eve
 {
     if (m_controlTension)
     {
-        bool success = true;
+        // Only the tension edges are passed, the coil motor trims its speed continuously.
+        std::string tension = id::TensionNormal;
 
         if (event == Event::TensionTooLow)
         {
-            success = send(IFilamentCoilMotor::RequestIncreaseMotorOffsetSpeed);
+            tension = id::TensionLow;
         }
         else if (event == Event::TensionTooHigh)
         {
-            success = send(IFilamentCoilMotor::RequestDecreaseMotorOffsetSpeed);
+            tension = id::TensionHigh;
         }
 
-        if (!success)
+        if (!send(IFilamentCoilMotor::RequestSetFilamentTension,
+                  common::Json({{id::Tension, tension}})))
         {
             push(Event::ErrorOccurred);
         }
@@ -22,7 +22,10 @@
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cmath>
+
 #include "MachineServiceComponent/FilamentCoilMotor.hpp"
+#include "Common/Logger.hpp"
 #include "HardwareAbstractionLayer/IHardwareAbstractionLayer.hpp"
 #include "MachineServiceComponent/Configuration.hpp"
 #include "MachineServiceComponent/Protocol.hpp"
@@ -36,10 +39,34 @@ FilamentCoilMotor::FilamentCoilMotor(message_broker::IMessageBroker& messageBrok
                                      const common::ServiceLocator&   serviceLocator)
     : IFilamentCoilMotor(messageBroker, processContext),
       MotorService(hal::id::StepperMotorCoiler, serviceLocator),
-      m_serviceLocator(serviceLocator)
+      m_serviceLocator(serviceLocator),
+      m_tensionController(
+          {serviceLocator.get<common::IConfiguration>()
+               .getOption(id::ConfigTensionControlProportional)
+               .get<float>(),
+           serviceLocator.get<common::IConfiguration>()
+               .getOption(id::ConfigTensionControlIntegral)
+               .get<float>(),
+           0.0},
+          -static_cast<double>(serviceLocator.get<common::IConfiguration>()
+                                   .getOption(id::ConfigMotorSpeedMax)
+                                   .get<unsigned>()),
+          static_cast<double>(serviceLocator.get<common::IConfiguration>()
+                                  .getOption(id::ConfigMotorSpeedMax)
+                                  .get<unsigned>())),
+      m_tensionControlTimer(
+          std::chrono::milliseconds(serviceLocator.get<common::IConfiguration>()
+                                        .getOption(id::ConfigObservationTimeoutTension)
+                                        .get<unsigned>()),
+          [this] { updateTensionControl(); }, hal::id::StepperMotorCoiler + "TensionControl")
 {
 }
 
+FilamentCoilMotor::~FilamentCoilMotor()
+{
+    stopMotorTelemetry();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Requests:
 
@@ -55,28 +82,44 @@ message_broker::ResponseMessage FilamentCoilMotor::onRequestSetMotorSpeed(
             request, message_broker::ResponseMessage::Result::InvalidPayload);
     }
 
-    (void)setMotorSpeed(motorSpeed.get<unsigned>());
-    return message_broker::createResponseMessage(request);
-}
+    std::lock_guard<std::mutex> lock(m_tensionMutex);
+    const hal::IStepperMotor::Speed speed{motorSpeed.get<unsigned>(), hal::Unit::Rpm};
 
-message_broker::ResponseMessage FilamentCoilMotor::onRequestIncreaseMotorOffsetSpeed(
-    const message_broker::Message& request)
-{
-    const int motorSpeedIncrement = static_cast<int>(m_serviceLocator.get<common::IConfiguration>()
-                                                         .getOption(id::ConfigMotorSpeedIncrement)
-                                                         .get<unsigned>());
-    (void)addMotorOffsetSpeed(motorSpeedIncrement);
+    const bool success = parameters.value(id::Cancel, false)
+                             ? cancelMotorSpeed(speed)
+                             : setMotorSpeed(speed, parameters.value(id::Synchronized, false));
+    if (!success)
+    {
+        return message_broker::createErrorResponseMessage(
+            request, message_broker::ResponseMessage::Result::Error);
+    }
     return message_broker::createResponseMessage(request);
 }
 
-message_broker::ResponseMessage FilamentCoilMotor::onRequestDecreaseMotorOffsetSpeed(
+message_broker::ResponseMessage FilamentCoilMotor::onRequestSetFilamentTension(
     const message_broker::Message& request)
 {
-    static constexpr int negativeMultiplier = -1;
-    const int motorSpeedIncrement = static_cast<int>(m_serviceLocator.get<common::IConfiguration>()
-                                                         .getOption(id::ConfigMotorSpeedIncrement)
-                                                         .get<unsigned>());
-    (void)addMotorOffsetSpeed(negativeMultiplier * motorSpeedIncrement);
+    const auto  parameters = common::Json::parse(request.getPayload());
+    const auto& tension    = parameters.at(id::Tension);
+
+    if (tension == id::TensionLow)
+    {
+        setFilamentTension(Tension::Low);
+    }
+    else if (tension == id::TensionHigh)
+    {
+        setFilamentTension(Tension::High);
+    }
+    else if (tension == id::TensionNormal)
+    {
+        setFilamentTension(Tension::Normal);
+    }
+    else
+    {
+        return message_broker::createErrorResponseMessage(
+            request, message_broker::ResponseMessage::Result::InvalidPayload);
+    }
+
     return message_broker::createResponseMessage(request);
 }
 
@@ -85,7 +128,7 @@ message_broker::ResponseMessage FilamentCoilMotor::onRequestDecreaseMotorOffsetS
 
 void FilamentCoilMotor::switchOn(const IFilamentCoilMotor::Event&, const IFilamentCoilMotor::State&)
 {
-    if (resetMotor())
+    if (resetMotor() && startMotorTelemetry())
     {
         push(Event::SwitchOnSucceeded);
     }
@@ -98,7 +141,7 @@ void FilamentCoilMotor::switchOn(const IFilamentCoilMotor::Event&, const IFilame
 void FilamentCoilMotor::startMotor(const IFilamentCoilMotor::Event&,
                                    const IFilamentCoilMotor::State&)
 {
-    if (startMotorRotation())
+    if (startTensionControl() && startMotorRotation())
     {
         push(Event::StartMotorSucceeded);
         notify(NotificationStartMotorSucceeded);
@@ -113,6 +156,7 @@ void FilamentCoilMotor::startMotor(const IFilamentCoilMotor::Event&,
 void FilamentCoilMotor::handleError(const IFilamentCoilMotor::Event&,
                                     const IFilamentCoilMotor::State&)
 {
+    stopTensionControl();
     stopMotorRotation(true);
     notify(NotificationErrorOccurred);
 }
@@ -120,13 +164,115 @@ void FilamentCoilMotor::handleError(const IFilamentCoilMotor::Event&,
 void FilamentCoilMotor::stopMotor(const IFilamentCoilMotor::Event&,
                                   const IFilamentCoilMotor::State&)
 {
-    stopMotorRotation(false);
-    push(Event::StopMotorSucceeded);
-    notify(NotificationStopMotorSucceeded);
+    stopTensionControl();
+
+    // The motor ramps down in the background, so further events are processed meanwhile.
+    const bool started = stopMotorRotationAsync([this](hal::IStepperMotor::MotionResult result) {
+        switch (result)
+        {
+            case hal::IStepperMotor::MotionSucceeded:
+                push(Event::StopMotorSucceeded);
+                notify(NotificationStopMotorSucceeded);
+                break;
+            case hal::IStepperMotor::MotionFailed:
+                push(Event::ErrorOccurred);
+                notify(NotificationErrorOccurred);
+                break;
+            case hal::IStepperMotor::MotionAborted:
+                // Superseded by a further stop, which is reported on its own.
+                break;
+        }
+    });
+
+    if (!started)
+    {
+        push(Event::ErrorOccurred);
+        notify(NotificationErrorOccurred);
+    }
 }
 
 void FilamentCoilMotor::switchOff(const IFilamentCoilMotor::Event&,
                                   const IFilamentCoilMotor::State&)
 {
-    stopMotorRotation(false);
+    stopMotorTelemetry();
+    stopTensionControl();
+    (void)stopMotorRotationAsync([](hal::IStepperMotor::MotionResult result) {
+        if (result == hal::IStepperMotor::MotionFailed)
+        {
+            LOG(error) << "Failed to stop motor while switching off";
+        }
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Tension control:
+
+bool FilamentCoilMotor::startTensionControl()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_tensionMutex);
+        m_tensionController.reset();
+        m_lastTensionUpdate = Clock::now();
+        (void)setMotorOffsetSpeed(0);
+    }
+
+    if (!m_tensionControlTimer.isRunning() && !m_tensionControlTimer.start())
+    {
+        LOG(error) << "Failed to start filament tension control";
+        return false;
+    }
+
+    return true;
+}
+
+void FilamentCoilMotor::stopTensionControl()
+{
+    m_tensionControlTimer.stop();
+}
+
+void FilamentCoilMotor::updateTensionControl()
+{
+    std::lock_guard<std::mutex> lock(m_tensionMutex);
+    controlTension(m_tension);
+}
+
+void FilamentCoilMotor::setFilamentTension(Tension tension)
+{
+    std::lock_guard<std::mutex> lock(m_tensionMutex);
+    if (!m_tensionControlTimer.isRunning())
+    {
+        // Taken as initial tension level with the next start.
+        m_tension = tension;
+        return;
+    }
+
+    controlTension(tension);
+}
+
+void FilamentCoilMotor::controlTension(Tension tension)
+{
+    const auto   now      = Clock::now();
+    const double timeStep = std::chrono::duration<double>(now - m_lastTensionUpdate).count();
+    m_lastTensionUpdate   = now;
+
+    // The time up to now is accounted to the last tension level, so the integral part reflects
+    // the exact timing of the tension edges. The new level changes the proportional part only.
+    (void)m_tensionController.update(0.0, static_cast<double>(m_tension), timeStep);
+    m_tension = tension;
+    const double offsetSpeed =
+        m_tensionController.update(0.0, static_cast<double>(m_tension), 0.0);
+
+    if (!setMotorOffsetSpeed(static_cast<int>(
+            std::lround(offsetSpeed * static_cast<double>(hal::IStepperMotor::MilliRpmPerRpm)))))
+    {
+        LOG(error) << "Failed to trim motor speed for filament tension";
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Motor service:
+
+void FilamentCoilMotor::onMotorTelemetry(const common::Json& telemetry)
+{
+    notify(NotificationMotorTelemetry, telemetry);
 }
@@ -23,6 +23,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "MachineServiceComponent/FilamentFeederMotor.hpp"
+#include "Common/Logger.hpp"
 #include "HardwareAbstractionLayer/IHardwareAbstractionLayer.hpp"
 #include "MachineServiceComponent/Configuration.hpp"
 #include "MachineServiceComponent/Protocol.hpp"
@@ -38,6 +39,12 @@ FilamentFeederMotor::FilamentFeederMotor(message_broker::IMessageBroker& message
       MotorService(hal::id::StepperMotorFeeder, serviceLocator)
 {
 }
+
+FilamentFeederMotor::~FilamentFeederMotor()
+{
+    stopMotorTelemetry();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Requests:
 
@@ -53,7 +60,16 @@ message_broker::ResponseMessage FilamentFeederMotor::onRequestSetMotorSpeed(
             request, message_broker::ResponseMessage::Result::InvalidPayload);
     }
 
-    (void)setMotorSpeed(motorSpeed.get<unsigned>());
+    const hal::IStepperMotor::Speed speed{motorSpeed.get<unsigned>(), hal::Unit::Rpm};
+
+    const bool success = parameters.value(id::Cancel, false)
+                             ? cancelMotorSpeed(speed)
+                             : setMotorSpeed(speed, parameters.value(id::Synchronized, false));
+    if (!success)
+    {
+        return message_broker::createErrorResponseMessage(
+            request, message_broker::ResponseMessage::Result::Error);
+    }
     return message_broker::createResponseMessage(request);
 }
 
@@ -63,7 +79,7 @@ message_broker::ResponseMessage FilamentFeederMotor::onRequestSetMotorSpeed(
 void FilamentFeederMotor::switchOn(const IFilamentFeederMotor::Event&,
                                    const IFilamentFeederMotor::State&)
 {
-    if (resetMotor())
+    if (resetMotor() && startMotorTelemetry())
     {
         push(Event::SwitchOnSucceeded);
     }
@@ -98,13 +114,47 @@ void FilamentFeederMotor::handleError(const IFilamentFeederMotor::Event&,
 void FilamentFeederMotor::stopMotor(const IFilamentFeederMotor::Event&,
                                     const IFilamentFeederMotor::State&)
 {
-    stopMotorRotation(false);
-    push(Event::StopMotorSucceeded);
-    notify(NotificationStopMotorSucceeded);
+    // The motor ramps down in the background, so further events are processed meanwhile.
+    const bool started = stopMotorRotationAsync([this](hal::IStepperMotor::MotionResult result) {
+        switch (result)
+        {
+            case hal::IStepperMotor::MotionSucceeded:
+                push(Event::StopMotorSucceeded);
+                notify(NotificationStopMotorSucceeded);
+                break;
+            case hal::IStepperMotor::MotionFailed:
+                push(Event::ErrorOccurred);
+                notify(NotificationErrorOccurred);
+                break;
+            case hal::IStepperMotor::MotionAborted:
+                // Superseded by a further stop, which is reported on its own.
+                break;
+        }
+    });
+
+    if (!started)
+    {
+        push(Event::ErrorOccurred);
+        notify(NotificationErrorOccurred);
+    }
 }
 
 void FilamentFeederMotor::switchOff(const IFilamentFeederMotor::Event&,
                                     const IFilamentFeederMotor::State&)
 {
-    stopMotorRotation(false);
+    stopMotorTelemetry();
+    (void)stopMotorRotationAsync([](hal::IStepperMotor::MotionResult result) {
+        if (result == hal::IStepperMotor::MotionFailed)
+        {
+            LOG(error) << "Failed to stop motor while switching off";
+        }
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Motor service:
+
+void FilamentFeederMotor::onMotorTelemetry(const common::Json& telemetry)
+{
+    notify(NotificationMotorTelemetry, telemetry);
 }
@@ -49,6 +49,9 @@ void FilamentMergerHeater::onTemperatureLimitEvent(TemperatureLimitEvent event)
         case MaxTemperatureReached:
             push(Event::MaxTemperatureReached);
             break;
+        case TargetTemperatureReached:
+            push(Event::TargetTemperatureReached);
+            break;
     }
 }
 
@@ -58,8 +61,12 @@ void FilamentMergerHeater::onTemperatureLimitEvent(TemperatureLimitEvent event)
 message_broker::ResponseMessage FilamentMergerHeater::onRequestGetTemperature(
     const message_broker::Message& request)
 {
+    const auto snapshot = getTemperatureSnapshot();
     return message_broker::createResponseMessage(
-        request, common::Json({{id::Temperature, getTemperature()}}));
+        request, common::Json({{id::Temperature, getTemperature()},
+                               {id::TemperatureRate,
+                                static_cast<double>(snapshot.rate) /
+                                    hal::ITemperatureSensor::DeciCelciusPerCelcius}}));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -70,7 +77,7 @@ void FilamentMergerHeater::switchOn(const IFilamentMergerHeater::Event&,
 {
     updateHeaterTemperature();
 
-    if (!startTemperatureObservation())
+    if (!startTemperatureObservation() || !startHeaterControl())
     {
         push(Event::ErrorOccurred);
         return;
@@ -82,7 +89,7 @@ void FilamentMergerHeater::switchOn(const IFilamentMergerHeater::Event&,
 void FilamentMergerHeater::startHeating(const IFilamentMergerHeater::Event& event,
                                         const IFilamentMergerHeater::State&)
 {
-    if (!switchHeater(true))
+    if (!setHeating(true))
     {
         push(Event::ErrorOccurred);
         return;
@@ -97,13 +104,13 @@ void FilamentMergerHeater::startHeating(const IFilamentMergerHeater::Event& even
 void FilamentMergerHeater::stopHeating(const IFilamentMergerHeater::Event& event,
                                        const IFilamentMergerHeater::State&)
 {
-    if (!switchHeater(false))
+    if (!setHeating(false))
     {
         push(Event::ErrorOccurred);
         return;
     }
 
-    if (event == Event::MaxTemperatureReached)
+    if ((event == Event::MaxTemperatureReached) || (event == Event::TargetTemperatureReached))
     {
         notify(NotificationTargetTemperatureRangeReached);
     }
@@ -112,6 +119,7 @@ void FilamentMergerHeater::stopHeating(const IFilamentMergerHeater::Event& event
 void FilamentMergerHeater::switchOff(const IFilamentMergerHeater::Event&,
                                      const IFilamentMergerHeater::State&)
 {
+    stopHeaterControl();
     stopTemperatureObservation();
 
     if (!switchHeater(false))
@@ -123,6 +131,7 @@ void FilamentMergerHeater::switchOff(const IFilamentMergerHeater::Event&,
 void FilamentMergerHeater::handleError(const IFilamentMergerHeater::Event&,
                                        const IFilamentMergerHeater::State&)
 {
+    stopHeaterControl();
     (void)switchHeater(false);
     notify(NotificationErrorOccurred);
 }
@@ -48,6 +48,9 @@ void FilamentPreHeater::onTemperatureLimitEvent(TemperatureLimitEvent event)
         case MaxTemperatureReached:
             push(Event::MaxTemperatureReached);
             break;
+        case TargetTemperatureReached:
+            push(Event::TargetTemperatureReached);
+            break;
     }
 }
 
@@ -57,8 +60,12 @@ void FilamentPreHeater::onTemperatureLimitEvent(TemperatureLimitEvent event)
 message_broker::ResponseMessage FilamentPreHeater::onRequestGetTemperature(
     const message_broker::Message& request)
 {
+    const auto snapshot = getTemperatureSnapshot();
     return message_broker::createResponseMessage(
-        request, common::Json({{id::Temperature, getTemperature()}}));
+        request, common::Json({{id::Temperature, getTemperature()},
+                               {id::TemperatureRate,
+                                static_cast<double>(snapshot.rate) /
+                                    hal::ITemperatureSensor::DeciCelciusPerCelcius}}));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -68,7 +75,7 @@ void FilamentPreHeater::switchOn(const IFilamentPreHeater::Event&, const IFilame
 {
     updateHeaterTemperature();
 
-    if (!startTemperatureObservation())
+    if (!startTemperatureObservation() || !startHeaterControl())
     {
         push(Event::ErrorOccurred);
         return;
@@ -80,7 +87,7 @@ void FilamentPreHeater::switchOn(const IFilamentPreHeater::Event&, const IFilame
 void FilamentPreHeater::startHeating(const IFilamentPreHeater::Event& event,
                                      const IFilamentPreHeater::State&)
 {
-    if (!switchHeater(true))
+    if (!setHeating(true))
     {
         push(Event::ErrorOccurred);
         return;
@@ -95,13 +102,13 @@ void FilamentPreHeater::startHeating(const IFilamentPreHeater::Event& event,
 void FilamentPreHeater::stopHeating(const IFilamentPreHeater::Event& event,
                                     const IFilamentPreHeater::State&)
 {
-    if (!switchHeater(false))
+    if (!setHeating(false))
     {
         push(Event::ErrorOccurred);
         return;
     }
 
-    if (event == Event::MaxTemperatureReached)
+    if ((event == Event::MaxTemperatureReached) || (event == Event::TargetTemperatureReached))
     {
         notify(NotificationTargetTemperatureRangeReached);
     }
@@ -110,6 +117,7 @@ void FilamentPreHeater::stopHeating(const IFilamentPreHeater::Event& event,
 void FilamentPreHeater::switchOff(const IFilamentPreHeater::Event&,
                                   const IFilamentPreHeater::State&)
 {
+    stopHeaterControl();
     stopTemperatureObservation();
 
     if (!switchHeater(false))
@@ -121,6 +129,7 @@ void FilamentPreHeater::switchOff(const IFilamentPreHeater::Event&,
 void FilamentPreHeater::handleError(const IFilamentPreHeater::Event&,
                                     const IFilamentPreHeater::State&)
 {
+    stopHeaterControl();
     (void)switchHeater(false);
     notify(NotificationErrorOccurred);
 }
@@ -50,6 +50,10 @@ void FilamentTensionSensor::onFilamentTensionEvent(FilamentTensionEvent event)
     {
         notify(IFilamentTensionSensor::NotificationTensionTooHigh);
     }
+    else if (event == FilamentTensionNormal)
+    {
+        notify(IFilamentTensionSensor::NotificationTensionNormal);
+    }
     else if (event == FilamentTensionOverload)
     {
         notify(IFilamentTensionSensor::NotificationTensionOverloaded);
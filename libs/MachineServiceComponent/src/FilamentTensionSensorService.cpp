@@ -56,12 +56,7 @@ FilamentTensionSensorService::FilamentTensionSensorService(
           },
           std::chrono::milliseconds(serviceLocator.get<common::IConfiguration>()
                                         .getOption(id::ConfigObservationTimeoutGpioPin)
-                                        .get<unsigned>())),
-      m_tensionEventRepeatTimer(
-          std::chrono::milliseconds(serviceLocator.get<common::IConfiguration>()
-                                        .getOption(id::ConfigObservationTimeoutTension)
-                                        .get<unsigned>()),
-          [this] { this->repeatFilamentTensionEvent(); }, lowTensionSensorId + "common::Timer")
+                                        .get<unsigned>()))
 {
 }
 
@@ -99,18 +94,6 @@ void FilamentTensionSensorService::stopSensorObservation()
     m_lowTensionSensorObserver.stop();
     m_highTensionSensorObserver.stop();
     m_tensionOverloadSensorObserver.stop();
-    m_tensionEventRepeatTimer.stop();
-}
-
-void FilamentTensionSensorService::repeatFilamentTensionEvent()
-{
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if ((m_lastFilamentTensionEvent == FilamentTensionLow) or
-        (m_lastFilamentTensionEvent == FilamentTensionHigh))
-    {
-        // Repeat event call as long as the tension is not at normal level!
-        onFilamentTensionEvent(m_lastFilamentTensionEvent);
-    }
 }
 
 void FilamentTensionSensorService::handleFilamentTensionEvent(const hal::IGpioPin::Event& event,
@@ -149,19 +132,11 @@ void FilamentTensionSensorService::handleFilamentTensionEvent(const hal::IGpioPi
             break;
     }
 
+    // Only the edges are passed, the tension control measures the time between them.
     if (currentEvent != m_lastFilamentTensionEvent)
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_lastFilamentTensionEvent = currentEvent;
         onFilamentTensionEvent(m_lastFilamentTensionEvent);
-
-        if (currentEvent == FilamentTensionNormal)
-        {
-            m_tensionEventRepeatTimer.stop();
-        }
-        else if (!m_tensionEventRepeatTimer.isRunning())
-        {
-            m_tensionEventRepeatTimer.start();
-        }
     }
 }
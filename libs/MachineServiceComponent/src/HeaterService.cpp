@@ -22,7 +22,10 @@
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
 #include <limits>
 
 #include "Common/Logger.hpp"
@@ -30,6 +33,13 @@
 #include "MachineServiceComponent/Configuration.hpp"
 #include "MachineServiceComponent/HeaterService.hpp"
 
+namespace
+{
+constexpr char   ControlModePid[]        = "pid";
+constexpr char   ControlModeHysteresis[] = "hysteresis";
+constexpr double AutoTuneHysteresis      = 0.5;  // K
+}  // namespace
+
 using namespace sugo;
 using namespace sugo::machine_service_component;
 
@@ -44,8 +54,30 @@ HeaterService::HeaterService(hal::Identifier heaterId, hal::Identifier temperatu
                                         .getOption(id::ConfigObservationTimeoutTemperature)
                                         .get<unsigned>()),
           [&]() { updateHeaterTemperatureAndCheck(); }, m_heaterId + "common::Timer"),
-      m_lastCheckedTemperature(std::numeric_limits<Temperature>::min())
+      m_lastCheckedTemperature(std::numeric_limits<Temperature>::min()),
+      m_isPidControlled(m_serviceLocator.get<common::IConfiguration>()
+                            .getOption(id::ConfigHeaterControl)
+                            .get<std::string>() == ControlModePid),
+      m_controlWindow(static_cast<double>(m_serviceLocator.get<common::IConfiguration>()
+                                              .getOption(id::ConfigHeaterControlWindow)
+                                              .get<unsigned>()) /
+                      1000.0),
+      m_heaterControl(
+          std::chrono::milliseconds(m_serviceLocator.get<common::IConfiguration>()
+                                        .getOption(id::ConfigHeaterControlWindow)
+                                        .get<unsigned>() /
+                                    ControlTicksPerWindow),
+          [&]() { updateHeaterControl(); }, m_heaterId + "Control"),
+      m_controller(ControllerParameters{})
 {
+    const auto controlMode = m_serviceLocator.get<common::IConfiguration>()
+                                 .getOption(id::ConfigHeaterControl)
+                                 .get<std::string>();
+    if (!m_isPidControlled && (controlMode != ControlModeHysteresis))
+    {
+        LOG(warning) << "Unknown heater control mode '" << controlMode << "', using "
+                     << ControlModeHysteresis;
+    }
 }
 
 bool HeaterService::switchHeater(bool switchOn)
@@ -56,48 +88,293 @@ bool HeaterService::switchHeater(bool switchOn)
                                               : hal::IGpioPin::State::Low);
 }
 
+bool HeaterService::setHeating(bool heatingOn)
+{
+    if (m_isPidControlled)
+    {
+        return true;
+    }
+    return switchHeater(heatingOn);
+}
+
 void HeaterService::updateHeaterTemperature()
 {
     auto& temperatureSensor = getTemperatureSensor(m_temperatureSensorId);
-    auto  value             = temperatureSensor->getTemperature();
-    assert(value.getUnit() == hal::Unit::Celcius);
-    m_currentTemperature = value.getValue();
+    setHeaterTemperature(temperatureSensor->getTemperature());
+}
+
+void HeaterService::setHeaterTemperature(const hal::ITemperatureSensor::Temperature& value)
+{
+    assert((value.getUnit() == hal::Unit::Celcius) || (value.getUnit() == hal::Unit::DeciCelcius));
+    // Sliding window, samples are added and removed within the same context.
+    if (m_samples.full())
+    {
+        (void)m_samples.pop();
+    }
+    (void)m_samples.push({hal::ITemperatureSensor::toDeciCelcius(value).getValue(), Clock::now()});
+
+    const TemperatureSnapshot snapshot{getMedianTemperature(), getTemperatureRate()};
+    m_snapshot = packSnapshot(snapshot);
+}
+
+HeaterService::Temperature HeaterService::getMedianTemperature() const
+{
+    assert(!m_samples.empty());
+    const std::size_t windowSize = std::min(m_samples.size(), MedianWindowSize);
+    std::array<Temperature, MedianWindowSize> window{};
+
+    for (std::size_t i = 0; i < windowSize; ++i)
+    {
+        window[i] = m_samples[m_samples.size() - windowSize + i].temperature;
+    }
+
+    const auto median = window.begin() + static_cast<std::ptrdiff_t>(windowSize / 2);
+    std::nth_element(window.begin(), median,
+                     window.begin() + static_cast<std::ptrdiff_t>(windowSize));
+    return *median;
+}
+
+HeaterService::Temperature HeaterService::getTemperatureRate() const
+{
+    if (m_samples.size() < 2)
+    {
+        return 0;
+    }
+
+    // Least squares slope over all samples, which smooths the sensor noise.
+    const auto   startTime          = m_samples.front().timestamp;
+    const double count              = static_cast<double>(m_samples.size());
+    double       sumTime            = 0.0;
+    double       sumTemperature     = 0.0;
+    double       sumTimeTime        = 0.0;
+    double       sumTimeTemperature = 0.0;
+
+    for (std::size_t i = 0; i < m_samples.size(); ++i)
+    {
+        const double time =
+            std::chrono::duration<double>(m_samples[i].timestamp - startTime).count();
+        const double temperature = static_cast<double>(m_samples[i].temperature);
+        sumTime += time;
+        sumTemperature += temperature;
+        sumTimeTime += time * time;
+        sumTimeTemperature += time * temperature;
+    }
+
+    const double denominator = count * sumTimeTime - sumTime * sumTime;
+    if (denominator <= 0.0)
+    {
+        return 0;
+    }
+    return static_cast<Temperature>(
+        std::lround((count * sumTimeTemperature - sumTime * sumTemperature) / denominator));
+}
+
+HeaterService::TemperatureSnapshot HeaterService::getTemperatureSnapshot() const
+{
+    const uint64_t packed = m_snapshot.load();
+    return {static_cast<Temperature>(static_cast<uint32_t>(packed >> 32u)),
+            static_cast<Temperature>(static_cast<uint32_t>(packed))};
+}
+
+uint64_t HeaterService::packSnapshot(const TemperatureSnapshot& snapshot)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(snapshot.temperature)) << 32u) |
+           static_cast<uint64_t>(static_cast<uint32_t>(snapshot.rate));
+}
+
+HeaterService::Temperature HeaterService::getTemperatureLimit(const std::string& optionId) const
+{
+    const float limit =
+        m_serviceLocator.get<common::IConfiguration>().getOption(optionId).get<float>();
+    return static_cast<Temperature>(
+        std::lround(limit * static_cast<float>(hal::ITemperatureSensor::DeciCelciusPerCelcius)));
 }
 
 void HeaterService::updateHeaterTemperatureAndCheck()
 {
     updateHeaterTemperature();
+    checkHeaterTemperature();
+}
+
+void HeaterService::checkHeaterTemperature()
+{
+    const Temperature temperature = getTemperatureSnapshot().temperature;
 
-    if (m_lastCheckedTemperature != m_currentTemperature)
+    if (m_lastCheckedTemperature != temperature)
     {
-        // Implement hysteresis
-        if (m_currentTemperature >= m_serviceLocator.get<common::IConfiguration>()
-                                        .getOption(id::ConfigHeaterTemperatureMax)
-                                        .get<int>())
+        // Implement hysteresis, the PID control reaches the target range above the minimum
+        if (temperature >= m_temperatureMax)
         {
             LOG(debug) << "Max temperature reached: " << m_lastCheckedTemperature << "/"
-                       << m_currentTemperature;
+                       << temperature;
             onTemperatureLimitEvent(TemperatureLimitEvent::MaxTemperatureReached);
         }
-        else if (m_currentTemperature <= m_serviceLocator.get<common::IConfiguration>()
-                                             .getOption(id::ConfigHeaterTemperatureMin)
-                                             .get<int>())
+        else if (m_isPidControlled && (temperature >= m_temperatureMin))
+        {
+            LOG(debug) << "Target temperature reached: " << m_lastCheckedTemperature << "/"
+                       << temperature;
+            onTemperatureLimitEvent(TemperatureLimitEvent::TargetTemperatureReached);
+        }
+        else if (temperature <= m_temperatureMin)
         {
             LOG(debug) << "Min temperature reached: " << m_lastCheckedTemperature << "/"
-                       << m_currentTemperature;
+                       << temperature;
             onTemperatureLimitEvent(TemperatureLimitEvent::MinTemperatureReached);
         }
 
-        m_lastCheckedTemperature = m_currentTemperature;
+        m_lastCheckedTemperature = temperature;
     }
 }
 
 bool HeaterService::startTemperatureObservation()
 {
+    if (prepareTemperatureObservation())
+    {
+        LOG(debug) << "Temperature of " << m_temperatureSensorId << " is sample driven";
+        return true;
+    }
+
+    // Fallback, if the sensor does not provide samples on its own
     return m_temperatureObserver.start();
 }
 
+bool HeaterService::prepareTemperatureObservation()
+{
+    // Configuration does not change while observing
+    m_temperatureMax    = getTemperatureLimit(id::ConfigHeaterTemperatureMax);
+    m_temperatureMin    = getTemperatureLimit(id::ConfigHeaterTemperatureMin);
+    m_temperatureTarget = (m_temperatureMax + m_temperatureMin) / 2;
+
+    auto& temperatureSensor = getTemperatureSensor(m_temperatureSensorId);
+    m_isSampleDriven =
+        temperatureSensor->registerSampleHandler([this](const auto& temperature) {
+            setHeaterTemperature(temperature);
+            checkHeaterTemperature();
+        });
+    return m_isSampleDriven;
+}
+
 void HeaterService::stopTemperatureObservation()
 {
+    if (m_isSampleDriven)
+    {
+        (void)getTemperatureSensor(m_temperatureSensorId)->registerSampleHandler(nullptr);
+        m_isSampleDriven = false;
+    }
     m_temperatureObserver.stop();
-}
\ No newline at end of file
+    m_samples.clear();
+    m_snapshot               = packSnapshot(TemperatureSnapshot{});
+    m_lastCheckedTemperature = std::numeric_limits<Temperature>::min();
+}
+
+HeaterService::ControllerParameters HeaterService::getControllerParameters() const
+{
+    const auto& configuration = m_serviceLocator.get<common::IConfiguration>();
+    return {configuration.getOption(id::ConfigHeaterPidProportional).get<float>(),
+            configuration.getOption(id::ConfigHeaterPidIntegral).get<float>(),
+            configuration.getOption(id::ConfigHeaterPidDerivative).get<float>()};
+}
+
+bool HeaterService::startHeaterControl()
+{
+    if (!m_isPidControlled)
+    {
+        return true;
+    }
+
+    return prepareHeaterControl() && m_heaterControl.start();
+}
+
+bool HeaterService::prepareHeaterControl()
+{
+    assert(m_isPidControlled);
+
+    if (std::chrono::duration<double>(m_controlWindow) < MinControlWindow)
+    {
+        LOG(error) << "Heater control window of " << m_heaterId << " is less than "
+                   << MinControlWindow.count() << "ms";
+        return false;
+    }
+
+    m_controller.reset();
+    m_controller.setParameters(m_isTuned ? m_tunedParameters : getControllerParameters());
+    m_controlTick  = 0;
+    m_heatingTicks = 0;
+    m_isHeaterOn   = false;
+
+    if (!m_isTuned && m_serviceLocator.get<common::IConfiguration>()
+                          .getOption(id::ConfigHeaterPidAutoTune)
+                          .get<bool>())
+    {
+        LOG(info) << "Start auto-tuning of heater " << m_heaterId;
+        m_autoTuner.emplace(static_cast<double>(m_temperatureTarget) /
+                                hal::ITemperatureSensor::DeciCelciusPerCelcius,
+                            AutoTuneHysteresis);
+    }
+
+    return true;
+}
+
+void HeaterService::stopHeaterControl()
+{
+    m_heaterControl.stop();
+    m_autoTuner.reset();
+}
+
+void HeaterService::updateHeaterControl()
+{
+    const double temperature = static_cast<double>(getTemperatureSnapshot().temperature) /
+                               hal::ITemperatureSensor::DeciCelciusPerCelcius;
+
+    if (m_autoTuner.has_value())
+    {
+        const double time =
+            std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+        switchHeaterByControl(m_autoTuner->update(temperature, time) > 0.0);
+
+        if (m_autoTuner->isFinished())
+        {
+            m_tunedParameters = m_autoTuner->getParameters().value();
+            m_isTuned         = true;
+            m_autoTuner.reset();
+            m_controller.setParameters(m_tunedParameters);
+            m_controlTick = 0;
+            LOG(info) << "Heater " << m_heaterId << " auto-tuned: proportional "
+                      << m_tunedParameters.proportional << ", integral "
+                      << m_tunedParameters.integral << ", derivative "
+                      << m_tunedParameters.derivative;
+        }
+        return;
+    }
+
+    // Time-proportioning: the duty cycle is updated once per window.
+    if (m_controlTick == 0)
+    {
+        const double dutyCycle =
+            m_controller.update(static_cast<double>(m_temperatureTarget) /
+                                    hal::ITemperatureSensor::DeciCelciusPerCelcius,
+                                temperature, m_controlWindow);
+        m_heatingTicks = static_cast<unsigned>(
+            std::lround(dutyCycle * static_cast<double>(ControlTicksPerWindow)));
+    }
+
+    switchHeaterByControl(m_controlTick < m_heatingTicks);
+    m_controlTick = (m_controlTick + 1) % ControlTicksPerWindow;
+}
+
+void HeaterService::switchHeaterByControl(bool switchOn)
+{
+    if (switchOn == m_isHeaterOn)
+    {
+        return;
+    }
+
+    if (switchHeater(switchOn))
+    {
+        m_isHeaterOn = switchOn;
+    }
+    else
+    {
+        LOG(error) << "Failed to switch heater " << m_heaterId << ", retry on next tick";
+    }
+}
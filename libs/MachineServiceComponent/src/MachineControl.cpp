@@ -52,7 +52,8 @@ MachineControl::MachineControl(message_broker::IMessageBroker& messageBroker,
 message_broker::ResponseMessage MachineControl::onRequestIncreaseMotorSpeed(
     const message_broker::Message& request)
 {
-    m_motorSpeed = static_cast<unsigned>(
+    const unsigned formerMotorSpeed = m_motorSpeed;
+    m_motorSpeed                    = static_cast<unsigned>(
         std::clamp(static_cast<int>(m_motorSpeed) +
                        static_cast<int>(m_serviceLocator.get<common::IConfiguration>()
                                             .getOption(id::ConfigMotorSpeedIncrement)
@@ -62,26 +63,14 @@ message_broker::ResponseMessage MachineControl::onRequestIncreaseMotorSpeed(
                                         .getOption(id::ConfigMotorSpeedMax)
                                         .get<unsigned>())));
     LOG(debug) << "Increase motor speed to " << m_motorSpeed;
-    const common::Json              parameters({{id::Speed, m_motorSpeed}});
-    message_broker::ResponseMessage responseMessage{};
-
-    if (!send(IFilamentCoilControl::RequestSetMotorSpeed, parameters, responseMessage))
-    {
-        return message_broker::createErrorResponseMessage(request, responseMessage.getResult());
-    }
-
-    if (!send(IFilamentMergerControl::RequestSetMotorSpeed, parameters, responseMessage))
-    {
-        return message_broker::createErrorResponseMessage(request, responseMessage.getResult());
-    }
-
-    return message_broker::createResponseMessage(request);
+    return setMotorSpeed(request, formerMotorSpeed);
 }
 
 message_broker::ResponseMessage MachineControl::onRequestDecreaseMotorSpeed(
     const message_broker::Message& request)
 {
-    m_motorSpeed = static_cast<unsigned>(
+    const unsigned formerMotorSpeed = m_motorSpeed;
+    m_motorSpeed                    = static_cast<unsigned>(
         std::clamp(static_cast<int>(m_motorSpeed) -
                        static_cast<int>(m_serviceLocator.get<common::IConfiguration>()
                                             .getOption(id::ConfigMotorSpeedIncrement)
@@ -91,20 +80,7 @@ message_broker::ResponseMessage MachineControl::onRequestDecreaseMotorSpeed(
                                         .getOption(id::ConfigMotorSpeedMax)
                                         .get<unsigned>())));
     LOG(debug) << "Decrease motor speed to " << m_motorSpeed;
-    const common::Json              parameters({{id::Speed, m_motorSpeed}});
-    message_broker::ResponseMessage responseMessage{};
-
-    if (!send(IFilamentCoilControl::RequestSetMotorSpeed, parameters, responseMessage))
-    {
-        return message_broker::createErrorResponseMessage(request, responseMessage.getResult());
-    }
-
-    if (!send(IFilamentMergerControl::RequestSetMotorSpeed, parameters, responseMessage))
-    {
-        return message_broker::createErrorResponseMessage(request, responseMessage.getResult());
-    }
-
-    return message_broker::createResponseMessage(request);
+    return setMotorSpeed(request, formerMotorSpeed);
 }
 
 message_broker::ResponseMessage MachineControl::onRequestGetMotorSpeed(
@@ -200,6 +176,7 @@ void MachineControl::startMachine(const IMachineControl::Event& event,
         push(Event::ErrorOccurred);
         return;
     }
+    notify(NotificationMotorSpeedChanged, setMotorSpeedParameter);
 
     const common::Json startCoilParameter(
         {{id::TensionControl, (event == Event::StartHeatless) ? false : true}});
@@ -267,3 +244,35 @@ void MachineControl::switchOff()
     switchOffServiceComponent<IFilamentMergerControl>();
     switchOffServiceComponent<IFilamentCoilControl>();
 }
+
+message_broker::ResponseMessage MachineControl::setMotorSpeed(
+    const message_broker::Message& request, unsigned formerMotorSpeed)
+{
+    // Both motors have to change their speed at the same time, otherwise the filament tension
+    // changes until the second one has followed. So the motor services hold back the speed
+    // changes, until both motors got them.
+    const common::Json parameters({{id::Speed, m_motorSpeed}, {id::Synchronized, true}});
+
+    message_broker::ResponseMessage responseMessage{};
+
+    if (!send(IFilamentCoilControl::RequestSetMotorSpeed, parameters, responseMessage))
+    {
+        m_motorSpeed = formerMotorSpeed;
+        return message_broker::createErrorResponseMessage(request, responseMessage.getResult());
+    }
+
+    if (!send(IFilamentMergerControl::RequestSetMotorSpeed, parameters, responseMessage))
+    {
+        // The held back speed change of the coil motor would never be completed.
+        if (!send(IFilamentCoilControl::RequestSetMotorSpeed,
+                  common::Json({{id::Speed, formerMotorSpeed}, {id::Cancel, true}})))
+        {
+            LOG(error) << "Failed to cancel the speed change of the coil motor";
+        }
+        m_motorSpeed = formerMotorSpeed;
+        return message_broker::createErrorResponseMessage(request, responseMessage.getResult());
+    }
+
+    notify(NotificationMotorSpeedChanged, common::Json({{id::Speed, m_motorSpeed}}));
+    return message_broker::createResponseMessage(request);
+}
@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MachineServiceComponent/MachineStateSnapshot.hpp"
+
+using namespace sugo;
+using namespace sugo::machine_service_component;
+
+bool MachineStateSnapshot::set(const std::string& key, const common::Json& value)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto                        current = m_values.find(key);
+    if ((current != m_values.end()) && (*current == value))
+    {
+        return false;
+    }
+
+    m_values[key]   = value;
+    m_versions[key] = ++m_version;
+    return true;
+}
+
+common::Json MachineStateSnapshot::getChangesSince(Version since, Version& version) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    version = m_version;
+    if (since > m_version)
+    {
+        return m_values;
+    }
+
+    common::Json changes = common::Json::object();
+    for (const auto& [key, changeVersion] : m_versions)
+    {
+        if (changeVersion > since)
+        {
+            changes[key] = m_values.at(key);
+        }
+    }
+    return changes;
+}
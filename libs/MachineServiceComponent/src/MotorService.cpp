@@ -23,12 +23,14 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <utility>
 
 #include "Common/Logger.hpp"
 #include "HardwareAbstractionLayer/IHardwareAbstractionLayer.hpp"
 #include "HardwareAbstractionLayer/IStepperMotor.hpp"
 #include "MachineServiceComponent/Configuration.hpp"
 #include "MachineServiceComponent/MotorService.hpp"
+#include "MachineServiceComponent/Protocol.hpp"
 
 namespace
 {
@@ -42,40 +44,74 @@ MotorService::MotorService(const hal::Identifier&        motorId,
                            const common::ServiceLocator& serviceLocator)
     : HardwareService(serviceLocator.get<hal::IHardwareAbstractionLayer>()),
       m_stepperMotor(getStepperMotor(motorId)),
-      m_maxMotorSpeed(m_stepperMotor->getMaxSpeed().getValue()),
-      m_motorSpeed(0)
+      m_maxMotorSpeed(hal::IStepperMotor::toMilliRpm(m_stepperMotor->getMaxSpeed()).getValue()),
+      m_motorSpeed(0),
+      m_telemetrySampler(
+          m_stepperMotor,
+          std::chrono::milliseconds(serviceLocator.get<common::IConfiguration>()
+                                        .getOption(id::ConfigMotorTelemetrySampleInterval)
+                                        .get<unsigned>()),
+          serviceLocator.get<common::IConfiguration>()
+              .getOption(id::ConfigMotorTelemetryDecimation)
+              .get<unsigned>(),
+          [this](const MotorTelemetrySampler::Summary& summary) {
+              onMotorTelemetry(common::Json({{id::SampleCount, summary.sampleCount},
+                                             {id::LostSamples, summary.lostSamples},
+                                             {id::Position, summary.position},
+                                             {id::Velocity, summary.velocity},
+                                             {id::VelocityMin, summary.minVelocity},
+                                             {id::VelocityMax, summary.maxVelocity},
+                                             {id::ErrorFlags, summary.errorFlags},
+                                             {id::Energized, summary.isEnergized}}));
+          })
 {
 }
 
-bool MotorService::setMotorSpeed(unsigned motorSpeed)
+bool MotorService::setMotorSpeed(hal::IStepperMotor::Speed motorSpeed, bool isSynchronized)
 {
-    m_motorSpeed = motorSpeed;
+    m_motorSpeed = hal::IStepperMotor::toMilliRpm(motorSpeed).getValue();
 
     if (m_motorSpeed > m_maxMotorSpeed)
     {
         m_motorSpeed = m_maxMotorSpeed;
     }
 
-    return setMotorSpeed();
+    return setMotorSpeed(isSynchronized);
 }
 
-bool MotorService::setMotorSpeed()
+bool MotorService::cancelMotorSpeed(hal::IStepperMotor::Speed motorSpeed)
+{
+    m_motorSpeed = std::min(hal::IStepperMotor::toMilliRpm(motorSpeed).getValue(), m_maxMotorSpeed);
+
+    // If the speed change is not held back anymore, the former speed has to be set again.
+    return m_stepperMotor->cancelSpeedSynchronized() || setMotorSpeed();
+}
+
+bool MotorService::setMotorSpeed(bool isSynchronized)
 {
     assert((static_cast<int>(m_motorSpeed) + m_motorOffsetSpeed) <=
            static_cast<int>(m_maxMotorSpeed));
     const int motorSpeed = static_cast<int>(m_motorSpeed) + m_motorOffsetSpeed;
-    LOG(debug) << "Setting motor speed: " << motorSpeed;
-    return m_stepperMotor->setSpeed(
-        hal::IStepperMotor::Speed(static_cast<unsigned>(motorSpeed), hal::Unit::Rpm));
+    LOG(debug) << "Setting motor speed: " << motorSpeed << " mRPM"
+               << (isSynchronized ? " synchronized" : "");
+    const hal::IStepperMotor::Speed speed(static_cast<unsigned>(motorSpeed), hal::Unit::MilliRpm);
+    return isSynchronized ? m_stepperMotor->setSpeedSynchronized(speed)
+                          : m_stepperMotor->setSpeed(speed);
 }
 
 // FIXME remove offset-speed, just use one speed!
-bool MotorService::addMotorOffsetSpeed(int motorOffsetSpeed)
+bool MotorService::setMotorOffsetSpeed(int motorOffsetSpeed)
 {
-    int resultingSpeed =
-        std::clamp(static_cast<int>(m_motorSpeed) + m_motorOffsetSpeed + motorOffsetSpeed, 0,
-                   static_cast<int>(m_maxMotorSpeed));
-    m_motorOffsetSpeed = resultingSpeed - static_cast<int>(m_motorSpeed);
+    const int resultingSpeed = std::clamp(static_cast<int>(m_motorSpeed) + motorOffsetSpeed, 0,
+                                          static_cast<int>(m_maxMotorSpeed));
+    const int offsetSpeed    = resultingSpeed - static_cast<int>(m_motorSpeed);
+
+    if (offsetSpeed == m_motorOffsetSpeed)
+    {
+        return true;
+    }
+
+    m_motorOffsetSpeed = offsetSpeed;
     return setMotorSpeed();
 }
 
@@ -113,4 +149,30 @@ void MotorService::stopMotorRotation(bool immediately)
         LOG(error) << "Failed to stop motor" << ((immediately) ? " immediately" : "");
     }
     LOG(debug) << "Motor stop finished";
-}
\ No newline at end of file
+}
+
+bool MotorService::stopMotorRotationAsync(hal::IStepperMotor::MotionCompletionHandler handler,
+                                          bool                                        immediately)
+{
+    if (!m_stepperMotor->stopAsync(immediately, std::move(handler)))
+    {
+        LOG(error) << "Failed to start motor stop" << ((immediately) ? " immediately" : "");
+        return false;
+    }
+    return true;
+}
+
+bool MotorService::startMotorTelemetry()
+{
+    if (!m_telemetrySampler.start())
+    {
+        LOG(error) << "Failed to start motor telemetry";
+        return false;
+    }
+    return true;
+}
+
+void MotorService::stopMotorTelemetry()
+{
+    m_telemetrySampler.stop();
+}
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include "Common/Logger.hpp"
+#include "MachineServiceComponent/MotorTelemetrySampler.hpp"
+
+using namespace sugo;
+using namespace sugo::machine_service_component;
+
+MotorTelemetrySampler::MotorTelemetrySampler(std::shared_ptr<hal::IStepperMotor> stepperMotor,
+                                             std::chrono::milliseconds           sampleInterval,
+                                             unsigned                            decimation,
+                                             SummaryHandler                      summaryHandler)
+    : m_stepperMotor(std::move(stepperMotor)),
+      m_summaryHandler(std::move(summaryHandler)),
+      m_sampleTimer(
+          sampleInterval, [this] { sample(); }, m_stepperMotor->getId() + "TelemetrySampler"),
+      m_summaryTimer(
+          sampleInterval * std::clamp(decimation, 1u, static_cast<unsigned>(SampleCapacity)),
+          [this] { summarize(); }, m_stepperMotor->getId() + "TelemetrySummary")
+{
+}
+
+MotorTelemetrySampler::~MotorTelemetrySampler()
+{
+    stop();
+}
+
+bool MotorTelemetrySampler::start()
+{
+    assert(m_summaryHandler);
+    if (isRunning())
+    {
+        return true;
+    }
+
+    // Outdated samples of a previous run are dropped.
+    hal::IStepperMotor::Telemetry telemetry;
+    while (m_samples.pop(telemetry))
+    {
+    }
+    m_lostSamples = 0;
+
+    if (!m_summaryTimer.start() || !m_sampleTimer.start())
+    {
+        LOG(error) << m_stepperMotor->getId() << ": Failed to start telemetry sampler";
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void MotorTelemetrySampler::stop()
+{
+    m_sampleTimer.stop();
+    m_summaryTimer.stop();
+}
+
+void MotorTelemetrySampler::sample()
+{
+    hal::IStepperMotor::Telemetry telemetry;
+    if (!m_stepperMotor->getTelemetry(telemetry) || !m_samples.push(telemetry))
+    {
+        ++m_lostSamples;
+    }
+}
+
+void MotorTelemetrySampler::summarize()
+{
+    Summary                       summary;
+    hal::IStepperMotor::Telemetry telemetry;
+    int64_t                       velocitySum = 0;
+    summary.minVelocity                       = std::numeric_limits<int32_t>::max();
+    summary.maxVelocity                       = std::numeric_limits<int32_t>::min();
+    while (m_samples.pop(telemetry))
+    {
+        ++summary.sampleCount;
+        velocitySum += telemetry.velocity;
+        summary.minVelocity = std::min(summary.minVelocity, telemetry.velocity);
+        summary.maxVelocity = std::max(summary.maxVelocity, telemetry.velocity);
+        summary.position    = telemetry.position;
+        summary.errorFlags |= telemetry.errorFlags;
+        summary.isEnergized = telemetry.isEnergized;
+    }
+    summary.lostSamples = m_lostSamples.exchange(0);
+
+    if (summary.sampleCount == 0)
+    {
+        if (summary.lostSamples > 0)
+        {
+            LOG(warning) << m_stepperMotor->getId() << ": No telemetry sample available";
+        }
+        return;
+    }
+
+    summary.velocity = static_cast<int32_t>(velocitySum / summary.sampleCount);
+    m_summaryHandler(summary);
+}
@@ -24,6 +24,7 @@
 
 #include <cassert>
 #include <string>
+#include <utility>
 
 #include "HardwareAbstractionLayer/IHardwareAbstractionLayer.hpp"
 #include "MachineServiceComponent/Protocol.hpp"
@@ -43,6 +44,9 @@ UserInterfaceControl::UserInterfaceControl(message_broker::IMessageBroker& messa
       m_userLightService(hal::id::GpioPinRelaySwitchLightPower, hal::id::GpioPinRelaySwitchLightRun,
                          hal::id::GpioPinRelaySwitchLightReady, serviceLocator)
 {
+    namespace rp = remote_control::id;
+    (void)m_stateSnapshot.set(rp::State, convertToString(Event::MachineSwitchedOff));
+    (void)m_stateSnapshot.set(rp::Speed, 0u);
 }
 
 std::string UserInterfaceControl::convertToString(const UserInterfaceControl::Event& event)
@@ -64,24 +68,15 @@ std::string UserInterfaceControl::convertToString(const UserInterfaceControl::Ev
     return "";
 }
 
-common::Json UserInterfaceControl::createStateMessage(const std::string& type)
+common::Json UserInterfaceControl::createStateMessage(const std::string& type,
+                                                      common::Json       values,
+                                                      MachineStateSnapshot::Version version)
 {
-    namespace rp                          = remote_control::id;
-    unsigned                        speed = 0;
-    message_broker::ResponseMessage machineResponse{};
-    const auto                      success = send(IMachineControl::RequestGetMotorSpeed);
-
-    if (success && !machineResponse.getPayload().empty())
-    {
-        auto response  = common::Json::parse(machineResponse.getPayload());
-        auto jsonSpeed = response.at(id::Speed);
-        speed          = (jsonSpeed.empty()) ? 0 : jsonSpeed.get<unsigned>();
-    }
-
-    return common::Json({{rp::Type, type},
-                         {rp::Result, rp::ResultSuccess},
-                         {rp::State, convertToString(m_lastMachineEvent)},
-                         {rp::Speed, speed}});
+    namespace rp        = remote_control::id;
+    values[rp::Type]    = type;
+    values[rp::Result]  = rp::ResultSuccess;
+    values[rp::Version] = version;
+    return values;
 }
 
 bool UserInterfaceControl::receiveRequest(remote_control::IClientRequestHandler::ClientId clientId,
@@ -101,7 +96,27 @@ bool UserInterfaceControl::receiveRequest(remote_control::IClientRequestHandler:
     const auto typeValue = type.get<std::string>();
     if (typeValue == rp::TypeRequestState)
     {
-        response = createStateMessage(rp::TypeResponseState);
+        // Clients knowing a version get the changes since then only.
+        MachineStateSnapshot::Version version = 0;
+        common::Json                  values;
+        const auto                    since = request.find(rp::Version);
+        if (since == request.end())
+        {
+            values = m_stateSnapshot.get(version);
+        }
+        else if (since->is_number_unsigned())
+        {
+            values = m_stateSnapshot.getChangesSince(
+                since->get<MachineStateSnapshot::Version>(), version);
+        }
+        else
+        {
+            response = {{rp::Type, rp::TypeResponseRequest},
+                        {rp::Result, rp::ResultError},
+                        {rp::ErrorReason, rp::ErrorVersionInvalid}};
+            return true;
+        }
+        response = createStateMessage(rp::TypeResponseState, std::move(values), version);
     }
     else if (typeValue == rp::TypeRequestCommand)
     {
@@ -171,7 +186,24 @@ void UserInterfaceControl::updateMachineState()
         return;
     }
 
-    m_cbSendNotification(createStateMessage(rp::TypeNotificationState));
+    MachineStateSnapshot::Version version = 0;
+    auto                          values  = m_stateSnapshot.get(version);
+    m_cbSendNotification(createStateMessage(rp::TypeNotificationState, std::move(values), version));
+}
+
+void UserInterfaceControl::forwardMotorTelemetry(const hal::Identifier&         motor,
+                                                 const message_broker::Message& notification)
+{
+    namespace rp = remote_control::id;
+
+    if (m_cbSendNotification == nullptr)
+    {
+        return;
+    }
+
+    m_cbSendNotification({{rp::Type, rp::TypeNotificationTelemetry},
+                          {rp::Motor, motor},
+                          {rp::Telemetry, common::Json::parse(notification.getPayload())}});
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -213,12 +245,35 @@ void UserInterfaceControl::onNotificationMachineControlErrorOccurred(
     (void)handleEventMessage(request, Event::MachineError);
 }
 
+void UserInterfaceControl::onNotificationMachineControlMotorSpeedChanged(
+    const message_broker::Message& request)
+{
+    namespace rp     = remote_control::id;
+    const auto speed = common::Json::parse(request.getPayload()).at(id::Speed).get<unsigned>();
+    if (m_stateSnapshot.set(rp::Speed, speed))
+    {
+        updateMachineState();
+    }
+}
+
+void UserInterfaceControl::onNotificationFilamentFeederMotorMotorTelemetry(
+    const message_broker::Message& request)
+{
+    forwardMotorTelemetry(hal::id::StepperMotorFeeder, request);
+}
+
+void UserInterfaceControl::onNotificationFilamentCoilMotorMotorTelemetry(
+    const message_broker::Message& request)
+{
+    forwardMotorTelemetry(hal::id::StepperMotorCoiler, request);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Transition actions:
 
 void UserInterfaceControl::handleMachineStateChange(const Event& event, const State&)
 {
-    m_lastMachineEvent = event;
+    namespace rp = remote_control::id;
 
     switch (event)
     {
@@ -238,5 +293,10 @@ void UserInterfaceControl::handleMachineStateChange(const Event& event, const St
             m_userLightService.switchLight(true, true, true);
             break;
     }
-    updateMachineState();
+
+    // Heating up and starting are the same state for the clients.
+    if (m_stateSnapshot.set(rp::State, convertToString(event)))
+    {
+        updateMachineState();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,234 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include "Common/Configuration.hpp"
+#include "Common/ConfigurationFileParser.hpp"
+#include "Common/Logger.hpp"
+#include "Common/ServiceLocator.hpp"
+#include "HardwareAbstractionLayer/Configuration.hpp"
+#include "HardwareAbstractionLayer/HardwareAbstractionLayer.hpp"
+#include "HardwareAbstractionLayer/Identifier.hpp"
+#include "HardwareAbstractionLayer/Simulator.hpp"
+#include "HardwareAbstractionLayer/ThermalModel.hpp"
+#include "MachineServiceComponent/Configuration.hpp"
+#include "MachineServiceComponent/HeaterService.hpp"
+
+using namespace sugo;
+using namespace sugo::machine_service_component;
+
+namespace
+{
+/// Used clock type of the simulation.
+using SimulatedClock = hal::Simulator::Clock;
+
+constexpr float    TemperatureMin     = 195.0f;
+constexpr float    TemperatureMax     = 205.0f;
+constexpr double   TemperatureTarget  = (TemperatureMin + TemperatureMax) / 2.0;
+constexpr unsigned ControlWindow      = 5000;  // ms
+constexpr unsigned ControlTicks       = 20;    // per control window
+constexpr unsigned ObservationTimeout = 1000;  // ms
+constexpr std::chrono::seconds      SimulationTime{1200};
+constexpr std::chrono::seconds      SteadyStateTime{600};
+constexpr std::chrono::milliseconds ControlTick{ControlWindow / ControlTicks};
+constexpr std::chrono::milliseconds SampleInterval{ObservationTimeout};
+constexpr char HalConfigFile[] = "HardwareAbstractionLayerSmokeTestConfig.json";
+
+const hal::ThermalModel::Parameters HeaterModel{25.0, 300.0, 150.0, 8.0, 0.1};
+
+struct ControlResult
+{
+    double timeToTarget = -1.0;            // s until the first limit event above the minimum
+    double peak         = 0.0;             // °C
+    double rippleMin    = TemperatureMax;  // °C in steady state
+    double rippleMax    = TemperatureMin;  // °C in steady state
+};
+
+/**
+ * @brief Heater service, which switches the relay at the limits like the machine heaters do and
+ * records the time of the first limit event above the minimum. The temperature observation and
+ * the control ticks are driven by the benchmark in simulated time.
+ */
+class BenchmarkHeater : public HeaterService
+{
+public:
+    using HeaterService::HeaterService;
+    using HeaterService::updateHeaterControl;
+    using HeaterService::updateHeaterTemperatureAndCheck;
+
+    bool start(bool isPidControlled)
+    {
+        // The simulated sensor does not publish samples, it is polled by the benchmark.
+        if (prepareTemperatureObservation())
+        {
+            return false;
+        }
+        return !isPidControlled || prepareHeaterControl();
+    }
+
+    void stop()
+    {
+        stopHeaterControl();
+        stopTemperatureObservation();
+        (void)switchHeater(false);
+    }
+
+    std::optional<SimulatedClock::time_point> getTargetReachedTime() const
+    {
+        return m_targetReachedTime;
+    }
+
+protected:
+    void onTemperatureLimitEvent(TemperatureLimitEvent event) override
+    {
+        if ((event != TemperatureLimitEvent::MinTemperatureReached) &&
+            !m_targetReachedTime.has_value())
+        {
+            m_targetReachedTime = hal::Simulator::getInstance().now();
+        }
+        (void)setHeating(event == TemperatureLimitEvent::MinTemperatureReached);
+    }
+
+private:
+    std::optional<SimulatedClock::time_point> m_targetReachedTime;
+};
+
+/**
+ * @brief Runs the heater service in the passed control mode against the simulated heater.
+ *
+ * @param hal         Hardware abstraction layer of the simulated machine.
+ * @param controlMode Heater control mode.
+ * @return The control result in simulated time.
+ */
+ControlResult runControl(hal::IHardwareAbstractionLayer& hal, const std::string& controlMode)
+{
+    common::Configuration configuration{
+        common::Option(id::ConfigHeaterTemperatureMin, TemperatureMin, ""),
+        common::Option(id::ConfigHeaterTemperatureMax, TemperatureMax, ""),
+        common::Option(id::ConfigHeaterControl, controlMode, ""),
+        common::Option(id::ConfigHeaterControlWindow, ControlWindow, ""),
+        common::Option(id::ConfigHeaterPidProportional, def::ConfigHeaterPidProportional, ""),
+        common::Option(id::ConfigHeaterPidIntegral, def::ConfigHeaterPidIntegral, ""),
+        common::Option(id::ConfigHeaterPidDerivative, def::ConfigHeaterPidDerivative, ""),
+        common::Option(id::ConfigHeaterPidAutoTune, false, ""),
+        common::Option(id::ConfigObservationTimeoutTemperature, ObservationTimeout, "")};
+    common::ServiceLocator serviceLocator;
+    serviceLocator.add<common::IConfiguration>(configuration);
+    serviceLocator.add<hal::IHardwareAbstractionLayer>(hal);
+
+    ControlResult result;
+    auto&         simulator = hal::Simulator::getInstance();
+    if (!simulator.setThermalModel(hal::id::TemperatureSensorMerger, HeaterModel))
+    {
+        LOG(error) << "Failed to set the thermal model";
+        return result;
+    }
+
+    const bool      isPidControlled = (controlMode == "pid");
+    BenchmarkHeater heater(hal::id::GpioPinRelaySwitchHeaterMerger,
+                           hal::id::TemperatureSensorMerger, serviceLocator);
+    if (!heater.start(isPidControlled))
+    {
+        LOG(error) << "Failed to start the heater control";
+        return result;
+    }
+
+    // The temperature is polled and the relay is driven in control ticks of simulated time.
+    const auto startTime = simulator.now();
+    for (std::chrono::milliseconds time{0}; time < SimulationTime; time += ControlTick)
+    {
+        if ((time % SampleInterval).count() == 0)
+        {
+            heater.updateHeaterTemperatureAndCheck();
+            const double temperature =
+                static_cast<double>(heater.getTemperatureSnapshot().temperature) /
+                hal::ITemperatureSensor::DeciCelciusPerCelcius;
+            result.peak = std::max(result.peak, temperature);
+            if (time >= SteadyStateTime)
+            {
+                result.rippleMin = std::min(result.rippleMin, temperature);
+                result.rippleMax = std::max(result.rippleMax, temperature);
+            }
+        }
+        if (isPidControlled)
+        {
+            heater.updateHeaterControl();
+        }
+        (void)simulator.advanceTime(ControlTick);
+    }
+    heater.stop();
+
+    const auto targetReachedTime = heater.getTargetReachedTime();
+    if (targetReachedTime.has_value())
+    {
+        result.timeToTarget =
+            std::chrono::duration<double>(targetReachedTime.value() - startTime).count();
+    }
+    return result;
+}
+
+void printResult(const char* name, const ControlResult& result)
+{
+    std::cout << name << ": time to target " << result.timeToTarget << "s, overshoot "
+              << (result.peak - TemperatureTarget) << "K, steady state ripple "
+              << (result.rippleMax - result.rippleMin) << "K" << std::endl;
+}
+}  // namespace
+
+int main()
+{
+    common::Logger::init(common::Logger::Severity::error);
+
+    std::ifstream inStream(HalConfigFile);
+    if (!inStream.is_open())
+    {
+        std::cerr << "Failed to open " << HalConfigFile << std::endl;
+        return 1;
+    }
+    common::Configuration           halConfiguration;
+    common::ConfigurationFileParser parser(inStream);
+    hal::config::addConfigurationOptions(halConfiguration);
+    parser.add(halConfiguration);
+    hal::HardwareAbstractionLayer hal;
+    if (!parser.parse() || !hal.init(halConfiguration))
+    {
+        std::cerr << "Failed to initialize the hardware abstraction layer" << std::endl;
+        return 1;
+    }
+
+    auto& simulator = hal::Simulator::getInstance();
+    simulator.enableSimulatedTime(true);
+    std::cout << "Heater control of " << SimulationTime.count() << "s simulated time" << std::endl;
+    printResult("Hysteresis", runControl(hal, "hysteresis"));
+    printResult("PID       ", runControl(hal, "pid"));
+    simulator.enableSimulatedTime(false);
+    hal.finalize();
+    return 0;
+}
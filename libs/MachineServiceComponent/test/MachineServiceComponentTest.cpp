@@ -24,15 +24,28 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "Common/IConfigurationMock.hpp"
 #include "Common/IProcessContextMock.hpp"
 #include "Common/Logger.hpp"
 #include "Common/ServiceLocator.hpp"
+#include "HardwareAbstractionLayer/IGpioControlMock.hpp"
+#include "HardwareAbstractionLayer/IGpioPinMock.hpp"
 #include "HardwareAbstractionLayer/IHardwareAbstractionLayerMock.hpp"
 #include "HardwareAbstractionLayer/IStepperMotorControlMock.hpp"
 #include "HardwareAbstractionLayer/IStepperMotorMock.hpp"
+#include "HardwareAbstractionLayer/ITemperatureSensorControlMock.hpp"
+#include "HardwareAbstractionLayer/ITemperatureSensorMock.hpp"
+#include "MachineServiceComponent/MachineStateSnapshot.hpp"
+#include "MachineServiceComponent/MotorTelemetrySampler.hpp"
 #include "MachineServiceComponent/Protocol.hpp"
 #include "MachineServiceComponentTest.hpp"
 #include "MachineServiceComponentTest/MachineConfiguration.hpp"
@@ -44,6 +57,7 @@ using namespace sugo::hal;
 using namespace sugo::machine_service_component;
 using namespace sugo::message_broker;
 
+using ::testing::_;
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::ReturnRef;
@@ -55,7 +69,11 @@ class MachineServiceComponentTest : public ::testing::Test
 protected:
     MachineServiceComponentTest()
         : m_mockStepperMotorControl(new NiceMock<IStepperMotorControlMock>()),
-          m_mockStepperMotor(new IStepperMotorMock())
+          m_mockStepperMotor(new IStepperMotorMock()),
+          m_mockTemperatureSensorControl(new NiceMock<ITemperatureSensorControlMock>()),
+          m_mockTemperatureSensor(new NiceMock<ITemperatureSensorMock>()),
+          m_mockGpioControl(new NiceMock<IGpioControlMock>()),
+          m_mockHeaterPin(new NiceMock<IGpioPinMock>(HeaterName))
     {
     }
 
@@ -63,6 +81,11 @@ protected:
     {
         m_stepperMotorControllerMap.emplace(StepperMotorControlName, m_mockStepperMotorControl);
         m_stepperMotorMap.emplace(StepperMotorName, m_mockStepperMotor);
+        m_temperatureSensorControllerMap.emplace(hal::id::TemperatureSensorControl,
+                                                 m_mockTemperatureSensorControl);
+        m_temperatureSensorMap.emplace(TemperatureSensorName, m_mockTemperatureSensor);
+        m_gpioControllerMap.emplace(hal::id::GpioControl, m_mockGpioControl);
+        m_gpioPinMap.emplace(HeaterName, m_mockHeaterPin);
         m_serviceLocator.add<IHardwareAbstractionLayer>(m_mockHardwareAbstractionLayer);
         m_serviceLocator.add<common::IConfiguration>(m_mockConfiguration);
         m_machineConfig.prepareOptions(m_mockConfiguration);
@@ -70,6 +93,14 @@ protected:
             .WillByDefault(ReturnRef(m_stepperMotorControllerMap));
         ON_CALL(*m_mockStepperMotorControl, getStepperMotorMap())
             .WillByDefault(ReturnRef(m_stepperMotorMap));
+        ON_CALL(m_mockHardwareAbstractionLayer, getTemperatureSensorControllerMap())
+            .WillByDefault(ReturnRef(m_temperatureSensorControllerMap));
+        ON_CALL(*m_mockTemperatureSensorControl, getTemperatureSensorMap())
+            .WillByDefault(ReturnRef(m_temperatureSensorMap));
+        ON_CALL(m_mockHardwareAbstractionLayer, getGpioControllerMap())
+            .WillByDefault(ReturnRef(m_gpioControllerMap));
+        ON_CALL(*m_mockGpioControl, getGpioPinMap()).WillByDefault(ReturnRef(m_gpioPinMap));
+        EXPECT_CALL(*m_mockStepperMotor, getTelemetry(_)).WillRepeatedly(Return(true));
     }
 
     void TearDown() override
@@ -92,12 +123,22 @@ protected:
 
     inline static const std::string StepperMotorName{"coiler"};
     inline static const std::string StepperMotorControlName{hal::id::StepperMotorControl};
+    inline static const std::string HeaterName{"heater"};
+    inline static const std::string TemperatureSensorName{"temperature"};
 
-    IHardwareAbstractionLayer::StepperMotorControllerMap m_stepperMotorControllerMap;
-    IStepperMotorControl::StepperMotorMap                m_stepperMotorMap;
+    IHardwareAbstractionLayer::StepperMotorControllerMap      m_stepperMotorControllerMap;
+    IStepperMotorControl::StepperMotorMap                     m_stepperMotorMap;
+    IHardwareAbstractionLayer::TemperatureSensorControllerMap m_temperatureSensorControllerMap;
+    ITemperatureSensorControl::TemperatureSensorMap           m_temperatureSensorMap;
+    IHardwareAbstractionLayer::GpioControllerMap              m_gpioControllerMap;
+    IGpioControl::GpioPinMap                                  m_gpioPinMap;
 
-    std::shared_ptr<IStepperMotorControlMock> m_mockStepperMotorControl;
-    std::shared_ptr<IStepperMotorMock>        m_mockStepperMotor;
+    std::shared_ptr<IStepperMotorControlMock>      m_mockStepperMotorControl;
+    std::shared_ptr<IStepperMotorMock>             m_mockStepperMotor;
+    std::shared_ptr<ITemperatureSensorControlMock> m_mockTemperatureSensorControl;
+    std::shared_ptr<ITemperatureSensorMock>        m_mockTemperatureSensor;
+    std::shared_ptr<IGpioControlMock>              m_mockGpioControl;
+    std::shared_ptr<IGpioPinMock>                  m_mockHeaterPin;
 
     NiceMock<IHardwareAbstractionLayerMock> m_mockHardwareAbstractionLayer;
     NiceMock<IMessageBrokerMock>            m_mockRequestMessageBroker;
@@ -126,19 +167,40 @@ TEST_F(MachineServiceComponentTest, StartFilamentCoilMotor)
     processAllEvents(filamentCoilMotor);
     EXPECT_EQ(filamentCoilMotor.getCurrentState(), FilamentCoilMotor::State::Stopped);
 
-    // Set motor speed
+    // Set motor speed, which is passed in RPM and set as fixed-point value
+    const IStepperMotor::Speed defaultSpeed{
+        test::MachineConfiguration::MotorSpeedDefault * IStepperMotor::MilliRpmPerRpm,
+        Unit::MilliRpm};
     const common::Json parameters(
         {{machine_service_component::id::Speed, test::MachineConfiguration::MotorSpeedDefault}});
     request.setPayload(parameters.dump());
-    EXPECT_CALL(*m_mockStepperMotor, setSpeed(IStepperMotor::Speed{
-                                         test::MachineConfiguration::MotorSpeedDefault, Unit::Rpm}))
-        .WillOnce(Return(true));
+    EXPECT_CALL(*m_mockStepperMotor, setSpeed(defaultSpeed)).WillOnce(Return(true));
     response = filamentCoilMotor.onRequestSetMotorSpeed(request);
     EXPECT_EQ(response.getResult(), message_broker::ResponseMessage::Result::Success);
 
-    EXPECT_CALL(*m_mockStepperMotor, setSpeed(IStepperMotor::Speed{
-                                         test::MachineConfiguration::MotorSpeedDefault, Unit::Rpm}))
-        .WillOnce(Return(true));
+    // Synchronized speed changes are passed to the motor, which holds them back
+    const common::Json synchronizedParameters(
+        {{machine_service_component::id::Speed, test::MachineConfiguration::MotorSpeedDefault},
+         {machine_service_component::id::Synchronized, true}});
+    request.setPayload(synchronizedParameters.dump());
+    EXPECT_CALL(*m_mockStepperMotor, setSpeedSynchronized(defaultSpeed)).WillOnce(Return(true));
+    response = filamentCoilMotor.onRequestSetMotorSpeed(request);
+    EXPECT_EQ(response.getResult(), message_broker::ResponseMessage::Result::Success);
+
+    // A canceled speed change keeps the former speed, which is set again if it was not held back
+    const common::Json cancelParameters(
+        {{machine_service_component::id::Speed, test::MachineConfiguration::MotorSpeedDefault},
+         {machine_service_component::id::Cancel, true}});
+    request.setPayload(cancelParameters.dump());
+    EXPECT_CALL(*m_mockStepperMotor, cancelSpeedSynchronized()).WillOnce(Return(true));
+    response = filamentCoilMotor.onRequestSetMotorSpeed(request);
+    EXPECT_EQ(response.getResult(), message_broker::ResponseMessage::Result::Success);
+    EXPECT_CALL(*m_mockStepperMotor, cancelSpeedSynchronized()).WillOnce(Return(false));
+    EXPECT_CALL(*m_mockStepperMotor, setSpeed(defaultSpeed)).WillOnce(Return(false));
+    response = filamentCoilMotor.onRequestSetMotorSpeed(request);
+    EXPECT_EQ(response.getResult(), message_broker::ResponseMessage::Result::Error);
+
+    EXPECT_CALL(*m_mockStepperMotor, setSpeed(defaultSpeed)).WillOnce(Return(true));
     EXPECT_CALL(*m_mockStepperMotor, rotate()).WillOnce(Return(true));
     response = filamentCoilMotor.onRequestStartMotor(request);
     processAllEvents(filamentCoilMotor);
@@ -146,4 +208,373 @@ TEST_F(MachineServiceComponentTest, StartFilamentCoilMotor)
     EXPECT_EQ(response.getResult(), message_broker::ResponseMessage::Result::Success);
     EXPECT_EQ(filamentCoilMotor.getCurrentState(), FilamentCoilMotor::State::Running);
 }
-}  // namespace sugo::test
\ No newline at end of file
+
+TEST_F(MachineServiceComponentTest, StopFilamentCoilMotor)
+{
+    EXPECT_CALL(*m_mockStepperMotor, getMaxSpeed())
+        .WillOnce(Return(IStepperMotor::Speed(100, Unit::Rpm)));
+    EXPECT_CALL(m_mockProcessContext, start()).WillOnce(Return(true));
+    FilamentCoilMotorTestable filamentCoilMotor(m_mockRequestMessageBroker, m_mockProcessContext,
+                                                m_serviceLocator);
+
+    EXPECT_CALL(m_mockRequestMessageBroker, start()).WillOnce(Return(true));
+    EXPECT_TRUE(filamentCoilMotor.start());
+
+    EXPECT_CALL(*m_mockStepperMotor, reset()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockStepperMotor, setSpeed(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mockStepperMotor, rotate()).WillOnce(Return(true));
+    message_broker::Message request;
+    (void)filamentCoilMotor.onRequestSwitchOn(request);
+    processAllEvents(filamentCoilMotor);
+    (void)filamentCoilMotor.onRequestStartMotor(request);
+    processAllEvents(filamentCoilMotor);
+    EXPECT_EQ(filamentCoilMotor.getCurrentState(), FilamentCoilMotor::State::Running);
+
+    // Motor ramps down asynchronously
+    IStepperMotor::MotionCompletionHandler stopCompletion;
+    EXPECT_CALL(*m_mockStepperMotor, stopAsync(false, _))
+        .WillOnce([&](bool, IStepperMotor::MotionCompletionHandler handler) {
+            stopCompletion = std::move(handler);
+            return true;
+        });
+    auto response = filamentCoilMotor.onRequestStopMotor(request);
+    EXPECT_EQ(response.getResult(), message_broker::ResponseMessage::Result::Success);
+    processAllEvents(filamentCoilMotor);
+    EXPECT_EQ(filamentCoilMotor.getCurrentState(), FilamentCoilMotor::State::Stopping);
+
+    ASSERT_TRUE(stopCompletion);
+    stopCompletion(IStepperMotor::MotionSucceeded);
+    processAllEvents(filamentCoilMotor);
+    EXPECT_EQ(filamentCoilMotor.getCurrentState(), FilamentCoilMotor::State::Stopped);
+}
+TEST_F(MachineServiceComponentTest, FilamentCoilMotorTensionControl)
+{
+    EXPECT_CALL(*m_mockStepperMotor, getMaxSpeed())
+        .WillOnce(Return(IStepperMotor::Speed(100, Unit::Rpm)));
+    EXPECT_CALL(m_mockProcessContext, start()).WillOnce(Return(true));
+    FilamentCoilMotorTestable filamentCoilMotor(m_mockRequestMessageBroker, m_mockProcessContext,
+                                                m_serviceLocator);
+
+    EXPECT_CALL(m_mockRequestMessageBroker, start()).WillOnce(Return(true));
+    EXPECT_TRUE(filamentCoilMotor.start());
+
+    std::mutex              mutex;
+    std::condition_variable speedChanged;
+    std::vector<int>        speeds;
+    EXPECT_CALL(*m_mockStepperMotor, reset()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockStepperMotor, rotate()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockStepperMotor, setSpeed(_))
+        .WillRepeatedly([&](const IStepperMotor::Speed& speed) {
+            std::lock_guard<std::mutex> lock(mutex);
+            speeds.push_back(static_cast<int>(speed.getValue()));
+            speedChanged.notify_all();
+            return true;
+        });
+    message_broker::Message request;
+    (void)filamentCoilMotor.onRequestSwitchOn(request);
+    processAllEvents(filamentCoilMotor);
+    request.setPayload(common::Json({{machine_service_component::id::Speed,
+                                      test::MachineConfiguration::MotorSpeedDefault}})
+                           .dump());
+    (void)filamentCoilMotor.onRequestSetMotorSpeed(request);
+    (void)filamentCoilMotor.onRequestStartMotor(request);
+    processAllEvents(filamentCoilMotor);
+    ASSERT_EQ(filamentCoilMotor.getCurrentState(), FilamentCoilMotor::State::Running);
+
+    constexpr int milliRpmPerRpm = static_cast<int>(IStepperMotor::MilliRpmPerRpm);
+    const int     defaultSpeed =
+        static_cast<int>(test::MachineConfiguration::MotorSpeedDefault) * milliRpmPerRpm;
+    const int proportionalSpeed =
+        static_cast<int>(test::MachineConfiguration::TensionControlProportional) * milliRpmPerRpm;
+    const std::chrono::milliseconds controlInterval{
+        test::MachineConfiguration::TensionControlInterval};
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // Low tension speeds up the motor by the proportional part at once.
+    request.setPayload(common::Json({{machine_service_component::id::Tension,
+                                      machine_service_component::id::TensionLow}})
+                           .dump());
+    size_t speedIndex = speeds.size();
+    lock.unlock();
+    auto response = filamentCoilMotor.onRequestSetFilamentTension(request);
+    EXPECT_EQ(response.getResult(), message_broker::ResponseMessage::Result::Success);
+    lock.lock();
+    ASSERT_GT(speeds.size(), speedIndex);
+    EXPECT_EQ(speeds[speedIndex], defaultSpeed + proportionalSpeed);
+
+    // Then the integral part trims the speed continuously in sub-RPM steps.
+    ASSERT_TRUE(speedChanged.wait_for(lock, 100 * controlInterval, [&] {
+        return speeds.back() >= (defaultSpeed + proportionalSpeed + milliRpmPerRpm);
+    }));
+    for (size_t index = speedIndex + 1; index < speeds.size(); ++index)
+    {
+        EXPECT_GT(speeds[index], speeds[index - 1]);
+        EXPECT_LT(speeds[index] - speeds[index - 1], milliRpmPerRpm);
+    }
+
+    // Back at normal tension, only the proportional part is dropped.
+    request.setPayload(common::Json({{machine_service_component::id::Tension,
+                                      machine_service_component::id::TensionNormal}})
+                           .dump());
+    speedIndex = speeds.size();
+    lock.unlock();
+    response = filamentCoilMotor.onRequestSetFilamentTension(request);
+    EXPECT_EQ(response.getResult(), message_broker::ResponseMessage::Result::Success);
+    lock.lock();
+    ASSERT_GT(speeds.size(), speedIndex);
+    const int lowTensionSpeed = speeds[speeds.size() - 2];
+    const int trimmedSpeed    = speeds.back();
+    EXPECT_GT(trimmedSpeed, defaultSpeed + milliRpmPerRpm);
+    EXPECT_GT(trimmedSpeed, lowTensionSpeed - proportionalSpeed);
+    EXPECT_LT(trimmedSpeed, lowTensionSpeed - proportionalSpeed + milliRpmPerRpm);
+
+    // The integral part is kept as speed trim, so the speed is not changed anymore.
+    speedIndex = speeds.size();
+    EXPECT_FALSE(speedChanged.wait_for(lock, 4 * controlInterval,
+                                       [&] { return speeds.size() > speedIndex; }));
+    EXPECT_EQ(speeds.back(), trimmedSpeed);
+    lock.unlock();
+
+    request.setPayload(common::Json({{machine_service_component::id::Tension, "unknown"}}).dump());
+    response = filamentCoilMotor.onRequestSetFilamentTension(request);
+    EXPECT_EQ(response.getResult(), message_broker::ResponseMessage::Result::InvalidPayload);
+}
+
+TEST_F(MachineServiceComponentTest, MotorTelemetrySamplerSummaries)
+{
+    constexpr unsigned      Decimation = 4u;
+    IStepperMotor::Position position   = 0;
+    EXPECT_CALL(*m_mockStepperMotor, getTelemetry(_))
+        .WillRepeatedly([&position](IStepperMotor::Telemetry& telemetry) {
+            // Every fourth sample fails, the others alternate between slow and fast.
+            ++position;
+            if ((position % 4) == 0)
+            {
+                return false;
+            }
+            telemetry.position    = position;
+            telemetry.velocity    = ((position % 2) == 0) ? 1000 : 3000;
+            telemetry.errorFlags  = ((position % 4) == 3) ? 0x4 : 0;
+            telemetry.isEnergized = true;
+            return true;
+        });
+
+    std::mutex                                  mutex;
+    std::vector<MotorTelemetrySampler::Summary> summaries;
+    auto summaryHandler = [&](const MotorTelemetrySampler::Summary& summary) {
+        std::lock_guard<std::mutex> lock(mutex);
+        summaries.push_back(summary);
+    };
+    MotorTelemetrySampler sampler(m_mockStepperMotor, std::chrono::milliseconds(5), Decimation,
+                                  summaryHandler);
+
+    EXPECT_TRUE(sampler.start());
+    EXPECT_TRUE(sampler.isRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    sampler.stop();
+    EXPECT_FALSE(sampler.isRunning());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_GE(summaries.size(), 2u);
+    unsigned                sampleCount  = 0;
+    unsigned                lostSamples  = 0;
+    IStepperMotor::Position lastPosition = 0;
+    for (const auto& summary : summaries)
+    {
+        EXPECT_GT(summary.sampleCount, 0u);
+        EXPECT_GE(summary.minVelocity, 1000);
+        EXPECT_LE(summary.maxVelocity, 3000);
+        EXPECT_GE(summary.velocity, summary.minVelocity);
+        EXPECT_LE(summary.velocity, summary.maxVelocity);
+        EXPECT_GT(summary.position, lastPosition);
+        EXPECT_TRUE(summary.isEnergized);
+        sampleCount += summary.sampleCount;
+        lostSamples += summary.lostSamples;
+        lastPosition = summary.position;
+    }
+
+    // All samples are summarized, but none of the failed ones.
+    EXPECT_LE(sampleCount + lostSamples, static_cast<unsigned>(position));
+    EXPECT_GT(lostSamples, 0u);
+    EXPECT_GE(sampleCount, lostSamples * 2u);
+    const auto& summary = summaries.back();
+    if (summary.sampleCount >= Decimation)
+    {
+        EXPECT_EQ(summary.minVelocity, 1000);
+        EXPECT_EQ(summary.maxVelocity, 3000);
+        EXPECT_EQ(summary.errorFlags, 0x4u);
+    }
+}
+
+TEST_F(MachineServiceComponentTest, MachineStateSnapshotChanges)
+{
+    MachineStateSnapshot          snapshot;
+    MachineStateSnapshot::Version version = 0;
+    EXPECT_EQ(snapshot.getVersion(), 0u);
+    EXPECT_TRUE(snapshot.get(version).empty());
+
+    EXPECT_TRUE(snapshot.set("state", "off"));
+    EXPECT_TRUE(snapshot.set("speed", 0));
+    EXPECT_EQ(snapshot.get(version), common::Json({{"state", "off"}, {"speed", 0}}));
+    EXPECT_EQ(version, 2u);
+
+    // Setting the same value again is no change.
+    EXPECT_FALSE(snapshot.set("state", "off"));
+    EXPECT_EQ(snapshot.getVersion(), 2u);
+
+    const MachineStateSnapshot::Version knownVersion = version;
+    EXPECT_TRUE(snapshot.set("speed", 100));
+    EXPECT_EQ(snapshot.getChangesSince(knownVersion, version), common::Json({{"speed", 100}}));
+    EXPECT_EQ(version, 3u);
+    EXPECT_TRUE(snapshot.getChangesSince(version, version).empty());
+
+    // Unknown versions are answered with the whole snapshot.
+    EXPECT_EQ(snapshot.getChangesSince(version + 1, version),
+              common::Json({{"state", "off"}, {"speed", 100}}));
+}
+
+TEST_F(MachineServiceComponentTest, HeaterServiceMedianTemperature)
+{
+    HeaterServiceTestable heaterService(HeaterName, TemperatureSensorName, m_serviceLocator);
+    EXPECT_EQ(heaterService.getTemperatureSnapshot().temperature, 0);
+
+    // A single spike is suppressed by the median of the latest samples, the upper one of an even
+    // number of samples is used.
+    const std::vector<std::pair<int32_t, int32_t>> samplesAndMedians = {
+        {200, 200}, {210, 210}, {900, 210}, {220, 220}, {230, 220}, {240, 230}, {250, 240}};
+    for (const auto& [sample, median] : samplesAndMedians)
+    {
+        EXPECT_CALL(*m_mockTemperatureSensor, getTemperature())
+            .WillOnce(Return(ITemperatureSensor::Temperature(sample, Unit::DeciCelcius)));
+        heaterService.updateHeaterTemperature();
+        EXPECT_EQ(heaterService.getTemperatureSnapshot().temperature, median);
+    }
+    EXPECT_EQ(heaterService.getTemperature(), 24);
+
+    // Samples in Celcius are converted to the fixed-point value.
+    EXPECT_CALL(*m_mockTemperatureSensor, getTemperature())
+        .WillRepeatedly(Return(ITemperatureSensor::Temperature(30, Unit::Celcius)));
+    for (int i = 0; i < 3; ++i)
+    {
+        heaterService.updateHeaterTemperature();
+    }
+    EXPECT_EQ(heaterService.getTemperatureSnapshot().temperature, 300);
+    EXPECT_EQ(heaterService.getTemperature(), 30);
+
+    // The error values of the sensor are not rounded.
+    EXPECT_CALL(*m_mockTemperatureSensor, getTemperature())
+        .WillRepeatedly(Return(ITemperatureSensor::Temperature(
+            std::numeric_limits<ITemperatureSensor::RawTemperature>::max(), Unit::DeciCelcius)));
+    for (int i = 0; i < 5; ++i)
+    {
+        heaterService.updateHeaterTemperature();
+    }
+    EXPECT_EQ(heaterService.getTemperature(),
+              std::numeric_limits<HeaterService::Temperature>::max());
+}
+
+TEST_F(MachineServiceComponentTest, HeaterServiceTemperatureRate)
+{
+    constexpr std::chrono::milliseconds SampleInterval{20};
+    constexpr int32_t                   Step        = 10;   // deci Kelvin per sample
+    constexpr int32_t                   NominalRate = 500;  // deci Kelvin per second
+
+    HeaterServiceTestable heaterService(HeaterName, TemperatureSensorName, m_serviceLocator);
+
+    // The rate is the least squares slope, so it is independent of the absolute value.
+    int32_t temperature = 200;
+    EXPECT_CALL(*m_mockTemperatureSensor, getTemperature()).WillRepeatedly([&temperature] {
+        return ITemperatureSensor::Temperature(temperature, Unit::DeciCelcius);
+    });
+    heaterService.updateHeaterTemperature();
+    EXPECT_EQ(heaterService.getTemperatureSnapshot().rate, 0);
+    for (int i = 0; i < 8; ++i)
+    {
+        std::this_thread::sleep_for(SampleInterval);
+        temperature += Step;
+        heaterService.updateHeaterTemperature();
+    }
+    // The sample interval could only be longer than requested, which lowers the rate.
+    HeaterService::TemperatureSnapshot snapshot = heaterService.getTemperatureSnapshot();
+    EXPECT_GT(snapshot.rate, NominalRate / 5);
+    EXPECT_LE(snapshot.rate, NominalRate + NominalRate / 10);
+
+    // Stopping the observation resets all samples and the snapshot.
+    heaterService.stopTemperatureObservation();
+    snapshot = heaterService.getTemperatureSnapshot();
+    EXPECT_EQ(snapshot.temperature, 0);
+    EXPECT_EQ(snapshot.rate, 0);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        temperature -= Step;
+        heaterService.updateHeaterTemperature();
+        std::this_thread::sleep_for(SampleInterval);
+    }
+    snapshot = heaterService.getTemperatureSnapshot();
+    EXPECT_LT(snapshot.rate, -NominalRate / 5);
+    EXPECT_GE(snapshot.rate, -(NominalRate + NominalRate / 10));
+}
+
+TEST_F(MachineServiceComponentTest, HeaterServicePidControl)
+{
+    constexpr std::chrono::milliseconds ControlWindow{200};
+    MachineConfiguration::HeaterControl       = "pid";
+    MachineConfiguration::HeaterControlWindow = static_cast<unsigned>(ControlWindow.count());
+    m_machineConfig.prepareOptions(m_mockConfiguration);
+    HeaterServiceTestable heaterService(HeaterName, TemperatureSensorName, m_serviceLocator);
+    MachineConfiguration::HeaterControl       = "hysteresis";
+    MachineConfiguration::HeaterControlWindow = 5000u;
+
+    ITemperatureSensor::SampleHandler sampleHandler;
+    EXPECT_CALL(*m_mockTemperatureSensor, registerSampleHandler(_))
+        .WillOnce([&sampleHandler](ITemperatureSensor::SampleHandler handler) {
+            sampleHandler = std::move(handler);
+            return true;
+        })
+        .WillOnce(Return(true));
+    ASSERT_TRUE(heaterService.startTemperatureObservation());
+    ASSERT_TRUE(sampleHandler);
+
+    // The target range is reached above the minimum and the maximum has its own event. Each
+    // temperature is sampled several times to pass the median filter.
+    using Event = HeaterServiceTestable::TemperatureLimitEvent;
+    for (const int temperature : {170, 185, 195, 210, 175})
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            sampleHandler(ITemperatureSensor::Temperature(temperature, Unit::Celcius));
+        }
+    }
+    EXPECT_EQ(heaterService.events,
+              std::vector<Event>({Event::MinTemperatureReached, Event::TargetTemperatureReached,
+                                  Event::TargetTemperatureReached, Event::MaxTemperatureReached,
+                                  Event::MinTemperatureReached}));
+
+    // The relay is driven by the heater control only, which heats at full duty cycle far below
+    // the target temperature.
+    EXPECT_CALL(*m_mockHeaterPin, setState(IGpioPin::State::High)).WillOnce(Return(true));
+    EXPECT_TRUE(heaterService.setHeating(true));
+    for (int i = 0; i < 5; ++i)
+    {
+        sampleHandler(ITemperatureSensor::Temperature(100, Unit::Celcius));
+    }
+    ASSERT_TRUE(heaterService.startHeaterControl());
+    std::this_thread::sleep_for(ControlWindow);
+    heaterService.stopHeaterControl();
+    heaterService.stopTemperatureObservation();
+}
+
+TEST_F(MachineServiceComponentTest, HeaterServiceControlWindowTooShort)
+{
+    MachineConfiguration::HeaterControl       = "pid";
+    MachineConfiguration::HeaterControlWindow = 10u;
+    m_machineConfig.prepareOptions(m_mockConfiguration);
+    HeaterServiceTestable heaterService(HeaterName, TemperatureSensorName, m_serviceLocator);
+    MachineConfiguration::HeaterControl       = "hysteresis";
+    MachineConfiguration::HeaterControlWindow = 5000u;
+
+    EXPECT_CALL(*m_mockHeaterPin, setState(_)).Times(0);
+    EXPECT_FALSE(heaterService.startHeaterControl());
+}
+}  // namespace sugo::test
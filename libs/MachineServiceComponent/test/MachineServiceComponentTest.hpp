@@ -24,8 +24,11 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "Common/IConfigurationMock.hpp"
 #include "MachineServiceComponent/FilamentCoilMotor.hpp"
+#include "MachineServiceComponent/HeaterService.hpp"
 
 namespace sugo::test
 {
@@ -38,5 +41,28 @@ public:
 
     friend class MachineServiceComponentTest;
     FRIEND_TEST(MachineServiceComponentTest, StartFilamentCoilMotor);
+    FRIEND_TEST(MachineServiceComponentTest, StopFilamentCoilMotor);
+    FRIEND_TEST(MachineServiceComponentTest, FilamentCoilMotorTensionControl);
+};
+
+class HeaterServiceTestable : public sugo::machine_service_component::HeaterService
+{
+public:
+    using HeaterService::HeaterService;
+    using HeaterService::getTemperature;
+    using HeaterService::setHeating;
+    using HeaterService::startHeaterControl;
+    using HeaterService::startTemperatureObservation;
+    using HeaterService::stopHeaterControl;
+    using HeaterService::stopTemperatureObservation;
+    using HeaterService::TemperatureLimitEvent;
+    using HeaterService::updateHeaterTemperature;
+
+    void onTemperatureLimitEvent(TemperatureLimitEvent event) override
+    {
+        events.push_back(event);
+    }
+
+    std::vector<TemperatureLimitEvent> events;
 };
 }  // namespace sugo::test
\ No newline at end of file
@@ -24,6 +24,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "Common/IConfigurationMock.hpp"
 
 namespace sugo::test
@@ -31,13 +33,23 @@ namespace sugo::test
 class MachineConfiguration
 {
 public:
-    static unsigned MotorSpeedDefault;
-    static int32_t  DefaultTemperature;
-    static int      HeaterTemperatureMax;
-    static int      HeaterTemperatureMin;
-    static unsigned MotorSpeedIncrement;
-    static unsigned MotorSpeedMax;
-    static unsigned ObservationTimeout;
+    static unsigned    MotorSpeedDefault;
+    static int32_t     DefaultTemperature;
+    static int         HeaterTemperatureMax;
+    static int         HeaterTemperatureMin;
+    static unsigned    MotorSpeedIncrement;
+    static unsigned    MotorSpeedMax;
+    static unsigned    ObservationTimeout;
+    static std::string HeaterControl;
+    static unsigned    HeaterControlWindow;
+    static float       HeaterPidProportional;
+    static float       HeaterPidIntegral;
+    static float       HeaterPidDerivative;
+    static unsigned    TensionControlInterval;
+    static float       TensionControlProportional;
+    static float       TensionControlIntegral;
+    static unsigned    MotorTelemetrySampleInterval;
+    static unsigned    MotorTelemetryDecimation;
 
     void prepareOptions(common::IConfigurationMock& mock);
 
@@ -47,7 +59,18 @@ private:
     common::Option m_optionMotorSpeedIncrement{};
     common::Option m_optionHeaterTemperatureMax{};
     common::Option m_optionHeaterTemperatureMin{};
+    common::Option m_optionHeaterControl{};
+    common::Option m_optionHeaterControlWindow{};
+    common::Option m_optionHeaterPidProportional{};
+    common::Option m_optionHeaterPidIntegral{};
+    common::Option m_optionHeaterPidDerivative{};
+    common::Option m_optionHeaterPidAutoTune{};
     common::Option m_optionObservationTimeoutGpioPin{};
     common::Option m_optionObservationTimeoutTemperature{};
+    common::Option m_optionObservationTimeoutTension{};
+    common::Option m_optionTensionControlProportional{};
+    common::Option m_optionTensionControlIntegral{};
+    common::Option m_optionMotorTelemetrySampleInterval{};
+    common::Option m_optionMotorTelemetryDecimation{};
 };
 }  // namespace sugo::test
\ No newline at end of file
@@ -32,13 +32,23 @@ using namespace sugo::test;
 
 using ::testing::ReturnRef;
 
-unsigned MachineConfiguration::MotorSpeedDefault    = 50;
-int32_t  MachineConfiguration::DefaultTemperature   = 25;
-int      MachineConfiguration::HeaterTemperatureMax = 205;
-int      MachineConfiguration::HeaterTemperatureMin = 180;
-unsigned MachineConfiguration::MotorSpeedIncrement  = 10u;
-unsigned MachineConfiguration::MotorSpeedMax        = 100u;
-unsigned MachineConfiguration::ObservationTimeout   = 1000u;
+unsigned    MachineConfiguration::MotorSpeedDefault            = 50;
+int32_t     MachineConfiguration::DefaultTemperature           = 25;
+int         MachineConfiguration::HeaterTemperatureMax         = 205;
+int         MachineConfiguration::HeaterTemperatureMin         = 180;
+unsigned    MachineConfiguration::MotorSpeedIncrement          = 10u;
+unsigned    MachineConfiguration::MotorSpeedMax                = 100u;
+unsigned    MachineConfiguration::ObservationTimeout           = 1000u;
+std::string MachineConfiguration::HeaterControl                = "hysteresis";
+unsigned    MachineConfiguration::HeaterControlWindow          = 5000u;
+float       MachineConfiguration::HeaterPidProportional        = 0.05f;
+float       MachineConfiguration::HeaterPidIntegral            = 0.0025f;
+float       MachineConfiguration::HeaterPidDerivative          = 0.2f;
+unsigned    MachineConfiguration::TensionControlInterval       = 50u;
+float       MachineConfiguration::TensionControlProportional   = 5.0f;
+float       MachineConfiguration::TensionControlIntegral       = 10.0f;
+unsigned    MachineConfiguration::MotorTelemetrySampleInterval = 10u;
+unsigned    MachineConfiguration::MotorTelemetryDecimation     = 5u;
 
 void MachineConfiguration::prepareOptions(IConfigurationMock& mock)
 {
@@ -48,13 +58,34 @@ void MachineConfiguration::prepareOptions(IConfigurationMock& mock)
     m_optionMotorSpeedIncrement           = {id::ConfigMotorSpeedIncrement,
                                    static_cast<unsigned>(MotorSpeedIncrement), ""};
     m_optionHeaterTemperatureMax          = {id::ConfigHeaterTemperatureMax,
-                                    static_cast<int>(HeaterTemperatureMax), ""};
+                                    static_cast<float>(HeaterTemperatureMax), ""};
     m_optionHeaterTemperatureMin          = {id::ConfigHeaterTemperatureMin,
-                                    static_cast<int>(HeaterTemperatureMin), ""};
+                                    static_cast<float>(HeaterTemperatureMin), ""};
+    // The integration tests expect the heater relay to be switched at the temperature limits.
+    m_optionHeaterControl                 = {id::ConfigHeaterControl, HeaterControl, ""};
+    m_optionHeaterControlWindow           = {id::ConfigHeaterControlWindow,
+                                   static_cast<unsigned>(HeaterControlWindow), ""};
+    m_optionHeaterPidProportional         = {id::ConfigHeaterPidProportional,
+                                     HeaterPidProportional, ""};
+    m_optionHeaterPidIntegral             = {id::ConfigHeaterPidIntegral, HeaterPidIntegral, ""};
+    m_optionHeaterPidDerivative           = {id::ConfigHeaterPidDerivative, HeaterPidDerivative,
+                                   ""};
+    m_optionHeaterPidAutoTune             = {id::ConfigHeaterPidAutoTune, false, ""};
     m_optionObservationTimeoutGpioPin     = {id::ConfigObservationTimeoutGpioPin,
                                          static_cast<unsigned>(ObservationTimeout), ""};
     m_optionObservationTimeoutTemperature = {id::ConfigObservationTimeoutTemperature,
                                              static_cast<unsigned>(ObservationTimeout), ""};
+    m_optionObservationTimeoutTension     = {id::ConfigObservationTimeoutTension,
+                                         static_cast<unsigned>(TensionControlInterval), ""};
+    m_optionTensionControlProportional    = {id::ConfigTensionControlProportional,
+                                          TensionControlProportional, ""};
+    m_optionTensionControlIntegral        = {id::ConfigTensionControlIntegral,
+                                      TensionControlIntegral, ""};
+    m_optionMotorTelemetrySampleInterval  = {id::ConfigMotorTelemetrySampleInterval,
+                                            static_cast<unsigned>(MotorTelemetrySampleInterval),
+                                            ""};
+    m_optionMotorTelemetryDecimation      = {id::ConfigMotorTelemetryDecimation,
+                                        static_cast<unsigned>(MotorTelemetryDecimation), ""};
 
     ON_CALL(mock, getOption(id::ConfigMotorSpeedDefault))
         .WillByDefault(ReturnRef(m_optionMotorSpeedDefault));
@@ -66,10 +97,30 @@ void MachineConfiguration::prepareOptions(IConfigurationMock& mock)
         .WillByDefault(ReturnRef(m_optionHeaterTemperatureMax));
     ON_CALL(mock, getOption(id::ConfigHeaterTemperatureMin))
         .WillByDefault(ReturnRef(m_optionHeaterTemperatureMin));
+    ON_CALL(mock, getOption(id::ConfigHeaterControl))
+        .WillByDefault(ReturnRef(m_optionHeaterControl));
+    ON_CALL(mock, getOption(id::ConfigHeaterControlWindow))
+        .WillByDefault(ReturnRef(m_optionHeaterControlWindow));
+    ON_CALL(mock, getOption(id::ConfigHeaterPidProportional))
+        .WillByDefault(ReturnRef(m_optionHeaterPidProportional));
+    ON_CALL(mock, getOption(id::ConfigHeaterPidIntegral))
+        .WillByDefault(ReturnRef(m_optionHeaterPidIntegral));
+    ON_CALL(mock, getOption(id::ConfigHeaterPidDerivative))
+        .WillByDefault(ReturnRef(m_optionHeaterPidDerivative));
+    ON_CALL(mock, getOption(id::ConfigHeaterPidAutoTune))
+        .WillByDefault(ReturnRef(m_optionHeaterPidAutoTune));
     ON_CALL(mock, getOption(id::ConfigObservationTimeoutGpioPin))
         .WillByDefault(ReturnRef(m_optionObservationTimeoutGpioPin));
     ON_CALL(mock, getOption(id::ConfigObservationTimeoutTemperature))
         .WillByDefault(ReturnRef(m_optionObservationTimeoutTemperature));
     ON_CALL(mock, getOption(id::ConfigObservationTimeoutTension))
-        .WillByDefault(ReturnRef(m_optionObservationTimeoutGpioPin));
+        .WillByDefault(ReturnRef(m_optionObservationTimeoutTension));
+    ON_CALL(mock, getOption(id::ConfigTensionControlProportional))
+        .WillByDefault(ReturnRef(m_optionTensionControlProportional));
+    ON_CALL(mock, getOption(id::ConfigTensionControlIntegral))
+        .WillByDefault(ReturnRef(m_optionTensionControlIntegral));
+    ON_CALL(mock, getOption(id::ConfigMotorTelemetrySampleInterval))
+        .WillByDefault(ReturnRef(m_optionMotorTelemetrySampleInterval));
+    ON_CALL(mock, getOption(id::ConfigMotorTelemetryDecimation))
+        .WillByDefault(ReturnRef(m_optionMotorTelemetryDecimation));
 }
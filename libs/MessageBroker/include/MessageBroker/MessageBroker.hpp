@@ -29,6 +29,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "Common/IOContext.hpp"
 #include "MessageBroker/Client.hpp"
@@ -56,6 +57,8 @@ public:
 
     /// @brief Maximum time to transmit a message (inclusive response).
     inline static constexpr std::chrono::milliseconds MaxMessageTransmissionTime{50};
+    /// @brief Maximum number of idle clients kept for concurrent requests.
+    static constexpr std::size_t MaxIdleClients = 8u;
 
     /**
      * @brief Construct a new command message broker object
@@ -160,6 +163,36 @@ private:
     using RequestMessageHandlerMap = std::map<Message::Identifier, RequestMessageHandler>;
     /// @brief Notification message handler map type.
     using NotificationMessageHandlerMap = std::map<Message::Identifier, NotificationMessageHandler>;
+    /// @brief Client list type.
+    using ClientList = std::vector<std::unique_ptr<Client>>;
+
+    /**
+     * @brief Takes an idle client or creates a new one, so that requests could be sent
+     * concurrently.
+     *
+     * @return Client to send a request with.
+     */
+    std::unique_ptr<Client> acquireClient();
+
+    /**
+     * @brief Returns a client after its request has been completed.
+     *
+     * @param client Client to be reused.
+     */
+    void releaseClient(std::unique_ptr<Client> client);
+
+    /**
+     * @brief Sends a request message with the passed client and waits for the response.
+     *
+     * @param client Client to be used.
+     * @param message Message to be sent.
+     * @param address Full qualified address of the receiver.
+     * @param[out] response Response message.
+     * @return true If the response has been received.
+     * @return false If the message could not be sent or no response has been received.
+     */
+    bool sendRequest(Client& client, Message& message, const Address& address,
+                     ResponseMessage& response);
 
     /**
      * @brief Increment and returns the next sequence number.
@@ -172,13 +205,13 @@ private:
     }
 
     Server                        m_server;      ///< Server instance
-    Client                        m_client;      ///< Client instance
     Publisher                     m_publisher;   ///< Publisher instance
     Subscriber                    m_subscriber;  ///< Subscriber instance
     common::IOContext&            m_ioContext;   ///< Io context of the client and server instances.
     RequestMessageHandlerMap      m_requestHandlers;       ///< Request message handler map.
     NotificationMessageHandlerMap m_notificationHandlers;  ///< Notification message handler map.
-    std::mutex           m_mutexClient;       ///< Mutex to restrict concurrent usage of the client.
+    std::mutex           m_mutexClients;      ///< Mutex to protect the idle clients.
+    ClientList           m_idleClients;       ///< Clients not used by any request.
     std::atomic_uint32_t m_sequenceNumber{};  ///< Sequence number of the next sent message.
 };
 
@@ -51,7 +51,6 @@ MessageBroker::MessageBroker(const Address& address, common::IOContext& ioContex
               return this->processReceivedRequestMessage(in, out);
           },
           ioContext),
-      m_client(ioContext),
       m_publisher(createFullQualifiedAddress(address, Service::Publisher), ioContext),
       m_subscriber(
           [this](StreamBuffer& in) { return this->processReceivedNotificationMessage(in); },
@@ -82,16 +81,51 @@ void MessageBroker::stop()
 bool MessageBroker::send(Message& message, const Address& address, ResponseMessage& response)
 {
     const Address fullAddress = createFullQualifiedAddress(address, Service::Responder);
-    const std::lock_guard<std::mutex> lock(m_mutexClient);
+    auto          client      = acquireClient();
+    const bool    success     = sendRequest(*client, message, fullAddress, response);
 
-    if (!m_client.connect(fullAddress, MaxMessageTransmissionTime, MaxMessageTransmissionTime))
+    // A client without response is not reused, since its socket still waits for the response.
+    if (success)
+    {
+        releaseClient(std::move(client));
+    }
+    return success;
+}
+
+std::unique_ptr<Client> MessageBroker::acquireClient()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_mutexClients);
+        if (!m_idleClients.empty())
+        {
+            auto client = std::move(m_idleClients.back());
+            m_idleClients.pop_back();
+            return client;
+        }
+    }
+    return std::make_unique<Client>(m_ioContext);
+}
+
+void MessageBroker::releaseClient(std::unique_ptr<Client> client)
+{
+    const std::lock_guard<std::mutex> lock(m_mutexClients);
+    if (m_idleClients.size() < MaxIdleClients)
+    {
+        m_idleClients.push_back(std::move(client));
+    }
+}
+
+bool MessageBroker::sendRequest(Client& client, Message& message, const Address& address,
+                                ResponseMessage& response)
+{
+    if (!client.connect(address, MaxMessageTransmissionTime, MaxMessageTransmissionTime))
     {
         LOG(error) << "Failed to connect to " << address;
         return false;
     }
 
     message.setSequence(getNextSequenceNumber());
-    LOG(debug) << "Sending request message " << message << " to " << fullAddress;
+    LOG(debug) << "Sending request message " << message << " to " << address;
 
     StreamBuffer outBuf;
     std::ostream outStream(&outBuf);
@@ -104,7 +138,7 @@ bool MessageBroker::send(Message& message, const Address& address, ResponseMessa
 
     StreamBuffer inBuf;
 
-    if (!m_client.send(outBuf, inBuf))
+    if (!client.send(outBuf, inBuf))
     {
         LOG(error) << "Failed to send message " << message << " to " << address;
         return false;
@@ -117,9 +151,9 @@ bool MessageBroker::send(Message& message, const Address& address, ResponseMessa
         return false;
     }
 
-    if (m_client.isConnected())
+    if (client.isConnected())
     {
-        if (!m_client.disconnect())
+        if (!client.disconnect())
         {
             LOG(error) << "Failed to disconnect";
             return false;
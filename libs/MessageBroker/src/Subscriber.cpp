@@ -121,14 +121,16 @@ bool Subscriber::unsubscribe(const Address& address, const Topic& topic)
         return false;
     }
 
-    assert(static_cast<size_t>(std::distance(m_socketInfoArray.begin(), iter->second)) <
+    // The iterator becomes invalid by erasing the subscription, so keep the socket.
+    const auto socketIter = iter->second;
+    assert(static_cast<size_t>(std::distance(m_socketInfoArray.begin(), socketIter)) <
            m_socketInfoArray.size());
-    auto& socketData = *(iter->second);
+    auto& socketData = *socketIter;
 
     socketData.socket.set_option(azmq::socket::unsubscribe(topic));
-    m_subscriptionMap.erase(serviceId);
+    m_subscriptionMap.erase(iter);
 
-    if (getSubscriptionCount(iter->second) == 0)
+    if (getSubscriptionCount(socketIter) == 0)
     {
         // No more subscriptions for that address
         boost::system::error_code ec;
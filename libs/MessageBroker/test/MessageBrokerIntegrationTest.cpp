@@ -26,9 +26,12 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <future>
 #include <istream>
 #include <ostream>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "Common/IOContext.hpp"
 #include "Common/Logger.hpp"
@@ -162,3 +165,66 @@ TEST_F(MessageBrokerIntegrationTest, NotifyAllHandlers)
     m_messageReceiveQueue.pop();
     EXPECT_EQ(m_messageReceiveQueue.front(), messageId);
 }
+
+TEST_F(MessageBrokerIntegrationTest, ConcurrentRequests)
+{
+    constexpr Message::Identifier messageId         = 0x23;
+    constexpr unsigned            NumberOfSenders   = MessageBroker::MaxIdleClients * 2;
+    constexpr unsigned            RequestsPerSender = 10;
+
+    m_broker1.registerRequestMessageHandler(messageId, [&](const Message& message) {
+        ResponseMessage response;
+        response.referTo(message);
+        response.setResult(ResponseMessage::Result::Success);
+        response.setPayload(message.getPayload());
+        return response;
+    });
+
+    // Responds too late, so the clients still wait for the response when their requests fail.
+    m_broker3.registerRequestMessageHandler(messageId, [](const Message& message) {
+        std::this_thread::sleep_for(MessageBroker::MaxMessageTransmissionTime * 2);
+        ResponseMessage response;
+        response.referTo(message);
+        response.setResult(ResponseMessage::Result::Success);
+        return response;
+    });
+
+    // Sends requests to the passed broker and returns the number of expected responses.
+    auto sendRequests = [&](unsigned sender, const std::string& address) {
+        common::Logger::reinit("Sender" + std::to_string(sender));
+        unsigned successCount = 0;
+        for (unsigned index = 0; index < RequestsPerSender; ++index)
+        {
+            const std::string payload = std::to_string(sender) + "." + std::to_string(index);
+            Message           message = createMessage(messageId, index, payload);
+            ResponseMessage   response;
+            if (m_broker2.send(message, address, response) &&
+                (response.getResult() == ResponseMessage::Result::Success) &&
+                (response.getPayload() == payload))
+            {
+                ++successCount;
+            }
+        }
+        return successCount;
+    };
+
+    // Requests to a broker which does not exist or responds too late fail, so their clients have
+    // to be discarded instead of being reused by the following requests.
+    std::array<std::future<unsigned>, 2> failingSenders = {
+        std::async(std::launch::async, sendRequests, 0, "UnknownBroker"),
+        std::async(std::launch::async, sendRequests, 1, m_brokerIds[2])};
+    for (auto& sender : failingSenders)
+    {
+        EXPECT_EQ(sender.get(), 0u);
+    }
+
+    std::vector<std::future<unsigned>> senders;
+    for (unsigned sender = 0; sender < NumberOfSenders; ++sender)
+    {
+        senders.push_back(std::async(std::launch::async, sendRequests, sender, m_brokerIds[0]));
+    }
+    for (auto& sender : senders)
+    {
+        EXPECT_EQ(sender.get(), RequestsPerSender);
+    }
+}
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace sugo::remote_control
+{
+/// @brief Cache of the static assets of the document root, which are served from memory.
+class AssetCache
+{
+public:
+    /// @brief Max size of a file to be cached, larger files are served from the disk.
+    static constexpr std::size_t MaxAssetSize = 4u * 1024u * 1024u;
+
+    /// @brief Representation of an asset with a content encoding.
+    struct Representation
+    {
+        std::string content;   ///< Content of the representation.
+        std::string etag;      ///< Entity tag of the representation.
+        std::string encoding;  ///< Content encoding, empty if not encoded.
+    };
+
+    /// @brief Static asset of the document root.
+    struct Asset
+    {
+        std::string                   contentType;   ///< MIME type of the content.
+        std::string                   cacheControl;  ///< Cache-Control header value.
+        std::string                   lastModified;  ///< Modification time as HTTP date.
+        Representation                identity;      ///< Uncompressed content.
+        std::optional<Representation> gzip;          ///< Pre-gzipped content, if available.
+        std::optional<Representation> brotli;        ///< Pre-compressed brotli, if available.
+    };
+
+    /**
+     * @brief Loads all files of the document root into memory. Pre-compressed variants are
+     * taken from files with the additional extension .gz and .br.
+     *
+     * @param docRoot Document root folder.
+     * @return true If the document root could be loaded.
+     * @return false If the document root could not be read.
+     */
+    bool load(const std::string &docRoot);
+
+    /**
+     * @brief Returns the asset of the requested URI.
+     *
+     * @param uri Requested URI, where '/' refers to the index.html.
+     * @return Cached asset or nullptr if the URI is not cached.
+     */
+    const Asset *find(std::string_view uri) const;
+
+    /**
+     * @brief Returns the number of cached assets.
+     *
+     * @return Number of assets.
+     */
+    std::size_t getCount() const
+    {
+        return m_assets.size();
+    }
+
+    /**
+     * @brief Selects the smallest representation accepted by the client.
+     *
+     * @param asset          Asset to be sent.
+     * @param acceptEncoding Value of the Accept-Encoding header.
+     * @return Representation to be sent.
+     */
+    static const Representation &selectRepresentation(const Asset &     asset,
+                                                      std::string_view acceptEncoding);
+
+    /**
+     * @brief Indicates if the client already has the current version of the asset.
+     *
+     * @param asset           Requested asset.
+     * @param ifNoneMatch     Value of the If-None-Match header.
+     * @param ifModifiedSince Value of the If-Modified-Since header.
+     * @return true If the asset has not been modified.
+     * @return false If the asset has to be sent.
+     */
+    static bool isNotModified(const Asset &asset, std::string_view ifNoneMatch,
+                              std::string_view ifModifiedSince);
+
+private:
+    std::map<std::string, Asset, std::less<>> m_assets;  ///< Assets by their URI.
+};
+}  // namespace sugo::remote_control
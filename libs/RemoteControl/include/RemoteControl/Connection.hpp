@@ -24,10 +24,16 @@
 
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <set>
 #include <string>
 
 #include "Common/Types.hpp"
+#include "RemoteControl/AssetCache.hpp"
 #include "RemoteControl/IClientRequestHandler.hpp"
+#include "RemoteControl/MessageEncoding.hpp"
 
 struct mg_connection;
 struct mg_http_message;
@@ -40,6 +46,33 @@ namespace sugo::remote_control
 class Connection
 {
 public:
+    using Clock         = std::chrono::steady_clock;
+    using SharedMessage = std::shared_ptr<const std::string>;
+
+    /// @brief Size of the send buffer, from which on notifications are held back.
+    static constexpr std::size_t MaxSendBufferSize = 32u * 1024u;
+    /// @brief Max number of held back notifications, except the state notification.
+    static constexpr std::size_t MaxPendingNotifications = 16u;
+    /// @brief Size of the send buffer, from which on the connection is closed.
+    static constexpr std::size_t MaxBufferedSize = 256u * 1024u;
+
+    /// @brief State subscription of the client.
+    struct Subscription
+    {
+        std::set<std::string>     fields;          ///< Selected fields, all if empty.
+        std::chrono::milliseconds minInterval{0};  ///< Min interval between two state messages.
+    };
+
+    /// @brief Statistics of the messages sent to the client.
+    struct Statistics
+    {
+        std::size_t               messages  = 0;      ///< Number of sent messages.
+        std::size_t               bytes     = 0;      ///< Number of sent bytes.
+        std::size_t               dropped   = 0;      ///< Number of dropped notifications.
+        std::size_t               coalesced = 0;      ///< Number of replaced state notifications.
+        std::chrono::microseconds processingTime{0};  ///< Time to prepare and send messages.
+    };
+
     /// @brief Default constructor
     Connection() = default;
 
@@ -72,19 +105,92 @@ public:
     IClientRequestHandler::ClientId getClientId() const;
 
     /**
-     * @brief Sends a response message to the client.
+     * @brief Returns the message encoding negotiated with the client.
      *
-     * @param response Response message JSON formatted.
+     * @return Message encoding.
+     */
+    MessageEncoding getEncoding() const
+    {
+        return m_encoding;
+    }
+
+    /**
+     * @brief Sends a response message to the client with the negotiated encoding.
+     *
+     * @param response Response message.
      */
     void sendMessage(const common::Json &response);
 
     /**
-     * @brief Handles a HTTP request message.
+     * @brief Sends an already encoded message to the client.
+     *
+     * @param message Message with the negotiated encoding.
+     */
+    void sendMessage(const std::string &message);
+
+    /**
+     * @brief Sends a notification to the client. A subscribed client receives the changes of
+     * the selected state fields only. Other notifications are sent, if one of their fields is
+     * selected. Notifications are held back, while the client is congested.
+     *
+     * @param notification Notification to be sent.
+     * @param message      Notification already encoded with the negotiated encoding.
+     */
+    void sendNotification(const common::Json &notification, const SharedMessage &message);
+
+    /**
+     * @brief Sends the held back notifications and state changes, after data has been written.
+     *
+     * @param now Current time.
+     */
+    void handleWrite(Clock::time_point now);
+
+    /**
+     * @brief Sends all pending state changes, if the subscription interval has elapsed.
+     *
+     * @param now Current time.
+     */
+    void sendStateChanges(Clock::time_point now);
+
+    /**
+     * @brief Returns the time when the pending state changes have to be sent.
+     *
+     * @return Time of the next state message or Clock::time_point::max() if nothing is pending
+     * or the client is congested.
+     */
+    Clock::time_point getNextStateTime() const;
+
+    /**
+     * @brief Indicates if the client has subscribed to the state.
+     *
+     * @return true If the client has subscribed.
+     * @return false If the client receives all notifications completely.
+     */
+    bool isSubscribed() const
+    {
+        return m_isSubscribed;
+    }
+
+    /**
+     * @brief Returns the statistics of the messages sent to the client.
+     *
+     * @return Message statistics.
+     */
+    const Statistics &getStatistics() const
+    {
+        return m_statistics;
+    }
+
+    /**
+     * @brief Handles a HTTP request message. Cached assets are served from memory, all other
+     * files from the document root.
      *
      * @param message Message to handle.
+     * @param assets  Cached assets of the document root.
      * @param docRoot Document root of the message.
      */
-    void handleHttpMessage(mg_http_message *message, std::string &docRoot);
+    void handleHttpMessage(mg_http_message *message, const AssetCache &assets,
+                           std::string &docRoot);
 
     /**
      * @brief Handles a error message.
@@ -111,10 +217,12 @@ public:
     /**
      * @brief Handles a websocket message.
      *
-     * @param message Websocket message to handle.
-     * @param handler Client request handle to be informed.
+     * @param message  Websocket message to handle.
+     * @param encoding Encoding of the message.
+     * @param handler  Client request handle to be informed.
      */
-    void handleWebsocketMessage(const mg_str &message, IClientRequestHandler &handler);
+    void handleWebsocketMessage(const mg_str &message, MessageEncoding encoding,
+                                IClientRequestHandler &handler);
 
     /**
      * @brief Handles a websocket control message.
@@ -135,7 +243,66 @@ public:
     }
 
 private:
-    mg_connection *m_connection      = nullptr;  ///< Mongoose connection object.
-    bool           m_isOpenWebsocket = false;    ///< Indicates if websocket is open.
+    /// @brief Held back notification.
+    struct PendingNotification
+    {
+        SharedMessage message;          ///< Encoded notification.
+        bool          isState = false;  ///< Indicates if it is a state notification.
+    };
+
+    using MessageQueue = std::deque<PendingNotification>;
+
+    /**
+     * @brief Sends a notification or holds it back, if the client is congested. A held back
+     * state notification is replaced by the latest one at its position, other notifications are
+     * held back up to MaxPendingNotifications.
+     *
+     * @param message Encoded notification.
+     * @param isState Indicates if it is a state notification.
+     */
+    void queueNotification(const SharedMessage &message, bool isState);
+
+    /**
+     * @brief Sends the held back notifications, as long as the client is not congested.
+     */
+    void sendPendingNotifications();
+
+    /**
+     * @brief Indicates if the send buffer of the client has reached MaxSendBufferSize.
+     *
+     * @return true If notifications have to be held back.
+     * @return false If notifications can be sent.
+     */
+    bool isCongested() const;
+
+    /**
+     * @brief Serves a GET or HEAD request from the asset cache.
+     *
+     * @param message HTTP request.
+     * @param assets  Cached assets.
+     * @return true If the request has been served.
+     * @return false If the requested asset is not cached.
+     */
+    bool serveAsset(mg_http_message *message, const AssetCache &assets);
+
+    /**
+     * @brief Handles a subscription request.
+     *
+     * @param request Subscription request.
+     * @param[out] response Response to be sent.
+     */
+    void handleSubscription(const common::Json &request, common::Json &response);
+
+    mg_connection    *m_connection      = nullptr;        ///< Mongoose connection object.
+    bool              m_isOpenWebsocket = false;          ///< Indicates if websocket is open.
+    bool              m_isSubscribed    = false;          ///< Indicates if the state is subscribed.
+    MessageEncoding   m_encoding{MessageEncoding::Json};  ///< Negotiated message encoding.
+    Subscription      m_subscription;                     ///< State subscription.
+    common::Json      m_sentState;                        ///< State fields known by the client.
+    common::Json      m_pendingChanges;                   ///< State changes not yet sent.
+    common::Json      m_stateVersion;                     ///< Version of the latest state.
+    Clock::time_point m_lastStateTime;                    ///< Time of the last state message.
+    Statistics        m_statistics;                       ///< Message statistics.
+    MessageQueue      m_pendingNotifications;             ///< Held back notifications in order.
 };
-}  // namespace sugo::remote_control
\ No newline at end of file
+}  // namespace sugo::remote_control
@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "RemoteControl/Connection.hpp"
+
+namespace sugo::remote_control
+{
+/**
+ * @brief Flat table of the client connections. The slot of a connection is looked up by the id of
+ * the mongoose connection, so no field of the mongoose connection is used by the table. Slots of
+ * closed connections are reused.
+ */
+class ConnectionTable
+{
+public:
+    /**
+     * @brief Adds a new connection.
+     *
+     * @param connection Mongoose connection.
+     * @return Added connection.
+     */
+    Connection &add(mg_connection *connection);
+
+    /**
+     * @brief Returns the connection of a mongoose connection.
+     *
+     * @param connection Mongoose connection.
+     * @return Connection or nullptr if it is not part of the table.
+     */
+    Connection *find(const mg_connection *connection);
+
+    /**
+     * @brief Removes a connection.
+     *
+     * @param connection Mongoose connection.
+     * @return true If the connection has been removed.
+     * @return false If the connection is not part of the table.
+     */
+    bool remove(const mg_connection *connection);
+
+    /**
+     * @brief Removes all connections.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of connections.
+     *
+     * @return Number of connections.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Calls the function for each connection.
+     *
+     * @param function Function to be called with the connection.
+     */
+    template <class FunctionT>
+    void forEach(FunctionT function)
+    {
+        for (auto &slot : m_slots)
+        {
+            if (slot.isUsed)
+            {
+                function(slot.connection);
+            }
+        }
+    }
+
+    /**
+     * @brief Calls the function for each connection.
+     *
+     * @param function Function to be called with the connection.
+     */
+    template <class FunctionT>
+    void forEach(FunctionT function) const
+    {
+        for (const auto &slot : m_slots)
+        {
+            if (slot.isUsed)
+            {
+                function(slot.connection);
+            }
+        }
+    }
+
+private:
+    /// @brief Slot of a connection.
+    struct Slot
+    {
+        Connection connection;      ///< Connection of the slot.
+        bool       isUsed = false;  ///< Indicates if the slot holds a connection.
+    };
+
+    std::vector<Slot>                           m_slots;        ///< Slots of the connections.
+    std::vector<uint32_t>                       m_freeSlots;    ///< Indices of the unused slots.
+    std::unordered_map<unsigned long, uint32_t> m_slotIndices;  ///< Slots by connection id.
+    std::size_t                                 m_size = 0;     ///< Number of connections.
+};
+}  // namespace sugo::remote_control
@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string_view>
+
+namespace sugo::remote_control
+{
+/**
+ * @brief Removes the leading and trailing whitespaces of a header value.
+ *
+ * @param value Header value.
+ * @return Trimmed header value.
+ */
+inline std::string_view trim(std::string_view value)
+{
+    const auto first = value.find_first_not_of(" \t");
+    if (first == std::string_view::npos)
+    {
+        return {};
+    }
+    const auto last = value.find_last_not_of(" \t");
+    return value.substr(first, last - first + 1);
+}
+
+/**
+ * @brief Calls the function for each trimmed element of a comma separated header value.
+ *
+ * @tparam FunctionT Function type, which is called with the element as std::string_view.
+ * @param value      Header value.
+ * @param function   Function to be called.
+ */
+template <class FunctionT>
+void forEachElement(std::string_view value, FunctionT function)
+{
+    while (!value.empty())
+    {
+        const auto separator = value.find(',');
+        function(trim(value.substr(0, separator)));
+        value.remove_prefix((separator == std::string_view::npos) ? value.size()
+                                                                  : (separator + 1));
+    }
+}
+}  // namespace sugo::remote_control
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "Common/Types.hpp"
+
+namespace sugo::remote_control
+{
+/// @brief Encoding of the websocket messages, which is negotiated as websocket sub-protocol.
+enum class MessageEncoding
+{
+    Json,        ///< JSON text frames.
+    Cbor,        ///< CBOR binary frames.
+    MessagePack  ///< MessagePack binary frames.
+};
+
+/// @brief Number of available message encodings.
+inline constexpr std::size_t MessageEncodingCount = 3u;
+
+/**
+ * @brief Returns the websocket sub-protocol name of the encoding.
+ *
+ * @param encoding Message encoding.
+ * @return Sub-protocol name.
+ */
+const std::string &getSubprotocol(MessageEncoding encoding);
+
+/**
+ * @brief Selects the encoding of the first supported sub-protocol in the comma separated list
+ * of the client.
+ *
+ * @param subprotocols Value of the Sec-WebSocket-Protocol header.
+ * @param[out] encoding Selected message encoding.
+ * @return true If a supported sub-protocol has been found.
+ * @return false If none of the sub-protocols is supported.
+ */
+bool selectMessageEncoding(std::string_view subprotocols, MessageEncoding &encoding);
+
+/**
+ * @brief Indicates if the encoding is transmitted with binary frames.
+ *
+ * @param encoding Message encoding.
+ * @return true If binary frames are used.
+ * @return false If text frames are used.
+ */
+inline bool isBinary(MessageEncoding encoding)
+{
+    return encoding != MessageEncoding::Json;
+}
+
+/**
+ * @brief Encodes a message.
+ *
+ * @param message  Message to be encoded.
+ * @param encoding Message encoding.
+ * @return Encoded message.
+ */
+std::string encodeMessage(const common::Json &message, MessageEncoding encoding);
+
+/**
+ * @brief Decodes a message directly from the received data without copying it.
+ *
+ * @param data     Received data.
+ * @param size     Size of the received data.
+ * @param encoding Message encoding.
+ * @param[out] message Decoded message.
+ * @return true If the message could be decoded.
+ * @return false If the data is invalid.
+ */
+bool decodeMessage(const char *data, std::size_t size, MessageEncoding encoding,
+                   common::Json &message);
+}  // namespace sugo::remote_control
@@ -33,16 +33,29 @@ inline static const std::string Speed{"speed"};
 inline static const std::string State{"state"};
 inline static const std::string Type{"type"};
 inline static const std::string Command{"command"};
+inline static const std::string Motor{"motor"};
+inline static const std::string Telemetry{"telemetry"};
+inline static const std::string Version{"version"};
+inline static const std::string Fields{"fields"};
+inline static const std::string MaxRate{"max-rate"};
 inline static const std::string TypeResponseRequest{"response-request"};
 inline static const std::string TypeResponseCommand{"response-command"};
 inline static const std::string TypeRequestCommand{"request-command"};
 inline static const std::string TypeRequestState{"request-state"};
 inline static const std::string TypeResponseState{"response-state"};
+inline static const std::string TypeRequestSubscribe{"request-subscribe"};
+inline static const std::string TypeResponseSubscribe{"response-subscribe"};
 inline static const std::string TypeNotificationState{"notification-state"};
+inline static const std::string TypeNotificationTelemetry{"notification-telemetry"};
 inline static const std::string ErrorReason{"reason"};
 inline static const std::string ResultError{"error"};
 inline static const std::string ResultSuccess{"success"};
 inline static const std::string ErrorCommandUnsupported{"error-command-unsupported"};
 inline static const std::string ErrorRequestUnsupported{"error-request-unsupported"};
 inline static const std::string ErrorTypeInvalid{"error-type-invalid"};
+inline static const std::string ErrorVersionInvalid{"error-version-invalid"};
+inline static const std::string ErrorSubscriptionInvalid{"error-subscription-invalid"};
+inline static const std::string SubprotocolJson{"json"};
+inline static const std::string SubprotocolCbor{"cbor"};
+inline static const std::string SubprotocolMessagePack{"msgpack"};
 }  // namespace sugo::remote_control::id
\ No newline at end of file
@@ -24,18 +24,23 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cassert>
-#include <map>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
 
 #include "Common/IConfiguration.hpp"
 #include "Common/IRunnable.hpp"
+#include "Common/LockFreeQueue.hpp"
 #include "Common/Thread.hpp"
 #include "Common/Types.hpp"
 #include "IClientRequestHandler.hpp"
+#include "RemoteControl/AssetCache.hpp"
 #include "RemoteControl/Connection.hpp"
+#include "RemoteControl/ConnectionTable.hpp"
 
 struct mg_mgr;
 
@@ -47,6 +52,21 @@ class RemoteControlServer : public common::IRunnable
 public:
     /// @brief Maximum connection allowed to connect.
     static const unsigned MaxConnections = 3u;
+    /// @brief Maximum number of notifications waiting to be broadcast.
+    static constexpr std::size_t MaxPendingBroadcasts = 64u;
+
+    /// @brief Broadcast statistics.
+    struct BroadcastStatistics
+    {
+        std::size_t               broadcasts = 0;     ///< Number of broadcast notifications.
+        std::size_t               messages   = 0;     ///< Number of notifications to clients.
+        std::size_t               dropped    = 0;     ///< Number of dropped notifications.
+        std::size_t               maxClients = 0;     ///< Max clients of one broadcast.
+        std::size_t               bytes      = 0;     ///< Number of bytes sent to the clients.
+        std::chrono::microseconds latency{0};         ///< Total time from queuing until sent.
+        std::chrono::microseconds maxLatency{0};      ///< Max time from queuing until sent.
+        std::chrono::microseconds processingTime{0};  ///< Time to prepare client messages.
+    };
 
     /**
      * @brief Construct a new remove control server.
@@ -75,6 +95,17 @@ public:
         return m_thread.isRunning();
     }
 
+    /**
+     * @brief Returns the statistics of all broadcast notifications.
+     *
+     * @return Broadcast statistics.
+     */
+    BroadcastStatistics getBroadcastStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutexStatistics);
+        return m_broadcastStatistics;
+    }
+
     /**
      * @brief Waits until IO context thread has finished.
      */
@@ -87,6 +118,22 @@ public:
     }
 
 private:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Encoded messages of a notification, one per encoding.
+    using EncodedMessages = std::array<std::shared_ptr<const std::string>, MessageEncodingCount>;
+
+    /// @brief Notification waiting to be broadcast, which is encoded once for all clients.
+    struct Broadcast
+    {
+        std::shared_ptr<const common::Json> notification;  ///< Notification to be sent.
+        EncodedMessages                     messages;      ///< Encoded notification, if used.
+        Clock::time_point                   queueTime;     ///< Time when it has been queued.
+    };
+
+    /// @brief Queue of notifications waiting to be broadcast.
+    using BroadcastQueue = common::LockFreeQueue<Broadcast, MaxPendingBroadcasts>;
+
     /**
      * @brief Start listening.
      *
@@ -105,34 +152,84 @@ private:
     void handleEvent(mg_connection *connection, int event, void *eventData);
 
     /**
-     * @brief Returns a connection object according to the client id.
+     * @brief Handles an event of the wakeup pipe.
+     *
+     * @param connection Pipe connection regarding to the event.
+     * @param event Event received.
+     */
+    void handleWakeupEvent(mg_connection *connection, int event);
+
+    /**
+     * @brief Sends all queued notifications to the clients. Has to be called from the listener
+     * thread only.
+     */
+    void broadcastNotifications();
+
+    /**
+     * @brief Returns the notification message with the requested encoding. The message is
+     * encoded once at first use.
+     *
+     * @param broadcast Notification to be sent.
+     * @param encoding  Message encoding of the client.
+     * @return Encoded message.
+     */
+    static const Connection::SharedMessage &getMessage(Broadcast      &broadcast,
+                                                       MessageEncoding encoding);
+
+    /**
+     * @brief Sends the pending state changes of all subscribed clients, which are due.
+     */
+    void sendStateChanges();
+
+    /**
+     * @brief Returns the time until the next state changes are due.
+     *
+     * @return Poll timeout in milliseconds.
+     */
+    int getPollTimeout() const;
+
+    /**
+     * @brief Wakes up the listener thread.
+     */
+    void wakeup();
+
+    /**
+     * @brief Returns the connection object of a mongoose connection. Has to be called from the
+     * listener thread only.
      *
-     * @param id Client identifier for which the connection object should be returned.
+     * @param connection Mongoose connection for which the connection object should be returned.
      * @return Connection reference.
      */
-    Connection &getConnection(IClientRequestHandler::ClientId id)
+    Connection &getConnection(const mg_connection *connection)
     {
-        std::lock_guard<std::mutex> lock(m_mutexStartStop);
-        auto                        connection = m_connections.find(id);
-        assert(connection != m_connections.end());
-        return connection->second;
+        auto *found = m_connections.find(connection);
+        assert(found != nullptr);
+        return *found;
     }
 
     /**
-     * @brief Sends a notification to the client.
+     * @brief Queues a notification to be sent to all clients by the listener thread. Could be
+     * called from any thread.
      *
      * @param notification Notification to be sent.
      */
     void sendNotification(const common::Json &notification);
 
-    std::string             m_address;                  ///< Servers address.
-    unsigned short          m_port;                     ///< Servers port number.
-    std::string             m_docRoot;                  ///< Document root.
-    IClientRequestHandler & m_requestHandler;           ///< Client request handler.
-    std::mutex              m_mutexStartStop;           ///< Mutex for start and stop.
-    std::unique_ptr<mg_mgr> m_serverStatus;             ///< Current server status.
-    common::Thread          m_thread;                   ///< Listener thread.
-    bool                    m_doListen = false;         ///< Indicates if listening should be done.
-    std::map<unsigned long, Connection> m_connections;  ///< List of connections to clients.
+    std::string             m_address;              ///< Servers address.
+    unsigned short          m_port;                 ///< Servers port number.
+    std::string             m_docRoot;              ///< Document root.
+    AssetCache              m_assets;               ///< Cached assets of the document root.
+    IClientRequestHandler & m_requestHandler;       ///< Client request handler.
+    std::mutex              m_mutexStartStop;       ///< Mutex for start and stop.
+    std::unique_ptr<mg_mgr> m_serverStatus;         ///< Current server status.
+    common::Thread          m_thread;               ///< Listener thread.
+    std::atomic_bool        m_doListen{false};      ///< Indicates if listening should be done.
+    ConnectionTable         m_connections;          ///< Connections of the listener thread.
+    BroadcastQueue          m_broadcasts;           ///< Notifications to be broadcast.
+    Broadcast               m_lastState;            ///< Last broadcast state notification.
+    std::atomic_int         m_wakeupSocket{-1};     ///< Socket to wake up the listener.
+    std::atomic_uint        m_wakeupSenders{0};     ///< Number of threads using the wakeup socket.
+    mutable std::mutex      m_mutexStatistics;      ///< Mutex for the broadcast statistics.
+    BroadcastStatistics     m_broadcastStatistics;  ///< Broadcast statistics.
 };
 }  // namespace sugo::remote_control
\ No newline at end of file
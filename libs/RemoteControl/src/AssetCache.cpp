@@ -0,0 +1,261 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <sys/stat.h>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "Common/Logger.hpp"
+#include "RemoteControl/AssetCache.hpp"
+#include "RemoteControl/HeaderValue.hpp"
+
+using namespace sugo::remote_control;
+
+namespace
+{
+constexpr char GzipExtension[]   = ".gz";
+constexpr char BrotliExtension[] = ".br";
+
+bool readFile(const std::filesystem::path &path, std::string &content)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    content = stream.str();
+    return !file.bad();
+}
+
+/// Strong entity tag from a FNV-1a hash of the content.
+std::string createETag(const std::string &content, std::string_view suffix)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (const char byte : content)
+    {
+        hash = (hash ^ static_cast<uint8_t>(byte)) * 1099511628211ull;
+    }
+    std::ostringstream etag;
+    etag << '"' << std::hex << std::setw(16) << std::setfill('0') << hash << suffix << '"';
+    return etag.str();
+}
+
+std::string getLastModified(const std::filesystem::path &path)
+{
+    struct stat status
+    {
+    };
+    struct tm time
+    {
+    };
+    if ((::stat(path.c_str(), &status) != 0) || (::gmtime_r(&status.st_mtime, &time) == nullptr))
+    {
+        return {};
+    }
+    std::array<char, 32> buffer{};
+    return std::string(buffer.data(),
+                       std::strftime(buffer.data(), buffer.size(), "%a, %d %b %Y %H:%M:%S GMT",
+                                     &time));
+}
+
+std::string getContentType(const std::filesystem::path &path)
+{
+    static const std::map<std::string, std::string, std::less<>> contentTypes{
+        {".html", "text/html; charset=utf-8"},
+        {".htm", "text/html; charset=utf-8"},
+        {".css", "text/css; charset=utf-8"},
+        {".js", "text/javascript; charset=utf-8"},
+        {".mjs", "text/javascript; charset=utf-8"},
+        {".json", "application/json"},
+        {".map", "application/json"},
+        {".txt", "text/plain; charset=utf-8"},
+        {".svg", "image/svg+xml"},
+        {".png", "image/png"},
+        {".jpg", "image/jpeg"},
+        {".jpeg", "image/jpeg"},
+        {".gif", "image/gif"},
+        {".ico", "image/x-icon"},
+        {".woff", "font/woff"},
+        {".woff2", "font/woff2"}};
+    const auto contentType = contentTypes.find(path.extension().string());
+    return (contentType != contentTypes.end()) ? contentType->second : "application/octet-stream";
+}
+
+std::optional<AssetCache::Representation> loadVariant(const std::filesystem::path &path,
+                                                      const char *extension, const char *encoding)
+{
+    std::filesystem::path variantPath = path;
+    variantPath += extension;
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(variantPath, error))
+    {
+        return std::nullopt;
+    }
+
+    // A variant not updated together with the original file would serve outdated content.
+    const auto modified        = std::filesystem::last_write_time(path, error);
+    const auto variantModified = std::filesystem::last_write_time(variantPath, error);
+    if (error || (variantModified < modified))
+    {
+        LOG(warning) << "Ignoring outdated " << variantPath;
+        return std::nullopt;
+    }
+
+    AssetCache::Representation variant;
+    if (!readFile(variantPath, variant.content))
+    {
+        LOG(warning) << "Failed to read " << variantPath;
+        return std::nullopt;
+    }
+    // Each representation needs its own strong entity tag.
+    variant.etag     = createETag(variant.content, std::string("-") + encoding);
+    variant.encoding = encoding;
+    return variant;
+}
+}  // namespace
+
+bool AssetCache::load(const std::string &docRoot)
+{
+    m_assets.clear();
+
+    std::error_code error;
+    auto            entry = std::filesystem::recursive_directory_iterator(docRoot, error);
+    if (error)
+    {
+        LOG(warning) << "Failed to read document root " << docRoot << ": " << error.message();
+        return false;
+    }
+
+    std::size_t totalSize = 0;
+    for (; entry != std::filesystem::recursive_directory_iterator(); entry.increment(error))
+    {
+        const auto &path      = entry->path();
+        const auto  extension = path.extension();
+        if (!entry->is_regular_file(error) ||
+            // Pre-compressed variants are loaded together with the original file.
+            (((extension == GzipExtension) || (extension == BrotliExtension)) &&
+             std::filesystem::is_regular_file(path.parent_path() / path.stem(), error)))
+        {
+            continue;
+        }
+        if (entry->file_size(error) > MaxAssetSize)
+        {
+            LOG(debug) << "Not caching large file " << path;
+            continue;
+        }
+
+        Asset asset;
+        if (!readFile(path, asset.identity.content))
+        {
+            LOG(warning) << "Failed to read " << path;
+            continue;
+        }
+        asset.identity.etag = createETag(asset.identity.content, "");
+        asset.contentType   = getContentType(path);
+        asset.lastModified  = getLastModified(path);
+        // Pages are revalidated to get UI updates at once, other assets are reused for a while.
+        asset.cacheControl =
+            (extension == ".html") ? "no-cache" : "public, max-age=3600, must-revalidate";
+        asset.gzip   = loadVariant(path, GzipExtension, "gzip");
+        asset.brotli = loadVariant(path, BrotliExtension, "br");
+
+        totalSize += asset.identity.content.size() + (asset.gzip ? asset.gzip->content.size() : 0) +
+                     (asset.brotli ? asset.brotli->content.size() : 0);
+        m_assets.emplace("/" + std::filesystem::relative(path, docRoot).generic_string(),
+                         std::move(asset));
+    }
+
+    LOG(info) << "Cached " << m_assets.size() << " static assets with " << totalSize
+              << " bytes from " << docRoot;
+    return true;
+}
+
+const AssetCache::Asset *AssetCache::find(std::string_view uri) const
+{
+    const auto asset = m_assets.find((uri == "/") ? std::string_view("/index.html") : uri);
+    return (asset != m_assets.end()) ? &asset->second : nullptr;
+}
+
+const AssetCache::Representation &AssetCache::selectRepresentation(
+    const Asset &asset, std::string_view acceptEncoding)
+{
+    bool acceptsGzip   = false;
+    bool acceptsBrotli = false;
+    forEachElement(acceptEncoding, [&](std::string_view element) {
+        const auto parameter = element.find(';');
+        const auto coding    = trim(element.substr(0, parameter));
+        if (parameter != std::string_view::npos)
+        {
+            // Codings with a quality value of zero are not acceptable.
+            const auto quality = trim(element.substr(parameter + 1));
+            if ((quality.substr(0, 2) == "q=") &&
+                (std::strtod(std::string(quality.substr(2)).c_str(), nullptr) <= 0.0))
+            {
+                return;
+            }
+        }
+        acceptsGzip   = acceptsGzip || (coding == "gzip");
+        acceptsBrotli = acceptsBrotli || (coding == "br");
+    });
+
+    if (acceptsBrotli && asset.brotli)
+    {
+        return *asset.brotli;
+    }
+    if (acceptsGzip && asset.gzip)
+    {
+        return *asset.gzip;
+    }
+    return asset.identity;
+}
+
+bool AssetCache::isNotModified(const Asset &asset, std::string_view ifNoneMatch,
+                               std::string_view ifModifiedSince)
+{
+    // If-None-Match takes precedence over If-Modified-Since.
+    if (!ifNoneMatch.empty())
+    {
+        bool isMatching = false;
+        forEachElement(ifNoneMatch, [&](std::string_view etag) {
+            if (etag.substr(0, 2) == "W/")
+            {
+                etag.remove_prefix(2);
+            }
+            isMatching = isMatching || (etag == "*") || (etag == asset.identity.etag) ||
+                         (asset.gzip && (etag == asset.gzip->etag)) ||
+                         (asset.brotli && (etag == asset.brotli->etag));
+        });
+        return isMatching;
+    }
+    // Clients send the date back as they received it.
+    return !ifModifiedSince.empty() && (ifModifiedSince == asset.lastModified);
+}
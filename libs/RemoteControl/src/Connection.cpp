@@ -23,11 +23,13 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <mongoose.h>
+#include <algorithm>
 #include <cassert>
 #include <iomanip>
 
 #include "Common/Logger.hpp"
 #include "RemoteControl/Connection.hpp"
+#include "RemoteControl/Protocol.hpp"
 
 namespace
 {
@@ -37,6 +39,12 @@ std::string toString(const mg_str &str)
 }
 
 const uint8_t WebsocketOpMask = 0x0f;
+
+std::string_view getHeader(mg_http_message *message, const char *name)
+{
+    const mg_str *value = mg_http_get_header(message, name);
+    return (value != nullptr) ? std::string_view(value->ptr, value->len) : std::string_view();
+}
 }  // namespace
 
 using namespace sugo::remote_control;
@@ -46,7 +54,8 @@ IClientRequestHandler::ClientId Connection::getClientId() const
     return m_connection->id;
 }
 
-void Connection::handleHttpMessage(mg_http_message *message, std::string &docRoot)
+void Connection::handleHttpMessage(mg_http_message *message, const AssetCache &assets,
+                                   std::string &docRoot)
 {
     assert(m_connection != nullptr);
     if (mg_http_match_uri(message, "/websocket"))
@@ -55,7 +64,19 @@ void Connection::handleHttpMessage(mg_http_message *message, std::string &docRoo
 
         // Upgrade to websocket. From now on, a m_connection is a full-duplex
         // Websocket m_connection, which will receive MG_EV_WS_MSG events.
-        mg_ws_upgrade(m_connection, message, nullptr);  // NOLINT(cppcoreguidelines-pro-type-vararg)
+        // A binary encoding is used, if the client offers it as sub-protocol.
+        const auto subprotocols = getHeader(message, "Sec-WebSocket-Protocol");
+        if (!subprotocols.empty() && selectMessageEncoding(subprotocols, m_encoding))
+        {
+            LOG(debug) << getClientId() << ": Using sub-protocol " << getSubprotocol(m_encoding);
+            mg_ws_upgrade(m_connection, message,  // NOLINT(cppcoreguidelines-pro-type-vararg)
+                          "Sec-WebSocket-Protocol: %s\r\n", getSubprotocol(m_encoding).c_str());
+        }
+        else
+        {
+            mg_ws_upgrade(m_connection, message,  // NOLINT(cppcoreguidelines-pro-type-vararg)
+                          nullptr);
+        }
     }
     else if (mg_http_match_uri(message, "/state"))
     {
@@ -64,9 +85,9 @@ void Connection::handleHttpMessage(mg_http_message *message, std::string &docRoo
             LOG(debug) << getClientId() << "Event request received";
         }
     }
-    else
+    else if (!serveAsset(message, assets))
     {
-        // Handle normal HTTP requests
+        // Handle normal HTTP requests of files not cached
         struct mg_http_serve_opts opts
         {
             docRoot.c_str(), nullptr, nullptr, nullptr, nullptr, nullptr
@@ -75,11 +96,54 @@ void Connection::handleHttpMessage(mg_http_message *message, std::string &docRoo
     }
 }
 
+bool Connection::serveAsset(mg_http_message *message, const AssetCache &assets)
+{
+    const bool isHead = mg_match(message->method, mg_str("HEAD"), nullptr);
+    if (!isHead && !mg_match(message->method, mg_str("GET"), nullptr))
+    {
+        return false;
+    }
+    const auto *asset = assets.find(std::string_view(message->uri.ptr, message->uri.len));
+    if (asset == nullptr)
+    {
+        return false;
+    }
+
+    const auto &representation =
+        AssetCache::selectRepresentation(*asset, getHeader(message, "Accept-Encoding"));
+    const bool isNotModified = AssetCache::isNotModified(
+        *asset, getHeader(message, "If-None-Match"), getHeader(message, "If-Modified-Since"));
+
+    std::string header = isNotModified ? "HTTP/1.1 304 Not Modified\r\n" : "HTTP/1.1 200 OK\r\n";
+    header += "ETag: " + representation.etag + "\r\n";
+    header += "Last-Modified: " + asset->lastModified + "\r\n";
+    header += "Cache-Control: " + asset->cacheControl + "\r\n";
+    header += "Vary: Accept-Encoding\r\n";
+    if (!isNotModified)
+    {
+        header += "Content-Type: " + asset->contentType + "\r\n";
+        header += "Content-Length: " + std::to_string(representation.content.size()) + "\r\n";
+        if (!representation.encoding.empty())
+        {
+            header += "Content-Encoding: " + representation.encoding + "\r\n";
+        }
+    }
+    header += "\r\n";
+
+    LOG(debug) << getClientId() << ": Serving cached " << toString(message->uri) << " ("
+               << (isNotModified ? "not modified" : representation.encoding) << ")";
+    mg_send(m_connection, header.data(), header.size());
+    if (!isNotModified && !isHead)
+    {
+        mg_send(m_connection, representation.content.data(), representation.content.size());
+    }
+    return true;
+}
+
 void Connection::handleError(const char *errorMessage)
 {
     assert(m_connection != nullptr);
     assert(errorMessage != nullptr);
-    const std::string label(m_connection->label);
     const std::string error(errorMessage);
     LOG(error) << getClientId() << ": " << error;
 }
@@ -106,7 +170,17 @@ void Connection::handleWebsocketMessage(mg_ws_message *message, IClientRequestHa
         // WEBSOCKET_OP_PING 9
         // WEBSOCKET_OP_PONG 10
         case WEBSOCKET_OP_TEXT:
-            handleWebsocketMessage(message->data, handler);
+            handleWebsocketMessage(message->data, MessageEncoding::Json, handler);
+            break;
+        case WEBSOCKET_OP_BINARY:
+            if (isBinary(m_encoding))
+            {
+                handleWebsocketMessage(message->data, m_encoding, handler);
+            }
+            else
+            {
+                LOG(warning) << getClientId() << ": Binary message without negotiated encoding";
+            }
             break;
         case WEBSOCKET_OP_PING:
             mg_ws_send(m_connection, "", 0, WEBSOCKET_OP_PONG);
@@ -117,32 +191,255 @@ void Connection::handleWebsocketMessage(mg_ws_message *message, IClientRequestHa
     }
 }
 
-void Connection::handleWebsocketMessage(const mg_str &message, IClientRequestHandler &handler)
+void Connection::handleWebsocketMessage(const mg_str &message, MessageEncoding encoding,
+                                        IClientRequestHandler &handler)
 {
     assert(m_connection != nullptr);
 
-    common::Json       response;
-    const common::Json request = common::Json::parse(toString(message));
+    common::Json response;
+    common::Json request;
+    if (!decodeMessage(message.ptr, message.len, encoding, request))
+    {
+        LOG(warning) << getClientId() << ": Invalid " << getSubprotocol(encoding) << " message";
+        return;
+    }
 
-    if (handler.receiveRequest(getClientId(), request, response))
+    // Subscriptions are handled by the connection itself.
+    const auto type = request.find(id::Type);
+    if ((type != request.end()) && (*type == id::TypeRequestSubscribe))
+    {
+        handleSubscription(request, response);
+        sendMessage(response);
+    }
+    else if (handler.receiveRequest(getClientId(), request, response))
     {
         sendMessage(response);
     }
 }
 
+void Connection::handleSubscription(const common::Json &request, common::Json &response)
+{
+    response = {{id::Type, id::TypeResponseSubscribe}, {id::Result, id::ResultError}};
+
+    Subscription subscription;
+    const auto   fields = request.find(id::Fields);
+    if (fields != request.end())
+    {
+        if (!fields->is_array())
+        {
+            response[id::ErrorReason] = id::ErrorSubscriptionInvalid;
+            return;
+        }
+        for (const auto &field : *fields)
+        {
+            if (!field.is_string())
+            {
+                response[id::ErrorReason] = id::ErrorSubscriptionInvalid;
+                return;
+            }
+            subscription.fields.insert(field.get<std::string>());
+        }
+    }
+
+    const auto maxRate = request.find(id::MaxRate);
+    if (maxRate != request.end())
+    {
+        if (!maxRate->is_number_unsigned())
+        {
+            response[id::ErrorReason] = id::ErrorSubscriptionInvalid;
+            return;
+        }
+        const auto rate = maxRate->get<unsigned>();
+        subscription.minInterval =
+            std::chrono::milliseconds((rate == 0) ? 0 : (std::milli::den / rate));
+    }
+
+    LOG(debug) << getClientId() << ": Subscribed to " << subscription.fields.size()
+               << " fields with min interval " << subscription.minInterval.count() << "ms";
+    m_subscription   = std::move(subscription);
+    m_isSubscribed   = true;
+    m_sentState      = common::Json::object();
+    m_pendingChanges = common::Json::object();
+    m_stateVersion   = common::Json();
+    m_lastStateTime  = Clock::time_point();
+
+    response[id::Result] = id::ResultSuccess;
+}
+
+void Connection::sendNotification(const common::Json &notification, const SharedMessage &message)
+{
+    const auto start      = Clock::now();
+    const auto isSelected = [this](const std::string &field) {
+        return m_subscription.fields.empty() || (m_subscription.fields.count(field) > 0);
+    };
+    const auto type = notification.find(id::Type);
+
+    if (!m_isSubscribed)
+    {
+        queueNotification(message, (type != notification.end()) &&
+                                       (*type == id::TypeNotificationState));
+    }
+    else if ((type == notification.end()) || (*type != id::TypeNotificationState))
+    {
+        // Other notifications are sent as they are, if any of their fields is selected.
+        for (const auto &[field, value] : notification.items())
+        {
+            if ((field != id::Type) && isSelected(field))
+            {
+                queueNotification(message, false);
+                break;
+            }
+        }
+    }
+    else
+    {
+        // State changes are collected until the next state message is due.
+        for (const auto &[field, value] : notification.items())
+        {
+            if (field == id::Version)
+            {
+                m_stateVersion = value;
+            }
+            else if ((field != id::Type) && (field != id::Result) && isSelected(field))
+            {
+                const auto sent = m_sentState.find(field);
+                if ((sent != m_sentState.end()) && (*sent == value))
+                {
+                    m_pendingChanges.erase(field);
+                }
+                else
+                {
+                    m_pendingChanges[field] = value;
+                }
+            }
+        }
+    }
+    m_statistics.processingTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+}
+
+void Connection::queueNotification(const SharedMessage &message, bool isState)
+{
+    if (m_pendingNotifications.empty() && !isCongested())
+    {
+        sendMessage(*message);
+        return;
+    }
+
+    // A slow client gets the latest state only and misses the oldest other notifications.
+    const auto isPendingState = [](const PendingNotification &pending) { return pending.isState; };
+    if (isState)
+    {
+        const auto pendingState = std::find_if(m_pendingNotifications.begin(),
+                                               m_pendingNotifications.end(), isPendingState);
+        if (pendingState != m_pendingNotifications.end())
+        {
+            pendingState->message = message;
+            ++m_statistics.coalesced;
+        }
+        else
+        {
+            m_pendingNotifications.push_back({message, true});
+        }
+    }
+    else
+    {
+        const auto stateCount = static_cast<std::size_t>(std::count_if(
+            m_pendingNotifications.begin(), m_pendingNotifications.end(), isPendingState));
+        if ((m_pendingNotifications.size() - stateCount) >= MaxPendingNotifications)
+        {
+            m_pendingNotifications.erase(std::find_if_not(
+                m_pendingNotifications.begin(), m_pendingNotifications.end(), isPendingState));
+            ++m_statistics.dropped;
+        }
+        m_pendingNotifications.push_back({message, false});
+    }
+    sendPendingNotifications();
+}
+
+void Connection::sendPendingNotifications()
+{
+    while (!m_pendingNotifications.empty() && !isCongested())
+    {
+        sendMessage(*m_pendingNotifications.front().message);
+        m_pendingNotifications.pop_front();
+    }
+}
+
+void Connection::handleWrite(Clock::time_point now)
+{
+    sendPendingNotifications();
+    sendStateChanges(now);
+}
+
+bool Connection::isCongested() const
+{
+    assert(m_connection != nullptr);
+    return m_connection->send.len >= MaxSendBufferSize;
+}
+
+void Connection::sendStateChanges(Clock::time_point now)
+{
+    if (getNextStateTime() > now)
+    {
+        return;
+    }
+
+    // All changes are sent with one message.
+    const auto   start   = Clock::now();
+    common::Json message = std::move(m_pendingChanges);
+    m_pendingChanges     = common::Json::object();
+    m_sentState.update(message);
+    message[id::Type] = id::TypeNotificationState;
+    if (!m_stateVersion.is_null())
+    {
+        message[id::Version] = m_stateVersion;
+    }
+    m_lastStateTime = now;
+    sendMessage(encodeMessage(message, m_encoding));
+    m_statistics.processingTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+}
+
+Connection::Clock::time_point Connection::getNextStateTime() const
+{
+    // State changes of a congested client are merged until it has caught up.
+    if (!m_isSubscribed || m_pendingChanges.empty() || isCongested())
+    {
+        return Clock::time_point::max();
+    }
+    return m_lastStateTime + m_subscription.minInterval;
+}
+
 void Connection::sendMessage(const common::Json &response)
+{
+    LOG(debug) << getClientId() << ": Sending response: '" << response << "'";
+    sendMessage(encodeMessage(response, m_encoding));
+}
+
+void Connection::sendMessage(const std::string &message)
 {
     assert(m_connection != nullptr);
-    const std::string message = response.dump();
-    LOG(debug) << getClientId() << ": Sending response: '" << message << "'";
     const size_t sentBytes =
-        mg_ws_send(m_connection, message.c_str(), message.size(), WEBSOCKET_OP_TEXT);
+        mg_ws_send(m_connection, message.c_str(), message.size(),
+                   isBinary(m_encoding) ? WEBSOCKET_OP_BINARY : WEBSOCKET_OP_TEXT);
+
+    ++m_statistics.messages;
+    m_statistics.bytes += message.size();
 
     if (message.size() > sentBytes)
     {
         LOG(warning) << getClientId() << ": Message not completely transmitted (" << message.size()
                      << "/" << sentBytes << ")";
     }
+
+    // Responses are never held back, so a client not reading at all is dropped.
+    if (m_connection->send.len > MaxBufferedSize)
+    {
+        LOG(warning) << getClientId() << ": Closing connection with " << m_connection->send.len
+                     << " bytes not transmitted";
+        m_connection->is_closing = 1;
+    }
 }
 
 void Connection::handleWebsocketControl(mg_ws_message *message)
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <mongoose.h>
+
+#include "RemoteControl/ConnectionTable.hpp"
+
+using namespace sugo::remote_control;
+
+Connection &ConnectionTable::add(mg_connection *connection)
+{
+    uint32_t index = 0;
+    if (m_freeSlots.empty())
+    {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    else
+    {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+
+    auto &slot      = m_slots[index];
+    slot.connection = Connection(connection);
+    slot.isUsed     = true;
+
+    // The connection id is unique for the lifetime of the mongoose manager.
+    m_slotIndices[connection->id] = index;
+    ++m_size;
+    return slot.connection;
+}
+
+Connection *ConnectionTable::find(const mg_connection *connection)
+{
+    const auto found = m_slotIndices.find(connection->id);
+    if (found == m_slotIndices.end())
+    {
+        return nullptr;
+    }
+    return &m_slots[found->second].connection;
+}
+
+bool ConnectionTable::remove(const mg_connection *connection)
+{
+    const auto found = m_slotIndices.find(connection->id);
+    if (found == m_slotIndices.end())
+    {
+        return false;
+    }
+    auto &slot      = m_slots[found->second];
+    slot.connection = Connection();
+    slot.isUsed     = false;
+    m_freeSlots.push_back(found->second);
+    m_slotIndices.erase(found);
+    --m_size;
+    return true;
+}
+
+void ConnectionTable::clear()
+{
+    m_slots.clear();
+    m_freeSlots.clear();
+    m_slotIndices.clear();
+    m_size = 0;
+}
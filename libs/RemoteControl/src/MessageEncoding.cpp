@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#include "RemoteControl/HeaderValue.hpp"
+#include "RemoteControl/MessageEncoding.hpp"
+#include "RemoteControl/Protocol.hpp"
+
+using namespace sugo;
+using namespace sugo::remote_control;
+
+const std::string &remote_control::getSubprotocol(MessageEncoding encoding)
+{
+    switch (encoding)
+    {
+        case MessageEncoding::Cbor:
+            return id::SubprotocolCbor;
+        case MessageEncoding::MessagePack:
+            return id::SubprotocolMessagePack;
+        case MessageEncoding::Json:
+        default:
+            return id::SubprotocolJson;
+    }
+}
+
+bool remote_control::selectMessageEncoding(std::string_view subprotocols,
+                                           MessageEncoding &encoding)
+{
+    bool isSelected = false;
+    forEachElement(subprotocols, [&](std::string_view subprotocol) {
+        for (auto candidate : {MessageEncoding::Json, MessageEncoding::Cbor,
+                               MessageEncoding::MessagePack})
+        {
+            if (!isSelected && (subprotocol == getSubprotocol(candidate)))
+            {
+                encoding   = candidate;
+                isSelected = true;
+            }
+        }
+    });
+    return isSelected;
+}
+
+std::string remote_control::encodeMessage(const common::Json &message, MessageEncoding encoding)
+{
+    std::string encoded;
+    switch (encoding)
+    {
+        case MessageEncoding::Cbor:
+            common::Json::to_cbor(message, encoded);
+            break;
+        case MessageEncoding::MessagePack:
+            common::Json::to_msgpack(message, encoded);
+            break;
+        case MessageEncoding::Json:
+        default:
+            encoded = message.dump();
+            break;
+    }
+    return encoded;
+}
+
+bool remote_control::decodeMessage(const char *data, std::size_t size, MessageEncoding encoding,
+                                   common::Json &message)
+{
+    // The binary codecs read bytes, the received data is never copied.
+    const auto *first = reinterpret_cast<const uint8_t *>(data);  // NOLINT
+    const auto *last  = first + size;                             // NOLINT
+    switch (encoding)
+    {
+        case MessageEncoding::Cbor:
+            message = common::Json::from_cbor(first, last, true, false);
+            break;
+        case MessageEncoding::MessagePack:
+            message = common::Json::from_msgpack(first, last, true, false);
+            break;
+        case MessageEncoding::Json:
+        default:
+            message = common::Json::parse(data, data + size, nullptr, false);  // NOLINT
+            break;
+    }
+    return !message.is_discarded();
+}
@@ -23,13 +23,18 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <mongoose.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
 #include <boost/regex.hpp>
 #include <cassert>
 #include <mutex>
+#include <thread>
 
 #include "Common/Logger.hpp"
 #include "Common/Types.hpp"
 #include "RemoteControl/Configuration.hpp"
+#include "RemoteControl/Protocol.hpp"
 #include "RemoteControl/RemoteControlServer.hpp"
 
 using namespace sugo::remote_control;
@@ -71,10 +76,26 @@ bool RemoteControlServer::start()
         return false;
     }
 
-    return m_thread.start([&] {
-        mg_mgr_init(m_serverStatus.get());
-        (void)listen();
-    });
+    // The static assets are loaded once, so page loads need no disk access afterwards.
+    if (!m_assets.load(m_docRoot))
+    {
+        LOG(warning) << "Static assets not cached, serving them from " << m_docRoot;
+    }
+
+    // Set before the thread starts, so that an early stop request is not overwritten.
+    m_doListen = true;
+    if (!m_thread.start([&] {
+            mg_mgr_init(m_serverStatus.get());
+            if (!listen())
+            {
+                m_doListen = false;
+            }
+        }))
+    {
+        m_doListen = false;
+        return false;
+    }
+    return true;
 }
 
 void RemoteControlServer::stop()
@@ -83,20 +104,149 @@ void RemoteControlServer::stop()
     if (isRunning())
     {
         m_doListen = false;
+        wakeup();
         waitUntilFinished();
         mg_mgr_free(m_serverStatus.get());
+
+        const auto statistics = getBroadcastStatistics();
+        LOG(info) << "Broadcasts: notifications=" << statistics.broadcasts
+                  << ", messages=" << statistics.messages << ", dropped=" << statistics.dropped
+                  << ", maxClients=" << statistics.maxClients << ", bytes=" << statistics.bytes
+                  << ", latency=" << statistics.latency.count()
+                  << "us, maxLatency=" << statistics.maxLatency.count()
+                  << "us, processingTime=" << statistics.processingTime.count() << "us";
     }
 }
 
 void RemoteControlServer::sendNotification(const common::Json &notification)
 {
-    std::lock_guard<std::mutex> lock(m_mutexStartStop);
-    for (auto &[key, connection] : m_connections)
+    if (!m_doListen)
+    {
+        return;
+    }
+
+    // Mongoose is not thread-safe, so the connections are served by the listener thread only.
+    // The notification is encoded by the listener thread once per encoding used by the clients.
+    if (!m_broadcasts.push(
+            Broadcast{std::make_shared<const common::Json>(notification), {}, Clock::now()}))
+    {
+        LOG(warning) << "Broadcast queue full, notification dropped";
+        std::lock_guard<std::mutex> lock(m_mutexStatistics);
+        ++m_broadcastStatistics.dropped;
+        return;
+    }
+    wakeup();
+}
+
+void RemoteControlServer::wakeup()
+{
+    ++m_wakeupSenders;
+    const int socket = m_wakeupSocket;
+    if (socket >= 0)
     {
-        if (connection.isOpenWebsocket())
+        // A lost wakeup signal is caught up with the next poll.
+        static constexpr char signal = 0;
+        (void)::send(socket, &signal, sizeof(signal), MSG_NOSIGNAL);
+    }
+    --m_wakeupSenders;
+}
+
+void RemoteControlServer::broadcastNotifications()
+{
+    Broadcast broadcast;
+    while (m_broadcasts.pop(broadcast))
+    {
+        std::size_t            clients = 0;
+        Connection::Statistics sent;
+        m_connections.forEach([&](Connection &connection) {
+            if (connection.isOpenWebsocket())
+            {
+                const auto before = connection.getStatistics();
+                connection.sendNotification(*broadcast.notification,
+                                            getMessage(broadcast, connection.getEncoding()));
+                connection.sendStateChanges(Clock::now());
+                sent.bytes += connection.getStatistics().bytes - before.bytes;
+                sent.processingTime +=
+                    connection.getStatistics().processingTime - before.processingTime;
+                ++clients;
+            }
+        });
+
+        // The last state is kept with its encodings for clients subscribing later on.
+        if (broadcast.notification->value(id::Type, "") == id::TypeNotificationState)
         {
-            connection.sendMessage(notification);
+            m_lastState = broadcast;
         }
+
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - broadcast.queueTime);
+        std::lock_guard<std::mutex> lock(m_mutexStatistics);
+        ++m_broadcastStatistics.broadcasts;
+        m_broadcastStatistics.messages += clients;
+        m_broadcastStatistics.bytes += sent.bytes;
+        m_broadcastStatistics.processingTime += sent.processingTime;
+        m_broadcastStatistics.maxClients = std::max(m_broadcastStatistics.maxClients, clients);
+        m_broadcastStatistics.latency += latency;
+        m_broadcastStatistics.maxLatency = std::max(m_broadcastStatistics.maxLatency, latency);
+    }
+}
+
+const Connection::SharedMessage &RemoteControlServer::getMessage(Broadcast      &broadcast,
+                                                                 MessageEncoding encoding)
+{
+    auto &message = broadcast.messages.at(static_cast<std::size_t>(encoding));
+    if (!message)
+    {
+        message =
+            std::make_shared<const std::string>(encodeMessage(*broadcast.notification, encoding));
+    }
+    return message;
+}
+
+void RemoteControlServer::sendStateChanges()
+{
+    Connection::Statistics sent;
+    m_connections.forEach([&](Connection &connection) {
+        const auto before = connection.getStatistics();
+        connection.sendStateChanges(Clock::now());
+        sent.bytes += connection.getStatistics().bytes - before.bytes;
+        sent.processingTime += connection.getStatistics().processingTime - before.processingTime;
+    });
+
+    std::lock_guard<std::mutex> lock(m_mutexStatistics);
+    m_broadcastStatistics.bytes += sent.bytes;
+    m_broadcastStatistics.processingTime += sent.processingTime;
+}
+
+int RemoteControlServer::getPollTimeout() const
+{
+    // The loop is woken up by the wakeup pipe on outgoing work and on stop, so the timeout is
+    // a fallback only.
+    static constexpr std::chrono::milliseconds maxPollTimeout{1000};
+
+    // The poll has to return in time for the next state changes of a subscribed client.
+    const auto now      = Clock::now();
+    auto       deadline = now + maxPollTimeout;
+    m_connections.forEach([&deadline](const Connection &connection) {
+        deadline = std::min(deadline, connection.getNextStateTime());
+    });
+    const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+    return static_cast<int>(std::max(timeout, std::chrono::milliseconds(0)).count());
+}
+
+void RemoteControlServer::handleWakeupEvent(mg_connection *connection, int event)
+{
+    switch (event)
+    {
+        case MG_EV_READ:  // Wakeup signal received       struct mg_str *
+            connection->recv.len = 0;
+            broadcastNotifications();
+            break;
+        case MG_EV_POLL:  // mg_mgr_poll iteration        uint64_t *milliseconds
+            broadcastNotifications();
+            break;
+        default:
+            break;
     }
 }
 
@@ -105,43 +255,70 @@ void RemoteControlServer::handleEvent(mg_connection *mgConnection, int event, vo
     switch (event)
     {
         case MG_EV_HTTP_MSG:  // HTTP request/response        struct mg_http_message *
-            getConnection(mgConnection->id)
-                .handleHttpMessage(static_cast<mg_http_message *>(eventData), m_docRoot);
+            getConnection(mgConnection)
+                .handleHttpMessage(static_cast<mg_http_message *>(eventData), m_assets,
+                                   m_docRoot);
             break;
         case MG_EV_ERROR:  // Error                        char *error_message
-            getConnection(mgConnection->id).handleError(static_cast<const char *>(eventData));
+            getConnection(mgConnection).handleError(static_cast<const char *>(eventData));
             break;
         case MG_EV_OPEN:  // Connection created           NULL
-        {
-            std::lock_guard<std::mutex> lock(m_mutexStartStop);
-            m_connections[mgConnection->id] = Connection(mgConnection);
-        }
+            (void)m_connections.add(mgConnection);
             LOG(debug) << "New connection: " << mgConnection->id;
             break;
         case MG_EV_CLOSE:  // Connection closed            NULL
         {
-            std::lock_guard<std::mutex> lock(m_mutexStartStop);
-            m_connections.erase(mgConnection->id);
+            const auto *connection = m_connections.find(mgConnection);
+            if (connection != nullptr)
+            {
+                const auto &statistics = connection->getStatistics();
+                LOG(debug) << "Connection closed: " << mgConnection->id
+                           << " (messages=" << statistics.messages
+                           << ", bytes=" << statistics.bytes << ", dropped=" << statistics.dropped
+                           << ", coalesced=" << statistics.coalesced
+                           << ", processingTime=" << statistics.processingTime.count() << "us)";
+                (void)m_connections.remove(mgConnection);
+            }
         }
-            LOG(debug) << "Connection closed: " << mgConnection->id;
-            break;
+        break;
         case MG_EV_WS_OPEN:  // Websocket handshake done     struct mg_http_message *
-            getConnection(mgConnection->id)
+            getConnection(mgConnection)
                 .handleWebsocketOpen(static_cast<mg_http_message *>(eventData));
             break;
         case MG_EV_WS_MSG:  // Websocket msg, text or bin   struct mg_ws_message *
-            getConnection(mgConnection->id)
-                .handleWebsocketMessage(static_cast<mg_ws_message *>(eventData), m_requestHandler);
-            break;
+        {
+            auto &connection = getConnection(mgConnection);
+            connection.handleWebsocketMessage(static_cast<mg_ws_message *>(eventData),
+                                              m_requestHandler);
+
+            // Subscribed clients are brought up to the last known state, which sends nothing if
+            // they know it already.
+            if (connection.isSubscribed() && m_lastState.notification)
+            {
+                connection.sendNotification(*m_lastState.notification,
+                                            getMessage(m_lastState, connection.getEncoding()));
+                connection.sendStateChanges(Clock::now());
+            }
+        }
+        break;
+        case MG_EV_WRITE:  // Data written to socket       long *bytes_written
+        {
+            // Notifications held back for a congested client are sent, when it catches up.
+            auto *connection = m_connections.find(mgConnection);
+            if (connection != nullptr)
+            {
+                connection->handleWrite(Clock::now());
+            }
+        }
+        break;
         case MG_EV_WS_CTL:  // Websocket control msg        struct mg_ws_message *
-            getConnection(mgConnection->id)
+            getConnection(mgConnection)
                 .handleWebsocketControl(static_cast<mg_ws_message *>(eventData));
             break;
         case MG_EV_RESOLVE:     // Host name is resolved        NULL
         case MG_EV_CONNECT:     // Connection established       NULL
         case MG_EV_ACCEPT:      // Connection accepted          NULL
         case MG_EV_READ:        // Data received from socket    struct mg_str *
-        case MG_EV_WRITE:       // Data written to socket       long *bytes_written
         case MG_EV_HTTP_CHUNK:  // HTTP chunk (partial msg)     struct mg_http_message *
         case MG_EV_MQTT_CMD:    // MQTT low-level command       struct mg_mqtt_message *
         case MG_EV_MQTT_MSG:    // MQTT PUBLISH received        struct mg_mqtt_message *
@@ -176,12 +353,41 @@ bool RemoteControlServer::listen()
         return false;
     }
 
-    for (m_doListen = true; m_doListen;)
+    // Other threads wake up the poll by sending to the pipe.
+    const int wakeupSocket = mg_mkpipe(
+        m_serverStatus.get(),
+        [](mg_connection *connection, int event, void *, void *data) {
+            assert(data != nullptr);
+            auto *server = static_cast<RemoteControlServer *>(data);
+            server->handleWakeupEvent(connection, event);
+        },
+        this, true);
+    if (wakeupSocket < 0)
+    {
+        LOG(error) << "Failed to create wakeup pipe";
+        return false;
+    }
+    m_wakeupSocket = wakeupSocket;
+
+    while (m_doListen)
+    {
+        mg_mgr_poll(m_serverStatus.get(), getPollTimeout());
+        sendStateChanges();
+    }
+
+    (void)m_wakeupSocket.exchange(-1);
+    while (m_wakeupSenders > 0)
+    {
+        std::this_thread::yield();
+    }
+    ::close(wakeupSocket);
+
+    // Notifications left over are not sent anymore.
+    Broadcast broadcast;
+    while (m_broadcasts.pop(broadcast))
     {
-        static constexpr int pollTimeoutMs =
-            1000;  // TODO request value from configuration interface!
-        mg_mgr_poll(m_serverStatus.get(), pollTimeoutMs);
     }
+    m_lastState = Broadcast();
     m_connections.clear();
     LOG(debug) << "Finish listening";
     return true;
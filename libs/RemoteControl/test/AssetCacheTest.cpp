@@ -0,0 +1,143 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "Common/Logger.hpp"
+#include "RemoteControl/AssetCache.hpp"
+
+using namespace sugo;
+using namespace sugo::remote_control;
+
+class AssetCacheTest : public ::testing::Test
+{
+protected:
+    AssetCacheTest()
+    {
+        m_asset.lastModified = "Fri, 22 Sep 2023 10:00:00 GMT";
+        m_asset.identity     = {"content", "\"identity\"", ""};
+        m_asset.gzip         = AssetCache::Representation{"gz", "\"identity-gzip\"", "gzip"};
+        m_asset.brotli       = AssetCache::Representation{"br", "\"identity-br\"", "br"};
+    }
+
+    static void SetUpTestCase()
+    {
+        common::Logger::init();
+    }
+
+    void TearDown() override
+    {
+        std::error_code error;
+        std::filesystem::remove_all(m_docRoot, error);
+    }
+
+    /// Writes a file of the document root with the passed age.
+    void writeFile(const std::string& name, const std::string& content,
+                   std::filesystem::file_time_type::duration age)
+    {
+        const auto path = m_docRoot / name;
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary) << content;
+        std::filesystem::last_write_time(path, m_now - age);
+    }
+
+    AssetCache::Asset                     m_asset;
+    const std::filesystem::path           m_docRoot = std::filesystem::temp_directory_path() /
+                                            ("AssetCacheTest" + std::to_string(::getpid()));
+    const std::filesystem::file_time_type m_now = std::filesystem::file_time_type::clock::now();
+};
+
+TEST_F(AssetCacheTest, SelectRepresentation)
+{
+    EXPECT_EQ(&AssetCache::selectRepresentation(m_asset, ""), &m_asset.identity);
+    EXPECT_EQ(&AssetCache::selectRepresentation(m_asset, "identity, deflate"), &m_asset.identity);
+    EXPECT_EQ(&AssetCache::selectRepresentation(m_asset, "gzip"), &*m_asset.gzip);
+
+    // Brotli is preferred over gzip, regardless of the order.
+    EXPECT_EQ(&AssetCache::selectRepresentation(m_asset, "gzip, deflate, br"), &*m_asset.brotli);
+    EXPECT_EQ(&AssetCache::selectRepresentation(m_asset, " br ;q=0.5 , gzip"), &*m_asset.brotli);
+
+    // Codings with a quality value of zero are not acceptable.
+    EXPECT_EQ(&AssetCache::selectRepresentation(m_asset, "br;q=0, gzip"), &*m_asset.gzip);
+    EXPECT_EQ(&AssetCache::selectRepresentation(m_asset, "br;q=0.0, gzip; q=0"),
+              &m_asset.identity);
+
+    // Only available variants are selected.
+    m_asset.brotli.reset();
+    EXPECT_EQ(&AssetCache::selectRepresentation(m_asset, "br, gzip"), &*m_asset.gzip);
+    m_asset.gzip.reset();
+    EXPECT_EQ(&AssetCache::selectRepresentation(m_asset, "br, gzip"), &m_asset.identity);
+}
+
+TEST_F(AssetCacheTest, IsNotModified)
+{
+    EXPECT_FALSE(AssetCache::isNotModified(m_asset, "", ""));
+
+    // Strong and weak entity tags of all representations match.
+    EXPECT_TRUE(AssetCache::isNotModified(m_asset, "\"identity\"", ""));
+    EXPECT_TRUE(AssetCache::isNotModified(m_asset, "W/\"identity\"", ""));
+    EXPECT_TRUE(AssetCache::isNotModified(m_asset, "\"other\", W/\"identity-br\"", ""));
+    EXPECT_TRUE(AssetCache::isNotModified(m_asset, "\"identity-gzip\"", ""));
+    EXPECT_TRUE(AssetCache::isNotModified(m_asset, "*", ""));
+    EXPECT_FALSE(AssetCache::isNotModified(m_asset, "\"other\", W/\"identity-\"", ""));
+    EXPECT_FALSE(AssetCache::isNotModified(m_asset, "identity", ""));
+
+    // If-Modified-Since is only used without If-None-Match.
+    EXPECT_TRUE(AssetCache::isNotModified(m_asset, "", m_asset.lastModified));
+    EXPECT_FALSE(AssetCache::isNotModified(m_asset, "", "Fri, 22 Sep 2023 09:00:00 GMT"));
+    EXPECT_FALSE(AssetCache::isNotModified(m_asset, "\"other\"", m_asset.lastModified));
+}
+
+TEST_F(AssetCacheTest, LoadSkipsOutdatedVariants)
+{
+    writeFile("index.html", "<html></html>", std::chrono::hours(1));
+    writeFile("index.html.gz", "gz", std::chrono::minutes(30));
+    writeFile("index.html.br", "br", std::chrono::hours(2));
+    writeFile("js/app.js", "app", std::chrono::hours(0));
+    writeFile("js/app.js.gz", "gz", std::chrono::hours(1));
+    writeFile("archive.gz", "archive", std::chrono::hours(1));
+
+    AssetCache cache;
+    ASSERT_TRUE(cache.load(m_docRoot.string()));
+    EXPECT_EQ(cache.getCount(), 3u);
+
+    const auto* index = cache.find("/");
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->identity.content, "<html></html>");
+    ASSERT_TRUE(index->gzip.has_value());
+    EXPECT_EQ(index->gzip->content, "gz");
+    EXPECT_FALSE(index->brotli.has_value());
+
+    const auto* app = cache.find("/js/app.js");
+    ASSERT_NE(app, nullptr);
+    EXPECT_FALSE(app->gzip.has_value());
+    EXPECT_NE(cache.find("/archive.gz"), nullptr);
+    EXPECT_EQ(cache.find("/index.html.gz"), nullptr);
+}
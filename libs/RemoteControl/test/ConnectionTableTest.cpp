@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <mongoose.h>
+
+#include "Common/Logger.hpp"
+#include "RemoteControl/ConnectionTable.hpp"
+
+using namespace sugo;
+using namespace sugo::remote_control;
+
+class ConnectionTableTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        common::Logger::init();
+    }
+
+    void SetUp() override
+    {
+        for (unsigned long i = 0; i < (sizeof(m_mgConnections) / sizeof(m_mgConnections[0])); ++i)
+        {
+            m_mgConnections[i].id = i + 1;
+        }
+    }
+
+    mg_connection   m_mgConnections[3]{};
+    ConnectionTable m_table;
+};
+
+TEST_F(ConnectionTableTest, AddFindRemove)
+{
+    EXPECT_EQ(m_table.size(), 0u);
+    EXPECT_EQ(m_table.find(&m_mgConnections[0]), nullptr);
+
+    for (auto& mgConnection : m_mgConnections)
+    {
+        EXPECT_EQ(m_table.add(&mgConnection).getClientId(), mgConnection.id);
+    }
+    EXPECT_EQ(m_table.size(), 3u);
+    for (auto& mgConnection : m_mgConnections)
+    {
+        const auto* connection = m_table.find(&mgConnection);
+        ASSERT_NE(connection, nullptr);
+        EXPECT_EQ(connection->getClientId(), mgConnection.id);
+    }
+
+    EXPECT_TRUE(m_table.remove(&m_mgConnections[1]));
+    EXPECT_FALSE(m_table.remove(&m_mgConnections[1]));
+    EXPECT_EQ(m_table.size(), 2u);
+    EXPECT_EQ(m_table.find(&m_mgConnections[1]), nullptr);
+    EXPECT_NE(m_table.find(&m_mgConnections[0]), nullptr);
+    EXPECT_NE(m_table.find(&m_mgConnections[2]), nullptr);
+
+    unsigned count = 0;
+    m_table.forEach([&count](const Connection&) { ++count; });
+    EXPECT_EQ(count, 2u);
+
+    m_table.clear();
+    EXPECT_EQ(m_table.size(), 0u);
+    EXPECT_EQ(m_table.find(&m_mgConnections[0]), nullptr);
+}
+
+TEST_F(ConnectionTableTest, ReusedSlot)
+{
+    (void)m_table.add(&m_mgConnections[0]);
+    mg_connection staleConnection = m_mgConnections[0];
+    EXPECT_TRUE(m_table.remove(&m_mgConnections[0]));
+
+    // The slot is reused, but the removed connection is not found in it.
+    (void)m_table.add(&m_mgConnections[1]);
+    EXPECT_EQ(m_table.size(), 1u);
+    EXPECT_EQ(m_table.find(&staleConnection), nullptr);
+    EXPECT_FALSE(m_table.remove(&staleConnection));
+    const auto* connection = m_table.find(&m_mgConnections[1]);
+    ASSERT_NE(connection, nullptr);
+    EXPECT_EQ(connection->getClientId(), m_mgConnections[1].id);
+
+    // Connections not added are never found.
+    EXPECT_EQ(m_table.find(&m_mgConnections[2]), nullptr);
+}
@@ -0,0 +1,289 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <mongoose.h>
+#include <chrono>
+#include <string>
+
+#include "Common/Logger.hpp"
+#include "Fake/MongooseFake.hpp"
+#include "RemoteControl/Connection.hpp"
+#include "RemoteControl/Protocol.hpp"
+
+using namespace sugo;
+using namespace sugo::remote_control;
+
+namespace
+{
+/// Request handler, which is never called for subscriptions.
+class RequestHandler : public IClientRequestHandler
+{
+public:
+    bool receiveRequest(ClientId, const common::Json&, common::Json&) override
+    {
+        ++requestCount;
+        return false;
+    }
+
+    void registerSendNotification(SendNotificationCallback) override
+    {
+    }
+
+    unsigned requestCount = 0;
+};
+}  // namespace
+
+class ConnectionTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        common::Logger::init();
+    }
+
+    void SetUp() override
+    {
+        fake::reset();
+        m_mgConnection.id = 1;
+    }
+
+    void receive(const common::Json& request)
+    {
+        const std::string data = request.dump();
+        mg_ws_message     message{{data.c_str(), data.size()}, WEBSOCKET_OP_TEXT};
+        m_connection.handleWebsocketMessage(&message, m_handler);
+    }
+
+    void notify(const common::Json& notification)
+    {
+        m_connection.sendNotification(
+            notification, std::make_shared<const std::string>(notification.dump()));
+    }
+
+    common::Json subscribe(const common::Json& fields, unsigned maxRate)
+    {
+        receive(
+            {{id::Type, id::TypeRequestSubscribe}, {id::Fields, fields}, {id::MaxRate, maxRate}});
+        return popSentMessage();
+    }
+
+    common::Json popSentMessage()
+    {
+        auto& messages = fake::getSentWebsocketMessages();
+        if (messages.empty())
+        {
+            return common::Json();
+        }
+        const auto message = common::Json::parse(messages.front().data);
+        messages.erase(messages.begin());
+        return message;
+    }
+
+    static common::Json createState(const std::string& state, unsigned speed, unsigned version)
+    {
+        return {{id::Type, id::TypeNotificationState},
+                {id::Result, id::ResultSuccess},
+                {id::State, state},
+                {id::Speed, speed},
+                {id::Version, version}};
+    }
+
+    mg_connection  m_mgConnection{};
+    Connection     m_connection{&m_mgConnection};
+    RequestHandler m_handler;
+};
+
+TEST_F(ConnectionTest, Subscribe)
+{
+    const auto response = subscribe({id::State}, 10u);
+    EXPECT_EQ(response.at(id::Type), id::TypeResponseSubscribe);
+    EXPECT_EQ(response.at(id::Result), id::ResultSuccess);
+    EXPECT_TRUE(m_connection.isSubscribed());
+    EXPECT_EQ(m_handler.requestCount, 0u);
+
+    // Only the selected fields are sent with the version.
+    const auto now = Connection::Clock::now();
+    notify(createState("running", 100u, 1u));
+    EXPECT_TRUE(fake::getSentWebsocketMessages().empty());
+    EXPECT_LE(m_connection.getNextStateTime(), now);
+    m_connection.sendStateChanges(now);
+    const auto state = popSentMessage();
+    EXPECT_EQ(state, common::Json({{id::Type, id::TypeNotificationState},
+                                   {id::State, "running"},
+                                   {id::Version, 1u}}));
+
+    // Other notifications are only sent, if one of their fields is selected.
+    notify({{id::Type, id::TypeNotificationTelemetry}, {id::Telemetry, 1}});
+    EXPECT_TRUE(fake::getSentWebsocketMessages().empty());
+    notify({{id::Type, id::TypeNotificationTelemetry}, {id::State, "running"}});
+    EXPECT_EQ(popSentMessage().at(id::Type), id::TypeNotificationTelemetry);
+}
+
+TEST_F(ConnectionTest, SubscribeInvalid)
+{
+    const auto expectInvalid = [this](const common::Json& request) {
+        receive(request);
+        const auto response = popSentMessage();
+        EXPECT_EQ(response.at(id::Type), id::TypeResponseSubscribe);
+        EXPECT_EQ(response.at(id::Result), id::ResultError);
+        EXPECT_EQ(response.at(id::ErrorReason), id::ErrorSubscriptionInvalid);
+        EXPECT_FALSE(m_connection.isSubscribed());
+    };
+
+    expectInvalid({{id::Type, id::TypeRequestSubscribe}, {id::Fields, id::State}});
+    expectInvalid({{id::Type, id::TypeRequestSubscribe}, {id::Fields, {id::State, 1}}});
+    expectInvalid({{id::Type, id::TypeRequestSubscribe}, {id::MaxRate, -1}});
+    expectInvalid({{id::Type, id::TypeRequestSubscribe}, {id::MaxRate, "10"}});
+
+    // Not subscribed clients receive all notifications as they are.
+    const auto notification = createState("running", 100u, 1u);
+    notify(notification);
+    EXPECT_EQ(popSentMessage(), notification);
+}
+
+TEST_F(ConnectionTest, RateLimit)
+{
+    ASSERT_EQ(subscribe({id::State, id::Speed}, 10u).at(id::Result), id::ResultSuccess);
+
+    const auto now = Connection::Clock::now();
+    notify(createState("running", 100u, 1u));
+    m_connection.sendStateChanges(now);
+    EXPECT_EQ(popSentMessage().at(id::Speed), 100u);
+
+    // Changes within the min interval are merged into one message.
+    notify(createState("running", 200u, 2u));
+    notify(createState("running", 300u, 3u));
+    EXPECT_EQ(m_connection.getNextStateTime(), now + std::chrono::milliseconds(100));
+    m_connection.sendStateChanges(now + std::chrono::milliseconds(99));
+    EXPECT_TRUE(fake::getSentWebsocketMessages().empty());
+    m_connection.sendStateChanges(now + std::chrono::milliseconds(100));
+    EXPECT_EQ(popSentMessage(), common::Json({{id::Type, id::TypeNotificationState},
+                                              {id::Speed, 300u},
+                                              {id::Version, 3u}}));
+    EXPECT_TRUE(fake::getSentWebsocketMessages().empty());
+}
+
+TEST_F(ConnectionTest, UnchangedFieldsSuppressed)
+{
+    ASSERT_EQ(subscribe(common::Json::array(), 0u).at(id::Result), id::ResultSuccess);
+
+    const auto now = Connection::Clock::now();
+    notify(createState("running", 100u, 1u));
+    m_connection.sendStateChanges(now);
+    EXPECT_EQ(popSentMessage().at(id::State), "running");
+
+    // Unchanged values are not sent again, even if they changed in between.
+    notify(createState("running", 100u, 2u));
+    EXPECT_EQ(m_connection.getNextStateTime(), Connection::Clock::time_point::max());
+    notify(createState("running", 200u, 3u));
+    notify(createState("running", 100u, 4u));
+    EXPECT_EQ(m_connection.getNextStateTime(), Connection::Clock::time_point::max());
+    m_connection.sendStateChanges(now + std::chrono::seconds(1));
+    EXPECT_TRUE(fake::getSentWebsocketMessages().empty());
+
+    notify(createState("stopped", 100u, 5u));
+    m_connection.sendStateChanges(now + std::chrono::seconds(1));
+    EXPECT_EQ(popSentMessage(), common::Json({{id::Type, id::TypeNotificationState},
+                                              {id::State, "stopped"},
+                                              {id::Version, 5u}}));
+}
+
+TEST_F(ConnectionTest, CongestedKeepsOrder)
+{
+    const auto telemetry = [](int value) {
+        return common::Json({{id::Type, id::TypeNotificationTelemetry}, {id::Telemetry, value}});
+    };
+
+    // Held back notifications are sent in order, the latest state replaces the held back one.
+    m_mgConnection.send.len = Connection::MaxSendBufferSize;
+    notify(telemetry(1));
+    notify(createState("running", 100u, 1u));
+    notify(telemetry(2));
+    notify(createState("stopped", 0u, 2u));
+    notify(telemetry(3));
+    EXPECT_TRUE(fake::getSentWebsocketMessages().empty());
+
+    m_mgConnection.send.len = 0;
+    m_connection.handleWrite(Connection::Clock::now());
+    EXPECT_EQ(popSentMessage(), telemetry(1));
+    EXPECT_EQ(popSentMessage(), createState("stopped", 0u, 2u));
+    EXPECT_EQ(popSentMessage(), telemetry(2));
+    EXPECT_EQ(popSentMessage(), telemetry(3));
+    EXPECT_TRUE(fake::getSentWebsocketMessages().empty());
+    EXPECT_EQ(m_connection.getStatistics().coalesced, 1u);
+    EXPECT_EQ(m_connection.getStatistics().dropped, 0u);
+
+    // Without congestion, the notifications are sent at once.
+    notify(telemetry(4));
+    EXPECT_EQ(popSentMessage(), telemetry(4));
+}
+
+TEST_F(ConnectionTest, CongestedDropsOldestNotifications)
+{
+    const auto telemetry = [](std::size_t value) {
+        return common::Json({{id::Type, id::TypeNotificationTelemetry}, {id::Telemetry, value}});
+    };
+
+    m_mgConnection.send.len = Connection::MaxSendBufferSize;
+    notify(createState("running", 100u, 1u));
+    for (std::size_t i = 0; i <= Connection::MaxPendingNotifications; ++i)
+    {
+        notify(telemetry(i));
+    }
+
+    // The held back state is never dropped.
+    m_mgConnection.send.len = 0;
+    m_connection.handleWrite(Connection::Clock::now());
+    EXPECT_EQ(popSentMessage(), createState("running", 100u, 1u));
+    for (std::size_t i = 1; i <= Connection::MaxPendingNotifications; ++i)
+    {
+        EXPECT_EQ(popSentMessage(), telemetry(i));
+    }
+    EXPECT_TRUE(fake::getSentWebsocketMessages().empty());
+    EXPECT_EQ(m_connection.getStatistics().dropped, 1u);
+}
+
+TEST_F(ConnectionTest, CongestedMergesStateChanges)
+{
+    ASSERT_EQ(subscribe(common::Json::array(), 0u).at(id::Result), id::ResultSuccess);
+
+    // State changes of a congested client are merged until it has caught up.
+    const auto now          = Connection::Clock::now();
+    m_mgConnection.send.len = Connection::MaxSendBufferSize;
+    notify(createState("running", 100u, 1u));
+    notify(createState("running", 200u, 2u));
+    EXPECT_EQ(m_connection.getNextStateTime(), Connection::Clock::time_point::max());
+    m_connection.sendStateChanges(now);
+    EXPECT_TRUE(fake::getSentWebsocketMessages().empty());
+
+    m_mgConnection.send.len = 0;
+    m_connection.handleWrite(now);
+    EXPECT_EQ(popSentMessage(), common::Json({{id::Type, id::TypeNotificationState},
+                                              {id::State, "running"},
+                                              {id::Speed, 200u},
+                                              {id::Version, 2u}}));
+    EXPECT_TRUE(fake::getSentWebsocketMessages().empty());
+}
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <mongoose.h>
+#include <cstring>
+
+#include "MongooseFake.hpp"
+
+using namespace sugo::remote_control;
+
+namespace
+{
+std::vector<fake::WebsocketMessage> sentWebsocketMessages;  // NOLINT
+std::string                         sentData;               // NOLINT
+
+bool isEqual(const mg_str &str, const char *value)
+{
+    return (str.len == std::strlen(value)) && (std::strncmp(str.ptr, value, str.len) == 0);
+}
+}  // namespace
+
+std::vector<fake::WebsocketMessage> &fake::getSentWebsocketMessages()
+{
+    return sentWebsocketMessages;
+}
+
+std::string &fake::getSentData()
+{
+    return sentData;
+}
+
+void fake::reset()
+{
+    sentWebsocketMessages.clear();
+    sentData.clear();
+}
+
+struct mg_str mg_str_s(const char *s)
+{
+    return {s, (s != nullptr) ? std::strlen(s) : 0};
+}
+
+struct mg_str *mg_http_get_header(struct mg_http_message *, const char *)
+{
+    return nullptr;
+}
+
+bool mg_match(struct mg_str str, struct mg_str pattern, struct mg_str *)
+{
+    // Exact matches only, no wildcards are needed.
+    return (str.len == pattern.len) && (std::strncmp(str.ptr, pattern.ptr, str.len) == 0);
+}
+
+bool mg_http_match_uri(const struct mg_http_message *message, const char *glob)
+{
+    return isEqual(message->uri, glob);
+}
+
+bool mg_send(struct mg_connection *, const void *data, size_t size)
+{
+    sentData.append(static_cast<const char *>(data), size);
+    return true;
+}
+
+size_t mg_ws_send(struct mg_connection *, const void *buf, size_t len, int op)
+{
+    sentWebsocketMessages.push_back({std::string(static_cast<const char *>(buf), len), op});
+    return len;
+}
+
+void mg_ws_upgrade(struct mg_connection *, struct mg_http_message *, const char *, ...)
+{
+}
+
+void mg_http_serve_dir(struct mg_connection *, struct mg_http_message *,
+                       const struct mg_http_serve_opts *)
+{
+}
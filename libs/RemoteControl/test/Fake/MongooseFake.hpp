@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace sugo::remote_control::fake
+{
+/// @brief Websocket message sent by the fake.
+struct WebsocketMessage
+{
+    std::string data;    ///< Payload of the message.
+    int         op = 0;  ///< Websocket operation code.
+};
+
+/**
+ * @brief Returns the websocket messages sent since the last reset.
+ *
+ * @return Sent websocket messages.
+ */
+std::vector<WebsocketMessage> &getSentWebsocketMessages();
+
+/**
+ * @brief Returns the raw data sent since the last reset.
+ *
+ * @return Sent raw data.
+ */
+std::string &getSentData();
+
+/// @brief Clears all sent messages and data.
+void reset();
+}  // namespace sugo::remote_control::fake
@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Fake of the mongoose library interface, which is used by the connection handling. It declares
+ * only the types and functions needed, so the unit tests are built without the library.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct mg_str
+{
+    const char *ptr;
+    size_t      len;
+};
+
+struct mg_iobuf
+{
+    unsigned char *buf;
+    size_t         size;
+    size_t         len;
+};
+
+struct mg_connection
+{
+    unsigned long   id;
+    struct mg_iobuf recv;
+    struct mg_iobuf send;
+    void           *fn_data;
+    char            label[50];
+    unsigned        is_closing : 1;
+};
+
+struct mg_http_message
+{
+    struct mg_str method;
+    struct mg_str uri;
+    struct mg_str body;
+};
+
+struct mg_ws_message
+{
+    struct mg_str data;
+    uint8_t       flags;
+};
+
+struct mg_http_serve_opts
+{
+    const char *root_dir;
+    const char *ssi_pattern;
+    const char *extra_headers;
+    const char *mime_types;
+    const char *page404;
+    void       *fs;
+};
+
+enum
+{
+    WEBSOCKET_OP_CONTINUE = 0,
+    WEBSOCKET_OP_TEXT     = 1,
+    WEBSOCKET_OP_BINARY   = 2,
+    WEBSOCKET_OP_CLOSE    = 8,
+    WEBSOCKET_OP_PING     = 9,
+    WEBSOCKET_OP_PONG     = 10
+};
+
+struct mg_str  mg_str_s(const char *s);
+struct mg_str *mg_http_get_header(struct mg_http_message *message, const char *name);
+bool           mg_match(struct mg_str str, struct mg_str pattern, struct mg_str *caps);
+bool           mg_http_match_uri(const struct mg_http_message *message, const char *glob);
+bool           mg_send(struct mg_connection *connection, const void *data, size_t size);
+size_t mg_ws_send(struct mg_connection *connection, const void *buf, size_t len, int op);
+void   mg_ws_upgrade(struct mg_connection *connection, struct mg_http_message *message,
+                     const char *fmt, ...);
+void   mg_http_serve_dir(struct mg_connection *connection, struct mg_http_message *message,
+                         const struct mg_http_serve_opts *opts);
+
+#define mg_str(s) mg_str_s(s)
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "Common/Logger.hpp"
+#include "RemoteControl/MessageEncoding.hpp"
+#include "RemoteControl/Protocol.hpp"
+
+using namespace sugo;
+using namespace sugo::remote_control;
+
+namespace
+{
+const common::Json Message = {{id::Type, id::TypeNotificationState},
+                              {id::State, "running"},
+                              {id::Speed, 1200},
+                              {id::Version, 42},
+                              {"values", {-1, 0.5, true, nullptr}}};
+
+constexpr MessageEncoding Encodings[] = {MessageEncoding::Json, MessageEncoding::Cbor,
+                                         MessageEncoding::MessagePack};
+}  // namespace
+
+class MessageEncodingTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        common::Logger::init();
+    }
+};
+
+TEST_F(MessageEncodingTest, SelectMessageEncoding)
+{
+    MessageEncoding encoding = MessageEncoding::Json;
+    EXPECT_TRUE(selectMessageEncoding("cbor", encoding));
+    EXPECT_EQ(encoding, MessageEncoding::Cbor);
+    EXPECT_TRUE(selectMessageEncoding("json", encoding));
+    EXPECT_EQ(encoding, MessageEncoding::Json);
+
+    // The first supported sub-protocol is selected.
+    EXPECT_TRUE(selectMessageEncoding("mqtt, \tmsgpack ,cbor", encoding));
+    EXPECT_EQ(encoding, MessageEncoding::MessagePack);
+
+    // The encoding is kept, if no sub-protocol is supported.
+    EXPECT_FALSE(selectMessageEncoding("", encoding));
+    EXPECT_FALSE(selectMessageEncoding(" , ,", encoding));
+    EXPECT_FALSE(selectMessageEncoding("mqtt, CBOR, msgpack2", encoding));
+    EXPECT_EQ(encoding, MessageEncoding::MessagePack);
+}
+
+TEST_F(MessageEncodingTest, RoundTrip)
+{
+    for (const auto encoding : Encodings)
+    {
+        const std::string encoded = encodeMessage(Message, encoding);
+        common::Json      decoded;
+        ASSERT_TRUE(decodeMessage(encoded.data(), encoded.size(), encoding, decoded))
+            << getSubprotocol(encoding);
+        EXPECT_EQ(decoded, Message) << getSubprotocol(encoding);
+    }
+
+    // The binary encodings are more compact than the JSON text.
+    EXPECT_LT(encodeMessage(Message, MessageEncoding::Cbor).size(), Message.dump().size());
+    EXPECT_LT(encodeMessage(Message, MessageEncoding::MessagePack).size(), Message.dump().size());
+}
+
+TEST_F(MessageEncodingTest, InvalidInput)
+{
+    for (const auto encoding : Encodings)
+    {
+        const std::string encoded = encodeMessage(Message, encoding);
+        common::Json      decoded;
+        EXPECT_FALSE(decodeMessage(encoded.data(), 0, encoding, decoded))
+            << getSubprotocol(encoding);
+        EXPECT_FALSE(decodeMessage(encoded.data(), encoded.size() - 1, encoding, decoded))
+            << getSubprotocol(encoding);
+        EXPECT_FALSE(decodeMessage((encoded + encoded).data(), 2 * encoded.size(), encoding,
+                                   decoded))
+            << getSubprotocol(encoding);
+    }
+
+    // Malformed JSON and bytes, which are never used by the binary encodings.
+    common::Json decoded;
+    EXPECT_FALSE(decodeMessage("{\"type\":}", 9, MessageEncoding::Json, decoded));
+    EXPECT_FALSE(decodeMessage("\xff", 1, MessageEncoding::Cbor, decoded));
+    EXPECT_FALSE(decodeMessage("\xc1", 1, MessageEncoding::MessagePack, decoded));
+}
@@ -0,0 +1,315 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   19.10.2026
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <mongoose.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "Common/Logger.hpp"
+#include "Common/Types.hpp"
+#include "RemoteControl/IClientRequestHandler.hpp"
+#include "RemoteControl/MessageEncoding.hpp"
+#include "RemoteControl/Protocol.hpp"
+#include "RemoteControl/RemoteControlServer.hpp"
+
+using namespace sugo;
+using namespace sugo::remote_control;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr char                      Address[]       = "localhost";
+constexpr unsigned short            Port            = 4322;
+constexpr unsigned                  BroadcastCount  = 200;
+constexpr std::chrono::milliseconds ConnectTimeout{5000};
+constexpr std::chrono::milliseconds ReceiveTimeout{1000};
+constexpr unsigned                  IdleCount       = 20;
+constexpr std::chrono::milliseconds IdleTime{100};
+
+/// Request handler, which provides the notification callback only.
+class RequestHandler : public IClientRequestHandler
+{
+public:
+    bool receiveRequest(ClientId, const common::Json&, common::Json&) override
+    {
+        return false;
+    }
+
+    void registerSendNotification(SendNotificationCallback callback) override
+    {
+        m_cbSendNotification = callback;
+    }
+
+    void sendNotification(const common::Json& notification)
+    {
+        m_cbSendNotification(notification);
+    }
+
+private:
+    SendNotificationCallback m_cbSendNotification = nullptr;
+};
+
+/// Websocket clients, which count the received state messages.
+struct Clients
+{
+    mg_mgr      manager{};
+    std::string subscription;  // Subscription request sent after connecting, if any.
+    bool        isBinary = false;
+    std::size_t openCount       = 0;
+    std::size_t subscribedCount = 0;
+    std::size_t receivedCount   = 0;
+    std::size_t receivedBytes   = 0;
+};
+
+void handleClientEvent(mg_connection* connection, int event, void* eventData, void* data)
+{
+    auto* clients = static_cast<Clients*>(data);
+    if (event == MG_EV_WS_OPEN)
+    {
+        ++clients->openCount;
+        if (!clients->subscription.empty())
+        {
+            (void)mg_ws_send(connection, clients->subscription.c_str(),
+                             clients->subscription.size(),
+                             clients->isBinary ? WEBSOCKET_OP_BINARY : WEBSOCKET_OP_TEXT);
+        }
+    }
+    else if (event == MG_EV_WS_MSG)
+    {
+        const auto*            message = static_cast<mg_ws_message*>(eventData);
+        const std::string_view data(message->data.ptr, message->data.len);
+        // Binary encodings keep the strings as they are, so the response is found anyway.
+        if (data.find(id::TypeResponseSubscribe) != std::string_view::npos)
+        {
+            ++clients->subscribedCount;
+        }
+        else
+        {
+            ++clients->receivedCount;
+            clients->receivedBytes += data.size();
+        }
+    }
+}
+
+/// Polls the clients until the expected number is reached or the timeout expired.
+bool pollUntil(Clients& clients, const std::size_t& count, std::size_t expected,
+               std::chrono::milliseconds timeout)
+{
+    const auto deadline = Clock::now() + timeout;
+    while ((count < expected) && (Clock::now() < deadline))
+    {
+        mg_mgr_poll(&clients.manager, 1);
+    }
+    return count >= expected;
+}
+
+/// Machine state notification, as it is sent to the user interface.
+common::Json createStateNotification(unsigned counter)
+{
+    return common::Json({{id::Type, id::TypeNotificationState},
+                         {"state", "running"},
+                         {id::Speed, counter % 300},
+                         {"temperatures", {181.2, 183.7, 179.9}},
+                         {"heaters", {{"on", true}, {"duty", 0.42}}},
+                         {"motors", {{"feeder", {{"speed", 120}, {"load", 0.31}}},
+                                     {"coiler", {{"speed", 96}, {"load", 0.27}}}}},
+                         {"counter", counter}});
+}
+
+/// Measures the broadcast of notifications to the passed number of clients.
+bool runBenchmark(std::size_t clientCount, bool isSubscribed, MessageEncoding encoding)
+{
+    RequestHandler      requestHandler;
+    RemoteControlServer server(Address, Port, ".", requestHandler);
+    if (!server.start())
+    {
+        return false;
+    }
+
+    // Subscribed clients select some fields, of which only the speed changes.
+    Clients    clients;
+    const auto url = "ws://" + std::string(Address) + ":" + std::to_string(Port) + "/websocket";
+    clients.isBinary = isBinary(encoding);
+    if (isSubscribed)
+    {
+        clients.subscription =
+            encodeMessage(common::Json({{id::Type, id::TypeRequestSubscribe},
+                                        {id::Fields, {"state", id::Speed, "temperatures"}}}),
+                          encoding);
+    }
+    mg_mgr_init(&clients.manager);
+    for (std::size_t client = 0; client < clientCount; ++client)
+    {
+        (void)mg_ws_connect(  // NOLINT(cppcoreguidelines-pro-type-vararg)
+            &clients.manager, url.c_str(), handleClientEvent, &clients,
+            "Sec-WebSocket-Protocol: %s\r\n", getSubprotocol(encoding).c_str());
+    }
+
+    bool success = pollUntil(clients, clients.openCount, clientCount, ConnectTimeout);
+    if (!success)
+    {
+        LOG(error) << "Only " << clients.openCount << " of " << clientCount << " clients connected";
+    }
+    if (success && isSubscribed)
+    {
+        success = pollUntil(clients, clients.subscribedCount, clientCount, ConnectTimeout);
+    }
+
+    // Each notification is broadcast after all clients received the previous one.
+    std::chrono::microseconds serializationTime{0};
+    std::chrono::microseconds roundTripTime{0};
+    for (unsigned counter = 0; success && (counter < BroadcastCount); ++counter)
+    {
+        const auto notification = createStateNotification(counter);
+
+        // Cost of one serialization per client for comparison.
+        const auto serializationStart = Clock::now();
+        for (std::size_t client = 0; client < clientCount; ++client)
+        {
+            (void)encodeMessage(notification, encoding);
+        }
+        serializationTime += std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - serializationStart);
+
+        const auto broadcastStart = Clock::now();
+        requestHandler.sendNotification(notification);
+        success = pollUntil(clients, clients.receivedCount, (counter + 1) * clientCount,
+                            ReceiveTimeout);
+        roundTripTime += std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                                               broadcastStart);
+    }
+
+    const auto statistics = server.getBroadcastStatistics();
+    mg_mgr_free(&clients.manager);
+    server.stop();
+    if (!success)
+    {
+        LOG(error) << "Broadcast to " << clientCount << " clients failed";
+        return false;
+    }
+
+    const auto messages = statistics.broadcasts * clientCount;
+    std::cout << (isSubscribed ? "subscribed" : "full") << "/" << getSubprotocol(encoding)
+              << ": clients=" << clientCount
+              << ", broadcasts=" << statistics.broadcasts
+              << ", sendLatency=" << (statistics.latency.count() / statistics.broadcasts)
+              << "us, maxSendLatency=" << statistics.maxLatency.count()
+              << "us, roundTrip=" << (roundTripTime.count() / BroadcastCount)
+              << "us, perClientSerialization=" << (serializationTime.count() / BroadcastCount)
+              << "us, bytesPerClient=" << (clients.receivedBytes / messages)
+              << ", processingPerClient=" << (statistics.processingTime.count() * 1000 / messages)
+              << "ns" << std::endl;
+    return true;
+}
+/// Measures the notification and shutdown latency of a server idling in its poll.
+bool runIdleBenchmark()
+{
+    std::chrono::microseconds notificationLatency{0};
+    std::chrono::microseconds maxNotificationLatency{0};
+    std::chrono::microseconds stopLatency{0};
+    std::chrono::microseconds maxStopLatency{0};
+    for (unsigned counter = 0; counter < IdleCount; ++counter)
+    {
+        RequestHandler      requestHandler;
+        RemoteControlServer server(Address, Port, ".", requestHandler);
+        if (!server.start())
+        {
+            return false;
+        }
+
+        Clients    clients;
+        const auto url = "ws://" + std::string(Address) + ":" + std::to_string(Port) + "/websocket";
+        mg_mgr_init(&clients.manager);
+        (void)mg_ws_connect(&clients.manager, url.c_str(), handleClientEvent, &clients, nullptr);
+        bool success = pollUntil(clients, clients.openCount, 1, ConnectTimeout);
+
+        // The notification is sent, while the server is waiting in its poll.
+        if (success)
+        {
+            std::this_thread::sleep_for(IdleTime);
+            const auto start = Clock::now();
+            requestHandler.sendNotification(createStateNotification(counter));
+            success = pollUntil(clients, clients.receivedCount, 1, ReceiveTimeout);
+            const auto latency =
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+            notificationLatency += latency;
+            maxNotificationLatency = std::max(maxNotificationLatency, latency);
+        }
+        mg_mgr_free(&clients.manager);
+
+        std::this_thread::sleep_for(IdleTime);
+        const auto start = Clock::now();
+        server.stop();
+        const auto latency =
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+        stopLatency += latency;
+        maxStopLatency = std::max(maxStopLatency, latency);
+        if (!success)
+        {
+            LOG(error) << "Notification of idle server failed";
+            return false;
+        }
+    }
+
+    std::cout << "idle: cycles=" << IdleCount
+              << ", notificationLatency=" << (notificationLatency.count() / IdleCount)
+              << "us, maxNotificationLatency=" << maxNotificationLatency.count()
+              << "us, stopLatency=" << (stopLatency.count() / IdleCount)
+              << "us, maxStopLatency=" << maxStopLatency.count() << "us" << std::endl;
+    return true;
+}
+}  // namespace
+
+int main()
+{
+    common::Logger::init(common::Logger::Severity::warning);
+
+    if (!runIdleBenchmark())
+    {
+        return 1;
+    }
+
+    for (const bool isSubscribed : {false, true})
+    {
+        for (const auto encoding :
+             {MessageEncoding::Json, MessageEncoding::Cbor, MessageEncoding::MessagePack})
+        {
+            for (const std::size_t clientCount : {1u, 10u, 100u})
+            {
+                if (!runBenchmark(clientCount, isSubscribed, encoding))
+                {
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
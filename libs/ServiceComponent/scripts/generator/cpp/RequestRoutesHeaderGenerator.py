@@ -0,0 +1,84 @@
+'''
+Contains the C++ generator for the request routes header file
+
+@license: Copyright (C) 2020 by Denis Schoener
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>.
+'''
+
+__author__ = "denis@schoener-one.de"
+__copyright__ = "Copyright (C) 2020 by Denis Schoener"
+
+from datetime import datetime
+from pathlib import Path
+
+class RequestRoutesHeaderGenerator:
+    """Class to generate the C++ header file with the requests of all components"""
+
+    def __init__(self, components) -> None:
+        self.components = components
+
+    def generate(self, path):
+        path.parent.mkdir(parents=True, exist_ok=True)
+        newline = '\n'
+        requests = self._requests()
+        with path.open("w", encoding="utf-8") as file:
+            file.write(f'''
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: AUTOMATIC GENERATED FILE!
+ * @data: {datetime.now().strftime('%Y-%m-%d')}
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+
+#include "ServiceComponent/ServiceId.hpp"
+{newline.join(f'#include "ServiceComponent/I{name}.hpp"' for name in self.components.keys())}
+
+namespace sugo::service_component
+{{
+/// Requests of all components, which could be routed by their name '<component>.<request>'.
+constexpr std::array<RequestId, {len(requests)}> RequestRoutes{{
+{newline.join(f'    {request},' for request in requests)}
+}};
+}} // namespace sugo::service_component
+''')
+
+    def _requests(self):
+        requests = []
+        for name, component in self.components.items():
+            requests.append(f'I{name}::RequestGetState')
+            for request in component.inbound.requests:
+                requests.append(f"I{name}::Request{request.name.replace('.', '')}")
+        return requests
@@ -27,6 +27,7 @@ import re
 from .GeneratorContext import GeneratorContext
 from .ServiceComponentHeaderGenerator import ServiceComponentHeaderGenerator
 from .ServiceComponentSourceGenerator import ServiceComponentSourceGenerator
+from .RequestRoutesHeaderGenerator import RequestRoutesHeaderGenerator
 
 class Generator:
     """Class to generate the C++ files"""
@@ -41,6 +42,10 @@ class Generator:
     def _header_file_path(self, component_name):
         inc_path = Path(self._out_dir / 'include' / 'ServiceComponent')
         return Path(inc_path / f"I{component_name}.hpp")
+
+    def _request_routes_file_path(self):
+        inc_path = Path(self._out_dir / 'include' / 'ServiceComponent')
+        return Path(inc_path / "RequestRoutes.hpp")
     
     def print_output_files(self, components):
         for component_name in components.keys():
@@ -48,6 +53,7 @@ class Generator:
             print(str(path))
             path = self._header_file_path(component_name)
             print(str(path))
+        print(str(self._request_routes_file_path()))
     
     def generate(self, components):
         for name, component in components.items():
@@ -57,3 +63,5 @@ class Generator:
             logging.info(f"generating component I{context.name} files")
             ServiceComponentHeaderGenerator(context).generate(self._header_file_path(context.name))
             ServiceComponentSourceGenerator(context).generate(self._source_file_path(context.name))
+        logging.info("generating request routes file")
+        RequestRoutesHeaderGenerator(components).generate(self._request_routes_file_path())
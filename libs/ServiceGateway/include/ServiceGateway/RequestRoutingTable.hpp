@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include "MessageBroker/Message.hpp"
+#include "ServiceComponent/ServiceId.hpp"
+
+namespace sugo::service_gateway
+{
+/// @brief Class to route JSON RPC methods '<component>.<request>' to the component requests.
+class RequestRoutingTable
+{
+public:
+    /// @brief Separator between component and request name of a method.
+    static constexpr char MethodSeparator = '.';
+
+    /// @brief Route of a method to the receiving component.
+    struct Route
+    {
+        message_broker::Message::Identifier id;       ///< Message identifier of the request.
+        message_broker::Address             address;  ///< Address of the receiving component.
+    };
+
+    RequestRoutingTable() = default;
+
+    /**
+     * @brief Constructs a new routing table of a list of requests.
+     *
+     * @tparam RequestIdListT Type of the request list.
+     * @param requestIds      Requests to be routed.
+     */
+    template <class RequestIdListT>
+    explicit RequestRoutingTable(const RequestIdListT& requestIds)
+    {
+        for (const auto& requestId : requestIds)
+        {
+            add(requestId);
+        }
+    }
+
+    /**
+     * @brief Adds the route of a request.
+     *
+     * @param requestId Request to be routed.
+     * @return true  If the route has been added.
+     * @return false If a route with the same method name exists already.
+     */
+    bool add(const service_component::RequestId& requestId);
+
+    /**
+     * @brief Returns the route of a method.
+     *
+     * @param method Method name '<component>.<request>'.
+     * @return Route of the method or nullptr, if the method is unknown.
+     */
+    const Route* find(const std::string& method) const
+    {
+        const auto iter = m_routes.find(method);
+        return (iter != m_routes.end()) ? &iter->second : nullptr;
+    }
+
+    /**
+     * @brief Returns the number of routes.
+     *
+     * @return Number of routes.
+     */
+    std::size_t size() const
+    {
+        return m_routes.size();
+    }
+
+private:
+    std::unordered_map<std::string, Route> m_routes;  ///< Routes by method name.
+};
+}  // namespace sugo::service_gateway
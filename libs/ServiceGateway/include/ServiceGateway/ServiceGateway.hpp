@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <jsonrpcpp/jsonrpcpp.hpp>
 #include <string>
 
@@ -33,6 +34,7 @@
 #include "MessageBroker/Server.hpp"
 #include "ServiceComponent/ServiceComponent.hpp"
 #include "ServiceGateway/IServiceGateway.hpp"
+#include "ServiceGateway/RequestRoutingTable.hpp"
 
 namespace sugo::service_gateway
 {
@@ -42,13 +44,15 @@ class ServiceGateway : public IServiceGateway, public service_component::Service
 public:
     /// @brief Identifier of the service gateway.
     static constexpr IServiceComponent::Identifier Identifier{"ServiceGateway"};
+    /// @brief Maximum number of batch requests processed concurrently.
+    static constexpr std::size_t MaxConcurrentRequests = 8u;
 
     /**
      * @brief Constructs a new service gateway object.
      *
      * @param messageBroker Message broker instance.
      * @param processContext Process context.
-     * @param serviceLocator Service locator instance.
+     * @param serviceLocator Service locator instance, which provides also the request routes.
      * @param ioContext Process context to be use to run the JSON RPC server.
      *
      * @todo Pass only a ready configured IServer interface object.
@@ -64,12 +68,31 @@ public:
 
     bool isRunning() const override;
 
-private:
+protected:
+    /**
+     * @brief Processes a received JSON RPC message, which is either a request or a batch.
+     *
+     * @param receivedMessage Received message.
+     * @param[out] responseMessage Response message to be sent.
+     * @return true If a response has been created.
+     * @return false If the message could not be processed.
+     */
     bool receivedRequestMessage(message_broker::StreamBuffer& receivedMessage,
                                 message_broker::StreamBuffer& responseMessage);
 
+private:
     jsonrpcpp::Response processRequestMessage(const jsonrpcpp::request_ptr& request);
 
-    message_broker::Server m_jsonRpcServer;
+    /**
+     * @brief Processes the requests of a batch concurrently and collects their responses in the
+     * order of the batch.
+     *
+     * @param batch Batch of requests.
+     * @return Array of responses, which is empty if the batch contains notifications only.
+     */
+    common::Json processBatchMessage(const jsonrpcpp::Batch& batch);
+
+    const RequestRoutingTable& m_requestRoutes;  ///< Routes of the methods to the components.
+    message_broker::Server     m_jsonRpcServer;  ///< JSON RPC server.
 };
 }  // namespace sugo::service_gateway
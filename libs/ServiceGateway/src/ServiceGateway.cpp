@@ -23,14 +23,15 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
-#include <cstdlib>
+#include <future>
 #include <iostream>
 #include <istream>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <vector>
 
-#include "Common/StringTokenizer.hpp"
+#include "Common/Logger.hpp"
 #include "Common/Types.hpp"
 #include "ServiceGateway/Configuration.hpp"
 #include "ServiceGateway/ServiceGateway.hpp"
@@ -40,11 +41,15 @@ using namespace service_gateway;
 
 namespace
 {
-constexpr unsigned MethodTokenCount           = 2u;  ///< method string: '<receiver-id>.<method-id>'
-constexpr unsigned MethodTokenReceiverAddress = 0u;
-constexpr unsigned MethodTokenMethodId        = 1u;
-
 const service_component::IServiceComponent::NotificationIdList EmptyNotificationIdList{};
+
+common::Json createErrorResponse(const jsonrpcpp::Request& request, const std::string& message,
+                                 message_broker::ResponseMessage::Result code)
+{
+    return jsonrpcpp::Response(request,
+                               jsonrpcpp::Error(common::Json{{"message", message}, {"code", code}}))
+        .to_json();
+}
 }  // namespace
 
 ServiceGateway::ServiceGateway(
@@ -52,6 +57,7 @@ ServiceGateway::ServiceGateway(
     common::IProcessContext&,  // FIXME not used, but has to be passed by ExecutionBundle
     const common::ServiceLocator& serviceLocator, common::IOContext& ioContext)
     : ServiceComponent(messageBroker, EmptyNotificationIdList),
+      m_requestRoutes(serviceLocator.get<RequestRoutingTable>()),
       m_jsonRpcServer(
           std::string("tcp://") +
               serviceLocator.get<common::IConfiguration>()
@@ -106,11 +112,20 @@ bool ServiceGateway::receivedRequestMessage(message_broker::StreamBuffer& receiv
     try
     {
         jsonrpcpp::entity_ptr entity = jsonrpcpp::Parser::do_parse(requestMessage);
+        common::Json          response;
         if (entity->is_request())
         {
             jsonrpcpp::request_ptr request = std::dynamic_pointer_cast<jsonrpcpp::Request>(entity);
-            const jsonrpcpp::Response response = processRequestMessage(request);
-            const std::string         responseMessage(response.to_json().dump());
+            response                       = processRequestMessage(request).to_json();
+        }
+        else if (entity->is_batch())
+        {
+            response = processBatchMessage(*std::dynamic_pointer_cast<jsonrpcpp::Batch>(entity));
+        }
+
+        if (!response.is_null())
+        {
+            const std::string responseMessage(response.dump());
             LOG(info) << "Sending response: '" << responseMessage << "'";
             std::ostream out(&responseMessageBuffer);
             out << responseMessage;
@@ -121,21 +136,87 @@ bool ServiceGateway::receivedRequestMessage(message_broker::StreamBuffer& receiv
     {
         LOG(error) << ex.what();
     }
+    catch (jsonrpcpp::RequestException& ex)
+    {
+        // Invalid requests and empty batches are answered with an error response.
+        LOG(error) << ex.what();
+        std::ostream out(&responseMessageBuffer);
+        out << ex.to_json().dump();
+        success = true;
+    }
     return success;
 }
 
+common::Json ServiceGateway::processBatchMessage(const jsonrpcpp::Batch& batch)
+{
+    // Each entity has its own response slot, so the order of the batch is kept.
+    std::vector<common::Json> responses(batch.entities.size());
+    for (std::size_t first = 0; first < batch.entities.size(); first += MaxConcurrentRequests)
+    {
+        const std::size_t last = std::min(first + MaxConcurrentRequests, batch.entities.size());
+        std::vector<std::future<void>> calls;
+        for (std::size_t index = first; index < last; ++index)
+        {
+            const jsonrpcpp::entity_ptr& entity = batch.entities[index];
+            if (entity->is_request())
+            {
+                // The requests are sent to the components concurrently.
+                calls.push_back(std::async(
+                    std::launch::async, [this, &entity, &response = responses[index]] {
+                        common::Logger::reinit(Identifier);
+                        jsonrpcpp::request_ptr request =
+                            std::dynamic_pointer_cast<jsonrpcpp::Request>(entity);
+                        try
+                        {
+                            response = processRequestMessage(request).to_json();
+                        }
+                        catch (std::exception& ex)
+                        {
+                            LOG(error) << "Failed to process request: " << ex.what();
+                            response = createErrorResponse(
+                                *request, ex.what(),
+                                message_broker::ResponseMessage::Result::InvalidPayload);
+                        }
+                    }));
+            }
+            else if (entity->is_notification())
+            {
+                LOG(warning) << "Batch notification ignored: '" << entity->to_json().dump() << "'";
+            }
+            else
+            {
+                // Invalid entries are parsed as exceptions, which provide their error response.
+                responses[index] = entity->to_json();
+            }
+        }
+        for (auto& call : calls)
+        {
+            call.wait();
+        }
+    }
+
+    // Notifications get no response, but the server has to reply in any case. So a batch of
+    // notifications only is answered with an empty array.
+    common::Json batchResponse = common::Json::array();
+    for (auto& response : responses)
+    {
+        if (!response.is_null())
+        {
+            batchResponse.push_back(std::move(response));
+        }
+    }
+    return batchResponse;
+}
+
 jsonrpcpp::Response ServiceGateway::processRequestMessage(const jsonrpcpp::request_ptr& request)
 {
-    common::StringTokenizer::Tokens tokens = common::StringTokenizer::split<'.'>(request->method());
-    jsonrpcpp::Response             response;
+    const RequestRoutingTable::Route* route = m_requestRoutes.find(request->method());
+    jsonrpcpp::Response               response;
 
-    if (tokens.size() == MethodTokenCount && (tokens[MethodTokenReceiverAddress].size() > 0) &&
-        (tokens[MethodTokenMethodId].size() > 0))
+    if (route != nullptr)
     {
-        message_broker::Message                   message;
-        const message_broker::Message::Identifier id =
-            std::atoi(tokens[MethodTokenMethodId].c_str());
-        message.setId(id);
+        message_broker::Message message;
+        message.setId(route->id);
         message.setSequence(request->id().int_id());
         const jsonrpcpp::Parameter& parameters = request->params();
 
@@ -146,7 +227,7 @@ jsonrpcpp::Response ServiceGateway::processRequestMessage(const jsonrpcpp::reque
 
         message_broker::ResponseMessage responseMessage;
         const bool                      success =
-            getMessageBroker().send(message, tokens[MethodTokenReceiverAddress], responseMessage);
+            getMessageBroker().send(message, route->address, responseMessage);
 
         if (success &&
             (responseMessage.getResult() == message_broker::ResponseMessage::Result::Success))
@@ -172,7 +253,7 @@ jsonrpcpp::Response ServiceGateway::processRequestMessage(const jsonrpcpp::reque
     {
         response = jsonrpcpp::Response(
             *request, jsonrpcpp::Error(common::Json{
-                          {"message", "invalid format"},
+                          {"message", "unknown method"},
                           {"code", message_broker::ResponseMessage::Result::InvalidMessage}}));
     }
     return response;
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @file
+ *
+ * @author: Denis Schoener (denis@schoener-one.de)
+ * @date:   22.09.2023
+ *
+ * @license: Copyright (C) 2020 by Denis Schoener
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Common/Logger.hpp"
+#include "Common/StringTokenizer.hpp"
+#include "MessageBroker/Message.hpp"
+#include "ServiceComponent/ServiceId.hpp"
+#include "ServiceGateway/RequestRoutingTable.hpp"
+
+using namespace sugo;
+using namespace sugo::service_gateway;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned CallCount = 1000000;
+
+/// Components and requests similar to the ones of the machine service components.
+constexpr const char* Components[] = {
+    "MachineControl",      "FilamentMergerControl", "FilamentFeederMotor",
+    "FilamentPreHeater",   "FilamentMergerHeater",  "FilamentCoilControl",
+    "FilamentCoilMotor",   "FilamentTensionSensor", "UserInterfaceControl"};
+constexpr const char* Requests[] = {"GetState",     "SwitchOn",      "SwitchOff",
+                                    "StartMotor",   "StopMotor",     "SetMotorSpeed",
+                                    "GetMotorSpeed"};
+
+/**
+ * @brief Measures the average time of one method resolution.
+ *
+ * @param name    Benchmark name.
+ * @param methods Method names to be resolved in turn.
+ * @param resolve Resolves a method and returns its message identifier.
+ */
+template <class ResolveT>
+void runBenchmark(const char* name, const std::vector<std::string>& methods, ResolveT resolve)
+{
+    message_broker::Message::Identifier checksum = 0;
+    const auto                          start    = Clock::now();
+
+    for (unsigned call = 0; call < CallCount; ++call)
+    {
+        checksum ^= resolve(methods[call % methods.size()]);
+    }
+
+    const auto duration =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    std::cout << name << ": methods=" << methods.size() << ", calls=" << CallCount
+              << ", perCall=" << (duration.count() / CallCount) << "ns, checksum=" << checksum
+              << std::endl;
+}
+}  // namespace
+
+int main()
+{
+    common::Logger::init(common::Logger::Severity::warning);
+
+    std::vector<service_component::RequestId> requestIds;
+    std::vector<std::string>                  methodNames;
+    std::vector<std::string>                  methodIds;
+
+    for (const char* component : Components)
+    {
+        for (const char* request : Requests)
+        {
+            requestIds.emplace_back(component, request);
+            methodNames.push_back(std::string(component) + RequestRoutingTable::MethodSeparator +
+                                  request);
+            methodIds.push_back(std::string(component) + RequestRoutingTable::MethodSeparator +
+                                std::to_string(requestIds.back().getMessageId()));
+        }
+    }
+
+    const RequestRoutingTable routes(requestIds);
+
+    // Previous resolution: method '<component>.<message-id>' split into tokens on every call.
+    runBenchmark("tokenized", methodIds, [](const std::string& method) {
+        const common::StringTokenizer::Tokens tokens =
+            common::StringTokenizer::split<RequestRoutingTable::MethodSeparator>(method);
+        return static_cast<message_broker::Message::Identifier>(std::atoi(tokens[1].c_str()));
+    });
+
+    runBenchmark("routed", methodNames, [&routes](const std::string& method) {
+        const RequestRoutingTable::Route* route = routes.find(method);
+        return (route != nullptr) ? route->id : 0u;
+    });
+    return 0;
+}
@@ -25,15 +25,24 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
-#include "Common/IConfigurationMock.hpp"
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "Common/Configuration.hpp"
 #include "Common/IOContext.hpp"
 #include "Common/IProcessContextMock.hpp"
 #include "Common/Logger.hpp"
 #include "Common/ServiceLocator.hpp"
 #include "MessageBroker/IMessageBrokerMock.hpp"
+#include "ServiceGateway/Configuration.hpp"
+#include "ServiceGateway/RequestRoutingTable.hpp"
 #include "ServiceGateway/ServiceGateway.hpp"
 
 using ::testing::_;
+using ::testing::Invoke;
 using ::testing::Return;
 
 using namespace sugo::common;
@@ -41,12 +50,22 @@ using namespace sugo::message_broker;
 using namespace sugo::service_component;
 using namespace sugo::service_gateway;
 
+namespace
+{
+class ServiceGatewayTestable : public ServiceGateway
+{
+public:
+    using ServiceGateway::receivedRequestMessage;
+    using ServiceGateway::ServiceGateway;
+};
+}  // namespace
+
 class ServiceGatewayTest : public ::testing::Test
 {
 protected:
-    ServiceGatewayTest()
-        : m_ioContext("ServiceGatewayTest"),
-          m_serviceGateway(m_mockMessageBroker, m_mockProcessContext, m_serviceLocator, m_ioContext)
+    static constexpr RequestId RequestSwitchOn{"Component", "SwitchOn"};
+
+    ServiceGatewayTest() : m_ioContext("ServiceGatewayTest")
     {
     }
 
@@ -57,19 +76,47 @@ protected:
 
     void SetUp() override
     {
-        m_serviceLocator.add<IConfiguration>(m_mockConfiguration);
+        config::addConfigurationOptions(m_configuration);
+        ASSERT_TRUE(m_requestRoutes.add(RequestSwitchOn));
+        m_serviceLocator.add<IConfiguration>(m_configuration);
+        m_serviceLocator.add<RequestRoutingTable>(m_requestRoutes);
+        m_serviceGateway = std::make_unique<ServiceGatewayTestable>(
+            m_mockMessageBroker, m_mockProcessContext, m_serviceLocator, m_ioContext);
     }
 
     void TearDown() override
     {
+        m_serviceGateway.reset();
     }
 
-    ServiceLocator      m_serviceLocator;
-    IConfigurationMock  m_mockConfiguration;
-    IOContext           m_ioContext;
-    IMessageBrokerMock  m_mockMessageBroker;
-    IProcessContextMock m_mockProcessContext;
-    ServiceGateway      m_serviceGateway;
+    /// Passes the request to the service gateway and returns its response.
+    Json sendRequest(const std::string& request)
+    {
+        StreamBuffer receivedMessage, responseMessage;
+        std::ostream out(&receivedMessage);
+        out << request;
+        EXPECT_TRUE(m_serviceGateway->receivedRequestMessage(receivedMessage, responseMessage));
+        std::istream in(&responseMessage);
+        return Json::parse(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>(),
+                           nullptr, false);
+    }
+
+    /// Responds to a request by returning its payload.
+    static bool respondWithPayload(Message& message, const Address&, ResponseMessage& response)
+    {
+        response.referTo(message);
+        response.setResult(ResponseMessage::Result::Success);
+        response.setPayload(message.getPayload());
+        return true;
+    }
+
+    Configuration                           m_configuration;
+    ServiceLocator                          m_serviceLocator;
+    RequestRoutingTable                     m_requestRoutes;
+    IOContext                               m_ioContext;
+    IMessageBrokerMock                      m_mockMessageBroker;
+    IProcessContextMock                     m_mockProcessContext;
+    std::unique_ptr<ServiceGatewayTestable> m_serviceGateway;
 };
 
 TEST_F(ServiceGatewayTest, Start)
@@ -77,4 +124,116 @@ TEST_F(ServiceGatewayTest, Start)
     // TODO no implemented yet!
     // EXPECT_CALL(m_mockProcessContext, start()).WillOnce(Return(true));
     // EXPECT_TRUE(m_serviceGateway.start());
-}
\ No newline at end of file
+}
+
+TEST_F(ServiceGatewayTest, BatchRequest)
+{
+    EXPECT_CALL(m_mockMessageBroker, send(_, "Component", _))
+        .Times(ServiceGateway::MaxConcurrentRequests + 1)
+        .WillRepeatedly(Invoke(respondWithPayload));
+
+    // More requests than processed concurrently, so the order has to be kept across the chunks.
+    Json batch = Json::array();
+    for (unsigned index = 0; index <= ServiceGateway::MaxConcurrentRequests; ++index)
+    {
+        batch.push_back({{"jsonrpc", "2.0"},
+                         {"method", "Component.SwitchOn"},
+                         {"params", {{"index", index}}},
+                         {"id", index}});
+    }
+    batch.push_back({{"jsonrpc", "2.0"}, {"method", "Component.SwitchOn"}});
+    batch.push_back(42);
+
+    const Json response = sendRequest(batch.dump());
+    ASSERT_TRUE(response.is_array());
+    ASSERT_EQ(response.size(), ServiceGateway::MaxConcurrentRequests + 2);
+    for (unsigned index = 0; index <= ServiceGateway::MaxConcurrentRequests; ++index)
+    {
+        EXPECT_EQ(response[index]["id"], index);
+        EXPECT_EQ(response[index]["result"]["data"]["index"], index);
+    }
+    const Json& invalidResponse = response.back();
+    EXPECT_EQ(invalidResponse["error"]["code"], -32600);
+    EXPECT_TRUE(invalidResponse["id"].is_null());
+}
+
+TEST_F(ServiceGatewayTest, BatchRequestFailed)
+{
+    EXPECT_CALL(m_mockMessageBroker, send(_, "Component", _))
+        .WillOnce(Invoke(respondWithPayload))
+        .WillOnce(Return(false))
+        .WillOnce(Invoke([](Message& message, const Address&, ResponseMessage& response) {
+            response.referTo(message);
+            response.setResult(ResponseMessage::Result::Success);
+            response.setPayload(std::string("no json"));
+            return true;
+        }));
+
+    const Json response = sendRequest(
+        R"([{"jsonrpc": "2.0", "method": "Component.SwitchOn", "id": 1},)"
+        R"( {"jsonrpc": "2.0", "method": "Component.SwitchOff", "id": 2}])");
+    ASSERT_TRUE(response.is_array());
+    ASSERT_EQ(response.size(), 2u);
+    EXPECT_EQ(response[0]["id"], 1);
+    EXPECT_TRUE(response[0].contains("result"));
+    EXPECT_EQ(response[1]["id"], 2);
+    EXPECT_EQ(response[1]["error"]["code"], ResponseMessage::Result::InvalidMessage);
+
+    const Json failedResponse =
+        sendRequest(R"([{"jsonrpc": "2.0", "method": "Component.SwitchOn", "id": 3}])");
+    ASSERT_TRUE(failedResponse.is_array());
+    ASSERT_EQ(failedResponse.size(), 1u);
+    EXPECT_EQ(failedResponse[0]["id"], 3);
+    EXPECT_TRUE(failedResponse[0].contains("error"));
+
+    // The invalid response is reported by the processing thread of the request.
+    const Json invalidResponse =
+        sendRequest(R"([{"jsonrpc": "2.0", "method": "Component.SwitchOn", "id": 4}])");
+    ASSERT_TRUE(invalidResponse.is_array());
+    ASSERT_EQ(invalidResponse.size(), 1u);
+    EXPECT_EQ(invalidResponse[0]["id"], 4);
+    EXPECT_EQ(invalidResponse[0]["error"]["code"], ResponseMessage::Result::InvalidPayload);
+}
+
+TEST_F(ServiceGatewayTest, BatchNotificationsOnly)
+{
+    EXPECT_CALL(m_mockMessageBroker, send(_, _, _)).Times(0);
+
+    // The server has to reply in any case, even if there is no response to a notification.
+    const Json response = sendRequest(R"([{"jsonrpc": "2.0", "method": "Component.SwitchOn"},)"
+                                      R"( {"jsonrpc": "2.0", "method": "Component.SwitchOn"}])");
+    EXPECT_EQ(response, Json::array());
+}
+
+TEST_F(ServiceGatewayTest, EmptyBatch)
+{
+    EXPECT_CALL(m_mockMessageBroker, send(_, _, _)).Times(0);
+
+    const Json response = sendRequest("[]");
+    EXPECT_EQ(response["error"]["code"], -32600);
+}
+
+class RequestRoutingTableTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        Logger::init();
+    }
+};
+
+TEST_F(RequestRoutingTableTest, FindRoute)
+{
+    constexpr RequestId RequestSwitchOn{"Component", "SwitchOn"};
+    RequestRoutingTable routes;
+    EXPECT_TRUE(routes.add(RequestSwitchOn));
+    EXPECT_FALSE(routes.add(RequestSwitchOn));
+    EXPECT_EQ(routes.size(), 1u);
+
+    const RequestRoutingTable::Route* route = routes.find("Component.SwitchOn");
+    ASSERT_NE(route, nullptr);
+    EXPECT_EQ(route->id, RequestSwitchOn.getMessageId());
+    EXPECT_EQ(route->address, "Component");
+    EXPECT_EQ(routes.find("Component.SwitchOff"), nullptr);
+    EXPECT_EQ(routes.find("Component"), nullptr);
+}
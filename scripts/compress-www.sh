@@ -0,0 +1,46 @@
+#!/bin/bash
+###################################################################################################
+# 
+# @file
+#  
+# @author: Denis Schoener (denis@schoener-one.de)
+# @date: 22.09.2023
+#  
+# @license: Copyright (C) 2020 by Denis Schoener
+# 
+# This program is free software: you can redistribute it andor modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+# or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+# for more details.
+# 
+# You should have received a copy of the GNU General Public License along
+# with this program. If not, see <https:www.gnu.orglicenses>.
+#
+###################################################################################################
+# Creates the pre-compressed .gz and .br variants of the web server document root, which are
+# served by the remote control to clients accepting them.
+DOC_ROOT=${1:-conf/www}
+
+if [ ! -d "${DOC_ROOT}" ]; then
+    echo "Document root ${DOC_ROOT} not found!"
+    exit 1
+fi
+
+HAS_BROTLI=0
+if command -v brotli > /dev/null; then
+    HAS_BROTLI=1
+else
+    echo "brotli not found, creating gzip variants only"
+fi
+
+find "${DOC_ROOT}" -type f ! -name '*.gz' ! -name '*.br' | while read -r FILE; do
+    gzip -9 -n -k -f "${FILE}" || exit 1
+    if [ ${HAS_BROTLI} -eq 1 ]; then
+        brotli -q 11 -k -f "${FILE}" || exit 1
+    fi
+done
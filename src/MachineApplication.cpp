@@ -39,7 +39,9 @@
 #include "RemoteControl/Configuration.hpp"
 #include "RemoteControl/RemoteControlServer.hpp"
 #include "ServiceComponent/ExecutionBundle.hpp"
+#include "ServiceComponent/RequestRoutes.hpp"
 #include "ServiceGateway/Configuration.hpp"
+#include "ServiceGateway/RequestRoutingTable.hpp"
 #include "ServiceGateway/ServiceGateway.hpp"
 
 using namespace sugo;
@@ -136,6 +138,8 @@ bool MachineApplication::start(int argc, char const** argv)
     }
 
     // Start service gateway
+    service_gateway::RequestRoutingTable requestRoutes(service_component::RequestRoutes);
+    serviceLocator.add<service_gateway::RequestRoutingTable>(requestRoutes);
     using ServiceGatewayBundle =
         service_component::ExecutionBundle<service_gateway::ServiceGateway,
                                            const common::ServiceLocator&, common::IOContext&>;
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <condition_variable>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -83,7 +84,7 @@ protected:
         LOG(info) << "!! Expect state: " << state;
         std::unique_lock<std::mutex> lock(m_mutex);
         auto                         response = send(ComponentT::RequestGetState);
-        const common::Json& jsonState = common::Json::parse(response.getPayload()).at("state");
+        const common::Json jsonState = common::Json::parse(response.getPayload()).at("state");
         EXPECT_FALSE(jsonState.empty());
         EXPECT_EQ(static_cast<unsigned>(state), jsonState.get<unsigned>());
     }
@@ -91,11 +92,16 @@ protected:
     template <typename ComponentT>
     void subscribeToNotification(const service_component::NotificationId& notificationId)
     {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_notificationCounts[notificationId.getMessageId()] = 0;
+        }
         m_broker.registerNotificationMessageHandler(
             notificationId.getMessageId(), [&](const message_broker::Message& message) {
                 {
                     std::lock_guard<std::mutex> lock(m_mutex);
                     m_receivedNotifications.push_back(message.getId());
+                    ++m_notificationCounts[message.getId()];
                 }
                 m_condVar.notify_one();
             });
@@ -124,6 +130,20 @@ protected:
         LOG(info) << ">> Expected notification received: " << notificationId;
     }
 
+    /**
+     * @brief Returns the number of notifications, which have been received by the broker since
+     * the subscription.
+     *
+     * @param notificationId Notification to count.
+     * @return Number of received notifications.
+     */
+    unsigned getNotificationCount(const service_component::NotificationId& notificationId)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto count = m_notificationCounts.find(notificationId.getMessageId());
+        return (count != m_notificationCounts.end()) ? count->second : 0;
+    }
+
 private:
     bool hasNotificationReceived(const message_broker::Message::Identifier& id)
     {
@@ -142,10 +162,11 @@ private:
     common::IOContext             m_ioContext;
     message_broker::MessageBroker m_broker;
 
-    unsigned                                         m_idCount = 0;
-    std::vector<message_broker::Message::Identifier> m_receivedNotifications;
-    std::mutex                                       m_mutex;
-    std::condition_variable                          m_condVar;
+    unsigned                                                m_idCount = 0;
+    std::vector<message_broker::Message::Identifier>        m_receivedNotifications;
+    std::map<message_broker::Message::Identifier, unsigned> m_notificationCounts;
+    std::mutex                                              m_mutex;
+    std::condition_variable                                 m_condVar;
 };
 
 }  // namespace sugo
\ No newline at end of file
@@ -25,6 +25,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Common/IConfigurationMock.hpp"
 #include "Common/IOContext.hpp"
@@ -107,8 +112,10 @@ protected:
 
     void TearDown() override
     {
+        joinMotionCompletions();
         IntegrationTest::TearDown();
         m_execGroup->stop();
+        joinMotionCompletions();
         m_execGroup.reset();  // Call destructor!
     }
 
@@ -125,6 +132,92 @@ protected:
     void switchOnMachine();
     void switchOffMachine();
 
+    /// Returns an action, which completes an asynchronous motion from a different context like
+    /// the motor does.
+    auto completeMotionAsync(IStepperMotor::MotionResult result)
+    {
+        return [this, result](bool, IStepperMotor::MotionCompletionHandler handler) {
+            std::lock_guard<std::mutex> lock(m_motionMutex);
+            m_motionCompletions.emplace_back(
+                [result, handler = std::move(handler)] { handler(result); });
+            return true;
+        };
+    }
+
+    /// Records the speed trims of the coil motor, which have to change the speed in the given
+    /// direction only.
+    void expectSpeedTrims(bool isIncreasing)
+    {
+        EXPECT_CALL(*m_mockStepperMotorCoiler, setSpeed(_))
+            .WillRepeatedly([this, isIncreasing](hal::IStepperMotor::Speed speed) {
+                std::lock_guard<std::mutex> lock(m_speedMutex);
+                if (isIncreasing)
+                {
+                    EXPECT_GE(speed.getValue(), m_nextMotorSpeed);
+                }
+                else
+                {
+                    EXPECT_LE(speed.getValue(), m_nextMotorSpeed);
+                }
+                m_nextMotorSpeed = speed.getValue();
+                m_speedTrims.push_back(static_cast<int>(speed.getValue()));
+                m_speedTrimmed.notify_all();
+                return true;
+            });
+    }
+
+    /// Waits for several speed trims and checks, that the speed is trimmed smoothly by the
+    /// integral part after the first step of the proportional part.
+    void expectSmoothSpeedTrims()
+    {
+        constexpr size_t                    SpeedTrimCount = 10;
+        constexpr std::chrono::milliseconds MaxSpeedTrimTime{5000};
+        std::unique_lock<std::mutex>        lock(m_speedMutex);
+        ASSERT_TRUE(m_speedTrimmed.wait_for(lock, MaxSpeedTrimTime, [this] {
+            return m_speedTrims.size() > SpeedTrimCount;
+        }));
+
+        std::vector<double> steps;
+        for (size_t index = 2; index < m_speedTrims.size(); ++index)
+        {
+            steps.push_back(std::abs(m_speedTrims[index] - m_speedTrims[index - 1]));
+        }
+        double mean = 0.0;
+        for (const double step : steps)
+        {
+            mean += step / static_cast<double>(steps.size());
+        }
+        double variance = 0.0;
+        for (const double step : steps)
+        {
+            variance += (step - mean) * (step - mean) / static_cast<double>(steps.size());
+        }
+        constexpr double maxDeviation = IStepperMotor::MilliRpmPerRpm / 2.0;
+        EXPECT_LT(mean, static_cast<double>(IStepperMotor::MilliRpmPerRpm));
+        EXPECT_LT(variance, maxDeviation * maxDeviation);
+    }
+
+    /// Joins all pending motion completions, including those which are started by a completion.
+    void joinMotionCompletions()
+    {
+        while (true)
+        {
+            std::vector<std::thread> completions;
+            {
+                std::lock_guard<std::mutex> lock(m_motionMutex);
+                if (m_motionCompletions.empty())
+                {
+                    return;
+                }
+                completions.swap(m_motionCompletions);
+            }
+            for (auto& completion : completions)
+            {
+                completion.join();
+            }
+        }
+    }
+
     IHardwareAbstractionLayer::StepperMotorControllerMap      m_stepperMotorControllerMap;
     IHardwareAbstractionLayer::TemperatureSensorControllerMap m_temperatureSensorControllerMap;
     IHardwareAbstractionLayer::GpioControllerMap              m_gpioControllerMap;
@@ -158,7 +251,12 @@ protected:
     common::ServiceLocator                                     m_serviceLocator;
     std::unique_ptr<machine_service_component::ExecutionGroup> m_execGroup;
 
-    unsigned m_nextMotorSpeed = 0;
+    unsigned                 m_nextMotorSpeed = 0;
+    std::mutex               m_speedMutex;
+    std::condition_variable  m_speedTrimmed;
+    std::vector<int>         m_speedTrims;
+    std::mutex               m_motionMutex;
+    std::vector<std::thread> m_motionCompletions;
 };  // namespace IntegrationTest
 
 void MachineApplicationIntegrationTest::prepareHardwareAbstractionLayer()
@@ -237,13 +335,17 @@ void MachineApplicationIntegrationTest::prepareForStartComponents()
 {
     prepareHardwareAbstractionLayer();
     ON_CALL(*m_mockStepperMotorCoiler, reset()).WillByDefault(Return(true));
+    ON_CALL(*m_mockStepperMotorCoiler, setSpeed(_)).WillByDefault(Return(true));
+    ON_CALL(*m_mockStepperMotorCoiler, setSpeedSynchronized(_)).WillByDefault(Return(true));
     ON_CALL(*m_mockStepperMotorCoiler, getMaxSpeed())
         .WillByDefault(
-            Return(IStepperMotor::Speed{test::MachineConfiguration::MotorSpeedDefault, Unit::Rpm}));
+            Return(IStepperMotor::Speed{test::MachineConfiguration::MotorSpeedMax, Unit::Rpm}));
     ON_CALL(*m_mockStepperMotorFeeder, reset()).WillByDefault(Return(true));
+    ON_CALL(*m_mockStepperMotorFeeder, setSpeed(_)).WillByDefault(Return(true));
+    ON_CALL(*m_mockStepperMotorFeeder, setSpeedSynchronized(_)).WillByDefault(Return(true));
     ON_CALL(*m_mockStepperMotorFeeder, getMaxSpeed())
         .WillByDefault(
-            Return(IStepperMotor::Speed{test::MachineConfiguration::MotorSpeedDefault, Unit::Rpm}));
+            Return(IStepperMotor::Speed{test::MachineConfiguration::MotorSpeedMax, Unit::Rpm}));
     ON_CALL(*m_mockTemperatureSensorFeeder, getTemperature())
         .WillByDefault(Return(ITemperatureSensor::Temperature{
             test::MachineConfiguration::DefaultTemperature, Unit::Celcius}));
@@ -333,8 +435,10 @@ void MachineApplicationIntegrationTest::switchOffMachine()
         .WillOnce(Return(true));
     EXPECT_CALL(*m_mockGpioPinRelaySwitchHeaterMerger, setState(hal::IGpioPin::State::Low))
         .WillOnce(Return(true));
-    EXPECT_CALL(*m_mockStepperMotorFeeder, stop(false)).WillOnce(Return(true));
-    EXPECT_CALL(*m_mockStepperMotorCoiler, stop(false)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockStepperMotorFeeder, stopAsync(false, _))
+        .WillOnce(completeMotionAsync(IStepperMotor::MotionSucceeded));
+    EXPECT_CALL(*m_mockStepperMotorCoiler, stopAsync(false, _))
+        .WillOnce(completeMotionAsync(IStepperMotor::MotionSucceeded));
     EXPECT_NOTIFICATION_SUBSCRIBE(IMachineControl, NotificationSwitchedOff);
     send(IMachineControl::RequestSwitchOff);
     EXPECT_NOTIFICATION(IMachineControl, NotificationSwitchedOff);
@@ -374,7 +478,8 @@ TEST_F(MachineApplicationIntegrationTest, MotorErrorOccurred)
     EXPECT_NOTIFICATION_SUBSCRIBE(IMachineControl, NotificationErrorOccurred);
     EXPECT_CALL(*m_mockStepperMotorFeeder, rotate()).WillOnce(Return(true));
     EXPECT_CALL(*m_mockStepperMotorCoiler, rotate()).WillOnce(Return(false));  // Error occurred!
-    EXPECT_CALL(*m_mockStepperMotorFeeder, stop(false)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockStepperMotorFeeder, stopAsync(false, _))
+        .WillOnce(completeMotionAsync(IStepperMotor::MotionSucceeded));
     EXPECT_CALL(*m_mockStepperMotorCoiler, stop(true)).WillOnce(Return(true));
     send(IMachineControl::RequestStartHeatless);
     EXPECT_NOTIFICATION(IMachineControl, NotificationErrorOccurred);
@@ -390,10 +495,11 @@ TEST_F(MachineApplicationIntegrationTest, TensionSensorTooLow)
 {
     switchOnMachine();
 
-    m_nextMotorSpeed = test::MachineConfiguration::MotorSpeedDefault +
-                       test::MachineConfiguration::MotorSpeedIncrement;
+    m_nextMotorSpeed =
+        test::MachineConfiguration::MotorSpeedDefault * IStepperMotor::MilliRpmPerRpm;
     bool signalRisingEdge = true;
     EXPECT_NOTIFICATION_SUBSCRIBE(IFilamentTensionSensor, NotificationTensionTooLow);
+    expectSpeedTrims(true);
     EXPECT_CALL(*m_mockGpioPinSignalFilamentTensionLow, waitForEvent(_))
         .WillRepeatedly(Invoke([&](std::chrono::nanoseconds timeout) {
             if (signalRisingEdge)
@@ -410,27 +516,26 @@ TEST_F(MachineApplicationIntegrationTest, TensionSensorTooLow)
         }));
     EXPECT_CALL(*m_mockGpioPinSignalFilamentTensionLow, getState())
         .WillRepeatedly(Return(hal::IGpioPin::State::High));
-    EXPECT_CALL(*m_mockStepperMotorCoiler, setMaxSpeed(_))
-        .WillRepeatedly([&](hal::IStepperMotor::Speed speed) {
-            EXPECT_EQ(speed, m_nextMotorSpeed);
-            m_nextMotorSpeed =
-                std::clamp(m_nextMotorSpeed + test::MachineConfiguration::MotorSpeedIncrement, 0u,
-                           test::MachineConfiguration::MotorSpeedMax);
-        });
+    // The coil motor trims its speed continuously, while the tension is reported only once.
+    expectSmoothSpeedTrims();
     EXPECT_NOTIFICATION(IFilamentTensionSensor, NotificationTensionTooLow);
+    EXPECT_EQ(getNotificationCount(IFilamentTensionSensor::NotificationTensionTooLow), 1u);
     EXPECT_CALL(*m_mockGpioPinSignalFilamentTensionLow, getState())
         .WillRepeatedly(Return(hal::IGpioPin::State::Low));
-    std::this_thread::sleep_for(std::chrono::seconds(2));
+    std::lock_guard<std::mutex> lock(m_speedMutex);
+    EXPECT_GT(m_nextMotorSpeed,
+              test::MachineConfiguration::MotorSpeedDefault * IStepperMotor::MilliRpmPerRpm);
 }
 
 TEST_F(MachineApplicationIntegrationTest, TensionSensorTooHigh)
 {
     switchOnMachine();
 
-    m_nextMotorSpeed = test::MachineConfiguration::MotorSpeedDefault -
-                       test::MachineConfiguration::MotorSpeedIncrement;
+    m_nextMotorSpeed =
+        test::MachineConfiguration::MotorSpeedDefault * IStepperMotor::MilliRpmPerRpm;
     bool signalRisingEdge = true;
     EXPECT_NOTIFICATION_SUBSCRIBE(IFilamentTensionSensor, NotificationTensionTooHigh);
+    expectSpeedTrims(false);
     EXPECT_CALL(*m_mockGpioPinSignalFilamentTensionHigh, waitForEvent(_))
         .WillRepeatedly(Invoke([&](std::chrono::nanoseconds timeout) {
             if (signalRisingEdge)
@@ -447,17 +552,15 @@ TEST_F(MachineApplicationIntegrationTest, TensionSensorTooHigh)
         }));
     EXPECT_CALL(*m_mockGpioPinSignalFilamentTensionHigh, getState())
         .WillRepeatedly(Return(hal::IGpioPin::State::High));
-    EXPECT_CALL(*m_mockStepperMotorCoiler, setMaxSpeed(_))
-        .WillRepeatedly([&](hal::IStepperMotor::Speed speed) {
-            EXPECT_EQ(speed, m_nextMotorSpeed);
-            m_nextMotorSpeed =
-                std::clamp(m_nextMotorSpeed - test::MachineConfiguration::MotorSpeedIncrement, 0u,
-                           test::MachineConfiguration::MotorSpeedMax);
-        });
+    // The coil motor trims its speed continuously, while the tension is reported only once.
+    expectSmoothSpeedTrims();
     EXPECT_NOTIFICATION(IFilamentTensionSensor, NotificationTensionTooHigh);
+    EXPECT_EQ(getNotificationCount(IFilamentTensionSensor::NotificationTensionTooHigh), 1u);
     EXPECT_CALL(*m_mockGpioPinSignalFilamentTensionHigh, getState())
         .WillRepeatedly(Return(hal::IGpioPin::State::Low));
-    std::this_thread::sleep_for(std::chrono::seconds(2));
+    std::lock_guard<std::mutex> lock(m_speedMutex);
+    EXPECT_LT(m_nextMotorSpeed,
+              test::MachineConfiguration::MotorSpeedDefault * IStepperMotor::MilliRpmPerRpm);
 }
 
 TEST_F(MachineApplicationIntegrationTest, TensionSensorOverloaded)
@@ -474,7 +577,8 @@ TEST_F(MachineApplicationIntegrationTest, TensionSensorOverloaded)
             std::this_thread::sleep_for(timeout);
             return IGpioPin::Event{std::chrono::nanoseconds(0), IGpioPin::EventType::Timeout};
         }));
-    EXPECT_CALL(*m_mockStepperMotorCoiler, stop(false)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockStepperMotorCoiler, stopAsync(false, _))
+        .WillOnce(completeMotionAsync(IStepperMotor::MotionSucceeded));
     EXPECT_CALL(*m_mockGpioPinSignalFilamentTensionOverload, getState())
         .WillRepeatedly(Return(hal::IGpioPin::State::High));
     EXPECT_CALL(*m_mockStepperMotorCoiler, setMaxSpeed(_))